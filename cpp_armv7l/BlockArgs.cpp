@@ -0,0 +1,143 @@
+// Class Include
+#include "BlockArgs.h"
+
+// Standard Include(s)
+#include <exception>
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+// The reader and writer get and set the args on the block, and the writer
+// throws if the block rejects any of them
+BlockArgs::BlockArgs(const Reader &reader, const Writer &writer) :
+    reader(reader),
+    writer(writer)
+{
+}
+
+/*
+ * Public Method(s)
+ */
+
+// Apply the args which differ from those last applied, optionally reading
+// them back to check that the block kept them. Returns false, with the
+// reasons added to the warnings, if the batch wasn't applied, in which case
+// the block has been rolled back as far as it can be.
+bool BlockArgs::apply(const uhd::device_addr_t &args, bool verify, std::vector<std::string> &warnings)
+{
+    // Read every value from the block once, so that any batch can be rolled
+    // back and unchanged arguments are never sent
+    uhd::device_addr_t current = applied();
+
+    // Collect the changed arguments, along with the values to restore. Those
+    // the block didn't report have no value to restore.
+    uhd::device_addr_t changes;
+    uhd::device_addr_t previous;
+    std::vector<std::string> unrestorable;
+    std::vector<std::string> ids = args.keys();
+
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        const std::string &id = ids[i];
+
+        if (current.has_key(id))
+        {
+            if (current.get(id) == args.get(id))
+            {
+                continue;
+            }
+
+            previous[id] = current.get(id);
+        }
+        else
+        {
+            unrestorable.push_back(id);
+        }
+
+        changes[id] = args.get(id);
+    }
+
+    if (changes.size() == 0)
+    {
+        return true;
+    }
+
+    // Send the batch, and optionally read it all back at once
+    bool accepted = true;
+    std::vector<std::string> changed = changes.keys();
+
+    try
+    {
+        this->writer(changes);
+
+        if (verify)
+        {
+            uhd::device_addr_t readBack = this->reader();
+
+            for (size_t i = 0; i < changed.size(); ++i)
+            {
+                if (not readBack.has_key(changed[i]) or readBack.get(changed[i]) != changes.get(changed[i]))
+                {
+                    warnings.push_back("Failed to set " + changed[i] + " to " + changes.get(changed[i]));
+                    accepted = false;
+                }
+            }
+        }
+    }
+    catch (std::exception &e)
+    {
+        warnings.push_back(std::string("Failed to set arguments: ") + e.what());
+        accepted = false;
+    }
+
+    if (not accepted)
+    {
+        try
+        {
+            if (previous.size() > 0)
+            {
+                this->writer(previous);
+            }
+        }
+        catch (std::exception &e)
+        {
+            // The block's state is unknown, so read it again next time
+            warnings.push_back(std::string("Failed to roll back arguments: ") + e.what());
+            this->cache = uhd::device_addr_t();
+        }
+
+        // Whatever the block kept of the arguments with nothing to restore is
+        // unknown, so read it again next time
+        for (size_t i = 0; i < unrestorable.size(); ++i)
+        {
+            warnings.push_back("Unable to roll back " + unrestorable[i] + ", it had no previous value");
+        }
+
+        if (not unrestorable.empty())
+        {
+            this->cache = uhd::device_addr_t();
+        }
+
+        return false;
+    }
+
+    // Remember what was applied
+    for (size_t i = 0; i < changed.size(); ++i)
+    {
+        this->cache[changed[i]] = changes.get(changed[i]);
+    }
+
+    return true;
+}
+
+// The args last applied, read from the block if they aren't known
+uhd::device_addr_t BlockArgs::applied()
+{
+    if (this->cache.size() == 0)
+    {
+        this->cache = this->reader();
+    }
+
+    return this->cache;
+}
@@ -0,0 +1,46 @@
+#ifndef BLOCKARGS_H
+#define BLOCKARGS_H
+
+// Boost Include(s)
+#include <boost/function.hpp>
+
+// UHD Include(s)
+#include <uhd/types/device_addr.hpp>
+
+// Standard Include(s)
+#include <string>
+#include <vector>
+
+/*
+ * The args last applied to an RF-NoC block, or its emulation, for applying
+ * new ones incrementally. Only the args which differ from the cached values
+ * are sent, together in one batch, and the batch is applied as a whole: if
+ * the block rejects any of it, or doesn't read all of it back when verifying,
+ * the rest is rolled back to the cached values.
+ *
+ * The block's args are read to fill the cache the first time they're needed,
+ * and again whenever what the block holds is no longer known, which is after
+ * a failed rollback or a rejected batch with args the block didn't have.
+ */
+class BlockArgs
+{
+    public:
+        typedef boost::function<uhd::device_addr_t ()> Reader;
+        typedef boost::function<void (const uhd::device_addr_t &)> Writer;
+
+        BlockArgs(const Reader &reader, const Writer &writer);
+
+    // Public Method(s)
+    public:
+        bool apply(const uhd::device_addr_t &args, bool verify, std::vector<std::string> &warnings);
+
+        uhd::device_addr_t applied();
+
+    // Private Member(s)
+    private:
+        uhd::device_addr_t cache;
+        Reader reader;
+        Writer writer;
+};
+
+#endif
@@ -0,0 +1,329 @@
+// Class Include
+#include "BlockKernels.h"
+
+// Boost Include(s)
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+
+// Standard Include(s)
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <stdint.h>
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define KERNEL_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define KERNEL_SSE2
+#endif
+
+namespace
+{
+    const double SHORT_MAX = 32767.0;
+
+    // Shift a fixed point product back down, rounding and saturating
+    inline short narrow(int32_t value, int shift)
+    {
+        if (shift > 0)
+        {
+            value = (value + (1 << (shift - 1))) >> shift;
+        }
+
+        return short(std::min(std::max(value, int32_t(-32768)), int32_t(32767)));
+    }
+
+    double parseDouble(const std::string &id, const std::string &value)
+    {
+        try
+        {
+            return boost::lexical_cast<double>(boost::trim_copy(value));
+        }
+        catch (boost::bad_lexical_cast &)
+        {
+            throw std::invalid_argument("invalid " + id + " " + value);
+        }
+    }
+}
+
+/*
+ * BlockKernel
+ */
+
+// The gain kernel takes a "gain", and the FIR kernel a list of "taps"
+// separated by commas or spaces
+boost::shared_ptr<BlockKernel> BlockKernel::create(const uhd::device_addr_t &args)
+{
+    std::string function = args.get("function", "passthrough");
+
+    if (function == "passthrough")
+    {
+        return boost::make_shared<PassThroughKernel>();
+    }
+    else if (function == "gain")
+    {
+        return boost::make_shared<GainKernel>(parseDouble("gain", args.get("gain", "1.0")));
+    }
+    else if (function == "fir")
+    {
+        std::vector<std::string> values;
+        std::vector<double> taps;
+
+        boost::split(values, args.get("taps", ""), boost::is_any_of(", "), boost::token_compress_on);
+
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (not values[i].empty())
+            {
+                taps.push_back(parseDouble("tap", values[i]));
+            }
+        }
+
+        if (taps.empty())
+        {
+            throw std::invalid_argument("the fir function needs taps");
+        }
+
+        return boost::make_shared<FirKernel>(taps);
+    }
+
+    throw std::invalid_argument("unknown function " + function);
+}
+
+/*
+ * PassThroughKernel
+ */
+
+std::string PassThroughKernel::describe() const
+{
+    return "passthrough";
+}
+
+void PassThroughKernel::process(const std::complex<short> *input, std::complex<short> *output, size_t count)
+{
+    if (input != output)
+    {
+        memcpy(output, input, count * sizeof(std::complex<short>));
+    }
+}
+
+/*
+ * GainKernel
+ */
+
+GainKernel::GainKernel(double gain) :
+    gain(gain),
+    gainFixed(0),
+    shift(15)
+{
+    // Use as many fractional bits as the gain leaves room for
+    while (this->shift > 0 and std::fabs(gain) * (1 << this->shift) > SHORT_MAX)
+    {
+        --this->shift;
+    }
+
+    this->gainFixed = short(std::min(std::max(gain * (1 << this->shift), -SHORT_MAX), SHORT_MAX) + ((gain < 0) ? -0.5 : 0.5));
+}
+
+std::string GainKernel::describe() const
+{
+    std::ostringstream description;
+
+    description << "gain " << this->gain;
+
+    return description.str();
+}
+
+void GainKernel::process(const std::complex<short> *input, std::complex<short> *output, size_t count)
+{
+    const short *in = (const short *) input;
+    short *out = (short *) output;
+    size_t i = 0;
+
+    count *= 2;
+
+#if defined(KERNEL_NEON)
+    int32x4_t shiftVector = vdupq_n_s32(-this->shift);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        int16x8_t shorts = vld1q_s16(in + i);
+
+        int32x4_t low = vmull_n_s16(vget_low_s16(shorts), this->gainFixed);
+        int32x4_t high = vmull_n_s16(vget_high_s16(shorts), this->gainFixed);
+
+        // Rounding shift right, then narrow with saturation
+        low = vrshlq_s32(low, shiftVector);
+        high = vrshlq_s32(high, shiftVector);
+
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+    }
+#elif defined(KERNEL_SSE2)
+    __m128i gainVector = _mm_set1_epi16(this->gainFixed);
+    __m128i rounding = _mm_set1_epi32((this->shift > 0) ? 1 << (this->shift - 1) : 0);
+    __m128i shiftCount = _mm_cvtsi32_si128(this->shift);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i shorts = _mm_loadu_si128((const __m128i *) (in + i));
+
+        // Widen the products to 32 bits
+        __m128i productLow = _mm_mullo_epi16(shorts, gainVector);
+        __m128i productHigh = _mm_mulhi_epi16(shorts, gainVector);
+
+        __m128i low = _mm_unpacklo_epi16(productLow, productHigh);
+        __m128i high = _mm_unpackhi_epi16(productLow, productHigh);
+
+        low = _mm_sra_epi32(_mm_add_epi32(low, rounding), shiftCount);
+        high = _mm_sra_epi32(_mm_add_epi32(high, rounding), shiftCount);
+
+        _mm_storeu_si128((__m128i *) (out + i), _mm_packs_epi32(low, high));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        out[i] = narrow(int32_t(in[i]) * this->gainFixed, this->shift);
+    }
+}
+
+/*
+ * FirKernel
+ */
+
+FirKernel::FirKernel(const std::vector<double> &taps) :
+    shift(15),
+    tapCount(taps.size())
+{
+    double largest = 0;
+    double sum = 0;
+
+    for (size_t i = 0; i < taps.size(); ++i)
+    {
+        largest = std::max(largest, std::fabs(taps[i]));
+        sum += std::fabs(taps[i]);
+    }
+
+    // Every tap has to fit in a short, and the sum of their magnitudes in 16
+    // bits, so that no output can overflow the 32 bit accumulator
+    while (this->shift > 0 and (largest * (1 << this->shift) > SHORT_MAX or sum * (1 << this->shift) + taps.size() > 65535.0))
+    {
+        --this->shift;
+    }
+
+    this->tapsFixed.resize(2 * this->tapCount);
+
+    for (size_t i = 0; i < this->tapCount; ++i)
+    {
+        double scaled = taps[this->tapCount - 1 - i] * (1 << this->shift);
+        short tap = short(std::min(std::max(scaled, -SHORT_MAX), SHORT_MAX) + ((scaled < 0) ? -0.5 : 0.5));
+
+        this->tapsFixed[2 * i] = tap;
+        this->tapsFixed[2 * i + 1] = tap;
+    }
+
+    reset();
+}
+
+std::string FirKernel::describe() const
+{
+    std::ostringstream description;
+
+    description << "fir, " << this->tapCount << " taps";
+
+    return description.str();
+}
+
+void FirKernel::process(const std::complex<short> *input, std::complex<short> *output, size_t count)
+{
+    size_t window = 2 * this->tapCount;
+    size_t kept = window - 2;
+
+    if (this->history.size() < kept + 2 * count)
+    {
+        this->history.resize(kept + 2 * count);
+    }
+
+    memcpy(&this->history[kept], input, count * sizeof(std::complex<short>));
+
+    const short *taps = &this->tapsFixed[0];
+    short *out = (short *) output;
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        const short *samples = &this->history[2 * n];
+        int32_t sumI = 0;
+        int32_t sumQ = 0;
+        size_t j = 0;
+
+        // The lanes alternate between I and Q
+#if defined(KERNEL_NEON)
+        int32x4_t accumulator = vdupq_n_s32(0);
+
+        for (; j + 8 <= window; j += 8)
+        {
+            int16x8_t x = vld1q_s16(samples + j);
+            int16x8_t t = vld1q_s16(taps + j);
+
+            accumulator = vmlal_s16(accumulator, vget_low_s16(x), vget_low_s16(t));
+            accumulator = vmlal_s16(accumulator, vget_high_s16(x), vget_high_s16(t));
+        }
+
+        sumI = vgetq_lane_s32(accumulator, 0) + vgetq_lane_s32(accumulator, 2);
+        sumQ = vgetq_lane_s32(accumulator, 1) + vgetq_lane_s32(accumulator, 3);
+#elif defined(KERNEL_SSE2)
+        __m128i accumulator = _mm_setzero_si128();
+
+        for (; j + 8 <= window; j += 8)
+        {
+            __m128i x = _mm_loadu_si128((const __m128i *) (samples + j));
+            __m128i t = _mm_loadu_si128((const __m128i *) (taps + j));
+
+            __m128i productLow = _mm_mullo_epi16(x, t);
+            __m128i productHigh = _mm_mulhi_epi16(x, t);
+
+            accumulator = _mm_add_epi32(accumulator, _mm_unpacklo_epi16(productLow, productHigh));
+            accumulator = _mm_add_epi32(accumulator, _mm_unpackhi_epi16(productLow, productHigh));
+        }
+
+        int32_t lanes[4];
+        _mm_storeu_si128((__m128i *) lanes, accumulator);
+
+        sumI = lanes[0] + lanes[2];
+        sumQ = lanes[1] + lanes[3];
+#endif
+
+        for (; j < window; j += 2)
+        {
+            sumI += int32_t(samples[j]) * taps[j];
+            sumQ += int32_t(samples[j + 1]) * taps[j + 1];
+        }
+
+        out[2 * n] = narrow(sumI, this->shift);
+        out[2 * n + 1] = narrow(sumQ, this->shift);
+    }
+
+    // Keep the end of this input for the start of the next
+    memmove(&this->history[0], &this->history[2 * count], kept * sizeof(short));
+}
+
+// Forget the previous input, as if preceded by zeros
+void FirKernel::reset()
+{
+    this->history.assign(2 * this->tapCount - 2, 0);
+}
+
+const char *blockKernelName()
+{
+#if defined(KERNEL_NEON)
+    return "NEON";
+#elif defined(KERNEL_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
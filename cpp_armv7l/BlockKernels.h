@@ -0,0 +1,105 @@
+#ifndef BLOCKKERNELS_H
+#define BLOCKKERNELS_H
+
+// Boost Include(s)
+#include <boost/shared_ptr.hpp>
+
+// UHD Include(s)
+#include <uhd/types/device_addr.hpp>
+
+// Standard Include(s)
+#include <complex>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/*
+ * The datapath of an RF-NoC block, run on the CPU over sc16 samples. A kernel
+ * is created from the block's args and keeps whatever state it needs between
+ * calls, so a stream can be processed a piece at a time. Kernels are only
+ * ever run by one thread at a time.
+ */
+class BlockKernel
+{
+    public:
+        virtual ~BlockKernel() {}
+
+    // Public Method(s)
+    public:
+        // Create the kernel named by the "function" arg, configured by the
+        // rest. Throws std::invalid_argument if the args don't describe one.
+        static boost::shared_ptr<BlockKernel> create(const uhd::device_addr_t &args);
+
+        virtual std::string describe() const = 0;
+
+        virtual void process(const std::complex<short> *input, std::complex<short> *output, size_t count) = 0;
+
+        virtual void reset() {}
+};
+
+/*
+ * Copies its input to its output
+ */
+class PassThroughKernel : public BlockKernel
+{
+    public:
+        std::string describe() const;
+
+        void process(const std::complex<short> *input, std::complex<short> *output, size_t count);
+};
+
+/*
+ * Multiplies its input by a constant gain, rounding and saturating. The gain
+ * is applied in fixed point, with as many fractional bits as fit in a short.
+ */
+class GainKernel : public BlockKernel
+{
+    public:
+        GainKernel(double gain);
+
+    // Public Method(s)
+    public:
+        std::string describe() const;
+
+        void process(const std::complex<short> *input, std::complex<short> *output, size_t count);
+
+    // Private Member(s)
+    private:
+        double gain;
+        short gainFixed;
+        int shift;
+};
+
+/*
+ * Filters its input with real taps, applied to I and Q alike. The taps are
+ * applied in fixed point, scaled so that the accumulator can never overflow,
+ * and the last of each input is kept to continue the filter into the next.
+ */
+class FirKernel : public BlockKernel
+{
+    public:
+        FirKernel(const std::vector<double> &taps);
+
+    // Public Method(s)
+    public:
+        std::string describe() const;
+
+        void process(const std::complex<short> *input, std::complex<short> *output, size_t count);
+
+        void reset();
+
+    // Private Member(s)
+    private:
+        // The input, preceded by the last taps - 1 samples of the one before,
+        // as interleaved shorts
+        std::vector<short> history;
+        int shift;
+        // The taps in reverse order, each repeated for I and Q
+        std::vector<short> tapsFixed;
+        size_t tapCount;
+};
+
+// The name of the instruction set the kernels were built for
+const char *blockKernelName();
+
+#endif
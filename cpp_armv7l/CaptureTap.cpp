@@ -0,0 +1,568 @@
+// Class Include
+#include "CaptureTap.h"
+
+// Boost Include(s)
+#include <boost/lexical_cast.hpp>
+
+// Standard Include(s)
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+    // Escape a string for a JSON string literal
+    std::string jsonEscape(const std::string &text)
+    {
+        std::string escaped;
+
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            if (text[i] == '"' or text[i] == '\\')
+            {
+                escaped += '\\';
+            }
+
+            escaped += text[i];
+        }
+
+        return escaped;
+    }
+}
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+CaptureTap::CaptureTap(SampleBufferPool &pool) :
+    active(false),
+    data(NULL),
+    descriptorHead(0),
+    descriptors(DESCRIPTOR_COUNT),
+    descriptorTail(0),
+    dropped(0),
+    endSample(0),
+    expectedTimeValid(false),
+    fd(-1),
+    fileSamples(0),
+    finished(true),
+    inWrite(false),
+    keepStart(0),
+    pendingDropped(0),
+    pool(pool),
+    postTriggerSamples(0),
+    preTriggerSamples(0),
+    running(false),
+    sampleHead(0),
+    sampleRate(0),
+    sampleTail(0),
+    staging(NULL),
+    stagingSamples(0),
+    statusText("idle"),
+    triggered(false),
+    triggerRequested(false),
+    triggerSample(0),
+    written(0)
+{
+}
+
+// Finish any capture in progress before returning the staging ring
+CaptureTap::~CaptureTap()
+{
+    close();
+
+    if (this->writerThread.joinable())
+    {
+        this->writerThread.join();
+    }
+
+    this->pool.release(this->staging);
+}
+
+/*
+ * Public Method(s)
+ */
+
+// Stop taking samples. The writer finishes the capture in the background, so
+// this never waits on the file.
+void CaptureTap::close()
+{
+    if (not this->running)
+    {
+        return;
+    }
+
+    // Make sure the RX thread is done with the staging ring before the
+    // writer takes what's left in it
+    this->active = false;
+
+    while (this->inWrite)
+    {
+        boost::this_thread::yield();
+    }
+
+    this->running = false;
+    this->writerCondition.notify_one();
+}
+
+// Start a new capture, replacing the files at the path. The file holds the
+// given number of samples, and the staging ring covers how far the writer may
+// fall behind before buffers are dropped. Returns false, with the reason in
+// the status, if the data file can't be mapped.
+bool CaptureTap::open(const std::string &path, size_t fileSamples, size_t stagingSamples, double sampleRate, size_t preTriggerSamples, size_t postTriggerSamples, bool triggerNow, const std::string &description)
+{
+    close();
+
+    // Let the last capture finish
+    if (this->writerThread.joinable())
+    {
+        this->writerThread.join();
+    }
+
+    std::string dataPath = path + ".sigmf-data";
+    size_t fileBytes = std::max(fileSamples, size_t(1)) * sizeof(std::complex<short>);
+
+    this->fd = ::open(dataPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (this->fd < 0)
+    {
+        setStatus("error: unable to open " + dataPath + ": " + strerror(errno));
+        return false;
+    }
+
+    void *address = MAP_FAILED;
+
+    if (ftruncate(this->fd, fileBytes) == 0)
+    {
+        address = mmap(NULL, fileBytes, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+    }
+
+    if (address == MAP_FAILED)
+    {
+        setStatus("error: unable to map " + dataPath + ": " + strerror(errno));
+        ::close(this->fd);
+        this->fd = -1;
+        return false;
+    }
+
+    // Replace the staging ring if its size has changed
+    if (stagingSamples != this->stagingSamples)
+    {
+        this->pool.release(this->staging);
+        this->staging = this->pool.acquire<std::complex<short> >(stagingSamples);
+        this->stagingSamples = stagingSamples;
+    }
+
+    this->annotations.clear();
+    this->captures.clear();
+    this->data = (std::complex<short> *) address;
+    this->descriptorHead = 0;
+    this->descriptorTail = 0;
+    this->description = description;
+    this->dropped = 0;
+    this->endSample = 0;
+    this->expectedTimeValid = false;
+    this->fileSamples = std::max(fileSamples, size_t(1));
+    this->finished = false;
+    this->keepStart = 0;
+    this->path = path;
+    this->pendingDropped = 0;
+    this->postTriggerSamples = postTriggerSamples;
+    this->preTriggerSamples = preTriggerSamples;
+    this->sampleHead = 0;
+    this->sampleRate = sampleRate;
+    this->sampleTail = 0;
+    this->triggered = false;
+    this->triggerRequested = triggerNow;
+    this->triggerSample = 0;
+    this->written = 0;
+
+    setStatus((triggerNow) ? "capturing" : "armed");
+
+    this->running = true;
+    this->writerThread = boost::thread(&CaptureTap::writerLoop, this);
+    this->active = true;
+
+    return true;
+}
+
+// Trigger the capture at the next buffer the RX thread stages
+void CaptureTap::trigger()
+{
+    this->triggerRequested = true;
+}
+
+// Stage a buffer for the writer. This never blocks: if the writer has fallen
+// too far behind, the buffer is dropped, and the drop is recorded with the
+// next buffer which is staged.
+void CaptureTap::write(const std::complex<short> *samples, size_t count, const uhd::time_spec_t &time)
+{
+    this->inWrite = true;
+
+    if (not this->active)
+    {
+        this->inWrite.store(false, boost::memory_order_release);
+        return;
+    }
+
+    uint64_t head = this->sampleHead.load(boost::memory_order_relaxed);
+    uint64_t descriptorHead = this->descriptorHead.load(boost::memory_order_relaxed);
+    uint64_t staged = head - this->sampleTail.load(boost::memory_order_acquire);
+
+    if (count > this->stagingSamples - staged or descriptorHead - this->descriptorTail.load(boost::memory_order_acquire) >= DESCRIPTOR_COUNT)
+    {
+        this->dropped.fetch_add(count, boost::memory_order_relaxed);
+        this->pendingDropped += count;
+        this->inWrite.store(false, boost::memory_order_release);
+        return;
+    }
+
+    // Copy the samples in, wrapping around the end of the ring
+    size_t offset = head % this->stagingSamples;
+    size_t first = std::min(count, this->stagingSamples - offset);
+
+    std::copy(samples, samples + first, this->staging + offset);
+    std::copy(samples + first, samples + count, this->staging);
+
+    Descriptor &descriptor = this->descriptors[descriptorHead % DESCRIPTOR_COUNT];
+
+    descriptor.droppedBefore = this->pendingDropped;
+    descriptor.flags = (this->pendingDropped > 0) ? DISCONTINUITY : 0;
+    descriptor.size = count;
+    descriptor.time = time;
+
+    if (this->triggerRequested.exchange(false))
+    {
+        descriptor.flags |= TRIGGER;
+    }
+
+    this->pendingDropped = 0;
+
+    this->sampleHead.store(head + count, boost::memory_order_release);
+    this->descriptorHead.store(descriptorHead + 1, boost::memory_order_release);
+    this->inWrite.store(false, boost::memory_order_release);
+
+    this->writerCondition.notify_one();
+}
+
+// The samples dropped from the current or last capture
+uint64_t CaptureTap::droppedSamples() const
+{
+    return this->dropped.load(boost::memory_order_relaxed);
+}
+
+std::string CaptureTap::status() const
+{
+    boost::mutex::scoped_lock lock(this->statusLock);
+
+    return this->statusText;
+}
+
+/*
+ * Private Method(s)
+ */
+
+// Copy staged samples to the data file at the current write position,
+// wrapping around the ends of both rings
+void CaptureTap::copyToFile(size_t stagingOffset, size_t count)
+{
+    uint64_t position = this->written;
+
+    while (count > 0)
+    {
+        size_t fileOffset = position % this->fileSamples;
+        size_t chunk = std::min(count, std::min(this->stagingSamples - stagingOffset, this->fileSamples - fileOffset));
+
+        memcpy(this->data + fileOffset, this->staging + stagingOffset, chunk * sizeof(std::complex<short>));
+
+        count -= chunk;
+        position += chunk;
+        stagingOffset = (stagingOffset + chunk) % this->stagingSamples;
+    }
+}
+
+// Complete the capture: unroll the data so that it starts at the oldest kept
+// sample, cut the file to length, and write the sidecar
+void CaptureTap::finalize()
+{
+    this->finished = true;
+    this->active = false;
+
+    uint64_t start = (this->written > this->fileSamples) ? this->written - this->fileSamples : 0;
+
+    if (this->triggered)
+    {
+        start = std::max(start, this->keepStart);
+    }
+
+    size_t length = this->written - start;
+    size_t offset = start % this->fileSamples;
+
+    if (offset != 0 and offset + length <= this->fileSamples)
+    {
+        memmove(this->data, this->data + offset, length * sizeof(std::complex<short>));
+    }
+    else if (offset != 0)
+    {
+        std::rotate(this->data, this->data + offset, this->data + this->fileSamples);
+    }
+
+    munmap(this->data, this->fileSamples * sizeof(std::complex<short>));
+    this->data = NULL;
+
+    std::string result = "complete: " + this->path + ", " + boost::lexical_cast<std::string>(length) + " samples";
+
+    if (ftruncate(this->fd, length * sizeof(std::complex<short>)) != 0)
+    {
+        result = "error: unable to truncate " + this->path + ".sigmf-data: " + strerror(errno);
+    }
+
+    ::close(this->fd);
+    this->fd = -1;
+
+    writeMetadata(start);
+
+    if (not this->triggered)
+    {
+        result += ", never triggered";
+    }
+
+    if (this->dropped > 0)
+    {
+        result += ", " + boost::lexical_cast<std::string>(this->dropped.load()) + " dropped";
+    }
+
+    setStatus(result);
+}
+
+// Move the oldest staged buffer to the data file
+void CaptureTap::process()
+{
+    uint64_t tail = this->descriptorTail.load(boost::memory_order_relaxed);
+    uint64_t sampleTail = this->sampleTail.load(boost::memory_order_relaxed);
+    const Descriptor &descriptor = this->descriptors[tail % DESCRIPTOR_COUNT];
+
+    if (not this->finished)
+    {
+        if ((descriptor.flags & TRIGGER) and not this->triggered)
+        {
+            startTrigger(descriptor.time);
+        }
+
+        size_t count = descriptor.size;
+
+        if (this->triggered)
+        {
+            count = std::min(uint64_t(count), this->endSample - this->written);
+        }
+
+        // A new run starts after a drop, or wherever the time stamps don't
+        // follow on from the last buffer
+        bool follows = this->expectedTimeValid and not (descriptor.flags & DISCONTINUITY);
+
+        if (follows and this->sampleRate > 0)
+        {
+            follows = (std::abs((descriptor.time - this->expectedTime).get_real_secs()) * this->sampleRate < 0.5);
+        }
+
+        if (not follows)
+        {
+            Mark capture;
+
+            capture.sample = this->written;
+            capture.time = descriptor.time;
+
+            this->captures.push_back(capture);
+        }
+
+        if (descriptor.droppedBefore > 0)
+        {
+            Mark drop;
+
+            drop.sample = this->written;
+            drop.time = descriptor.time;
+            drop.label = boost::lexical_cast<std::string>(descriptor.droppedBefore) + " samples dropped";
+
+            this->annotations.push_back(drop);
+        }
+
+        copyToFile(sampleTail % this->stagingSamples, count);
+
+        this->written += count;
+        this->expectedTime = descriptor.time;
+        this->expectedTimeValid = true;
+
+        if (this->sampleRate > 0)
+        {
+            this->expectedTime += uhd::time_spec_t(descriptor.size / this->sampleRate);
+        }
+
+        // Forget about anything which has since been overwritten
+        uint64_t oldest = (this->written > this->fileSamples) ? this->written - this->fileSamples : 0;
+
+        while (this->captures.size() > 1 and this->captures[1].sample <= oldest)
+        {
+            this->captures.pop_front();
+        }
+
+        while (not this->annotations.empty() and this->annotations.front().sample < oldest)
+        {
+            this->annotations.pop_front();
+        }
+
+        if (this->triggered and this->written >= this->endSample)
+        {
+            finalize();
+        }
+    }
+
+    this->sampleTail.store(sampleTail + descriptor.size, boost::memory_order_release);
+    this->descriptorTail.store(tail + 1, boost::memory_order_release);
+}
+
+void CaptureTap::setStatus(const std::string &status)
+{
+    boost::mutex::scoped_lock lock(this->statusLock);
+
+    this->statusText = status;
+}
+
+// Fix the part of the file to keep: up to the pre-trigger length before the
+// trigger, and up to the post-trigger length after it, within the file size
+void CaptureTap::startTrigger(const uhd::time_spec_t &time)
+{
+    this->triggered = true;
+    this->triggerSample = this->written;
+
+    uint64_t oldest = (this->written > this->fileSamples) ? this->written - this->fileSamples : 0;
+
+    this->keepStart = std::max(oldest, this->written - std::min(uint64_t(this->preTriggerSamples), this->written));
+    this->endSample = this->keepStart + this->fileSamples;
+
+    if (this->postTriggerSamples > 0)
+    {
+        this->endSample = std::min(this->endSample, this->triggerSample + this->postTriggerSamples);
+    }
+
+    Mark trigger;
+
+    trigger.sample = this->triggerSample;
+    trigger.time = time;
+    trigger.label = "trigger";
+
+    this->annotations.push_back(trigger);
+
+    setStatus("capturing");
+}
+
+// Write the SigMF sidecar. Sample indices are relative to the first kept
+// sample, and each capture carries the UHD time of its first sample, which
+// may be the device's time rather than UTC.
+void CaptureTap::writeMetadata(uint64_t keepStart)
+{
+    std::ofstream meta((this->path + ".sigmf-meta").c_str());
+
+    meta << std::setprecision(17);
+    meta << "{\n";
+    meta << "  \"global\": {\n";
+    meta << "    \"core:datatype\": \"ci16_le\",\n";
+
+    if (this->sampleRate > 0)
+    {
+        meta << "    \"core:sample_rate\": " << this->sampleRate << ",\n";
+    }
+
+    meta << "    \"core:version\": \"1.0.0\",\n";
+    meta << "    \"core:description\": \"" << jsonEscape(this->description) << "\",\n";
+    meta << "    \"core:extensions\": [{\"name\": \"rfnoc\", \"version\": \"1.0.0\", \"optional\": true}],\n";
+    meta << "    \"rfnoc:dropped_samples\": " << this->dropped.load() << "\n";
+    meta << "  },\n";
+
+    // Trim the first run to the start of the kept samples
+    meta << "  \"captures\": [";
+
+    const char *separator = "\n";
+
+    for (size_t i = 0; i < this->captures.size(); ++i)
+    {
+        if (i + 1 < this->captures.size() and this->captures[i + 1].sample <= keepStart)
+        {
+            continue;
+        }
+
+        uint64_t sample = std::max(this->captures[i].sample, keepStart);
+        uhd::time_spec_t time = this->captures[i].time;
+
+        if (this->sampleRate > 0)
+        {
+            time += uhd::time_spec_t((sample - this->captures[i].sample) / this->sampleRate);
+        }
+
+        meta << separator << "    {\"core:sample_start\": " << sample - keepStart << ", \"rfnoc:full_secs\": " << time.get_full_secs() << ", \"rfnoc:frac_secs\": " << time.get_frac_secs() << "}";
+
+        separator = ",\n";
+    }
+
+    if (this->captures.empty())
+    {
+        meta << separator << "    {\"core:sample_start\": 0}";
+    }
+
+    meta << "\n  ],\n";
+
+    meta << "  \"annotations\": [";
+
+    separator = "\n";
+
+    for (size_t i = 0; i < this->annotations.size(); ++i)
+    {
+        if (this->annotations[i].sample < keepStart)
+        {
+            continue;
+        }
+
+        meta << separator << "    {\"core:sample_start\": " << this->annotations[i].sample - keepStart << ", \"core:label\": \"" << jsonEscape(this->annotations[i].label) << "\"}";
+
+        separator = ",\n";
+    }
+
+    meta << "\n  ]\n";
+    meta << "}\n";
+}
+
+// Move staged buffers to the file until closed, then finish the capture with
+// whatever was staged before the close
+void CaptureTap::writerLoop()
+{
+    while (true)
+    {
+        bool stopping = not this->running;
+
+        if (this->descriptorTail.load(boost::memory_order_relaxed) == this->descriptorHead.load(boost::memory_order_acquire))
+        {
+            if (stopping)
+            {
+                break;
+            }
+
+            boost::mutex::scoped_lock lock(this->writerLock);
+
+            this->writerCondition.timed_wait(lock, boost::posix_time::milliseconds(10));
+
+            continue;
+        }
+
+        process();
+    }
+
+    if (not this->finished)
+    {
+        finalize();
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef CAPTURETAP_H
+#define CAPTURETAP_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+// Local Include(s)
+#include "SampleBufferPool.h"
+
+// UHD Include(s)
+#include <uhd/types/time_spec.hpp>
+
+// Standard Include(s)
+#include <complex>
+#include <deque>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * A tap recording the received samples to a SigMF-style pair of files: the raw
+ * sc16 samples in <path>.sigmf-data, and a JSON sidecar in <path>.sigmf-meta
+ * with the time stamp of every contiguous run, the trigger, and any drops.
+ *
+ * The RX thread only copies each buffer into a lock-free staging ring, and a
+ * buffer which doesn't fit is dropped and counted rather than waited for. A
+ * writer thread moves the staged samples into the data file, which is mapped
+ * into memory and written as a ring. Before the trigger the ring keeps the
+ * most recent samples, of which the pre-trigger length is kept once it fires.
+ * The capture completes after the post-trigger length, once the file is full,
+ * or when the tap is closed, at which point the data is unrolled so that the
+ * file starts at its oldest sample, and the sidecar is written.
+ */
+class CaptureTap
+{
+    public:
+        CaptureTap(SampleBufferPool &pool);
+
+        ~CaptureTap();
+
+    // Public Method(s)
+    public:
+        // Methods for the controlling thread
+        void close();
+
+        bool open(const std::string &path, size_t fileSamples, size_t stagingSamples, double sampleRate, size_t preTriggerSamples, size_t postTriggerSamples, bool triggerNow, const std::string &description);
+
+        void trigger();
+
+        // Methods for the RX thread
+        void write(const std::complex<short> *samples, size_t count, const uhd::time_spec_t &time);
+
+        // Bookkeeping
+        uint64_t droppedSamples() const;
+
+        std::string status() const;
+
+    // Private Method(s)
+    private:
+        void copyToFile(size_t stagingOffset, size_t count);
+
+        void finalize();
+
+        void process();
+
+        void setStatus(const std::string &status);
+
+        void startTrigger(const uhd::time_spec_t &time);
+
+        void writeMetadata(uint64_t keepStart);
+
+        void writerLoop();
+
+    // Private Member(s)
+    private:
+        static const size_t DESCRIPTOR_COUNT = 256;
+        static const uint32_t DISCONTINUITY = 1;
+        static const uint32_t TRIGGER = 2;
+
+        // A buffer waiting in the staging ring
+        struct Descriptor
+        {
+            uint64_t droppedBefore;
+            uint32_t flags;
+            size_t size;
+            uhd::time_spec_t time;
+        };
+
+        // A position in the data file along with a description of it
+        struct Mark
+        {
+            uint64_t sample;
+            uhd::time_spec_t time;
+            std::string label;
+        };
+
+        boost::atomic<bool> active;
+        std::deque<Mark> annotations;
+        std::deque<Mark> captures;
+        std::complex<short> *data;
+        boost::atomic<uint64_t> descriptorHead;
+        std::vector<Descriptor> descriptors;
+        boost::atomic<uint64_t> descriptorTail;
+        std::string description;
+        boost::atomic<uint64_t> dropped;
+        uint64_t endSample;
+        uhd::time_spec_t expectedTime;
+        bool expectedTimeValid;
+        int fd;
+        size_t fileSamples;
+        bool finished;
+        boost::atomic<bool> inWrite;
+        uint64_t keepStart;
+        std::string path;
+        uint64_t pendingDropped;
+        SampleBufferPool &pool;
+        size_t postTriggerSamples;
+        size_t preTriggerSamples;
+        boost::atomic<bool> running;
+        boost::atomic<uint64_t> sampleHead;
+        double sampleRate;
+        boost::atomic<uint64_t> sampleTail;
+        std::complex<short> *staging;
+        size_t stagingSamples;
+        std::string statusText;
+        mutable boost::mutex statusLock;
+        bool triggered;
+        boost::atomic<bool> triggerRequested;
+        uint64_t triggerSample;
+        boost::condition_variable writerCondition;
+        boost::mutex writerLock;
+        boost::thread writerThread;
+        uint64_t written;
+};
+
+#endif
@@ -0,0 +1,267 @@
+// Class Include
+#include "EmulatedBlock.h"
+
+// Boost Include(s)
+#include <boost/make_shared.hpp>
+
+// Standard Include(s)
+#include <algorithm>
+#include <cstring>
+
+/*
+ * EmulatedBlock
+ */
+
+EmulatedBlock::EmulatedBlock(size_t queueSamples) :
+    kernel(BlockKernel::create(uhd::device_addr_t())),
+    queue(std::max(queueSamples, size_t(1))),
+    queueHead(0),
+    queueTail(0),
+    streaming(false)
+{
+}
+
+// The kernel in use, and the instruction set it was built for
+std::string EmulatedBlock::describe() const
+{
+    boost::mutex::scoped_lock lock(this->argsLock);
+
+    return this->kernel->describe() + " (" + blockKernelName() + ")";
+}
+
+uhd::device_addr_t EmulatedBlock::getArgs() const
+{
+    boost::mutex::scoped_lock lock(this->argsLock);
+
+    return this->args;
+}
+
+uhd::rx_streamer::sptr EmulatedBlock::getRxStreamer(size_t spp)
+{
+    return boost::make_shared<EmulatedRxStreamer>(shared_from_this(), spp);
+}
+
+uhd::tx_streamer::sptr EmulatedBlock::getTxStreamer(size_t spp)
+{
+    return boost::make_shared<EmulatedTxStreamer>(shared_from_this(), spp);
+}
+
+// Apply a batch of args, replacing the kernel if any of its args changed.
+// Throws std::invalid_argument, leaving everything as it was, if the new
+// kernel can't be created.
+void EmulatedBlock::setArgs(const uhd::device_addr_t &args)
+{
+    boost::mutex::scoped_lock lock(this->argsLock);
+
+    uhd::device_addr_t merged = this->args;
+    std::vector<std::string> ids = args.keys();
+
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        merged[ids[i]] = args.get(ids[i]);
+    }
+
+    if (args.has_key("function") or args.has_key("gain") or args.has_key("taps"))
+    {
+        boost::shared_ptr<BlockKernel> kernel = BlockKernel::create(merged);
+
+        boost::mutex::scoped_lock kernelLock(this->kernelLock);
+
+        this->kernel = kernel;
+    }
+
+    this->args = merged;
+}
+
+// Take up to the given number of samples from the queue, waiting up to the
+// timeout for any to arrive. Only the RX streamer reads.
+size_t EmulatedBlock::read(std::complex<short> *samples, size_t count, double timeout)
+{
+    boost::mutex::scoped_lock lock(this->queueLock);
+
+    if (this->queueHead == this->queueTail)
+    {
+        this->readable.timed_wait(lock, boost::posix_time::microseconds(long(timeout * 1e6)));
+    }
+
+    size_t numSamples = 0;
+
+    // The queued samples may wrap around the end
+    while (numSamples < count and this->queueTail != this->queueHead)
+    {
+        size_t offset = this->queueTail % this->queue.size();
+        size_t available = std::min<uint64_t>(this->queueHead - this->queueTail, this->queue.size() - offset);
+        size_t piece = std::min(count - numSamples, available);
+
+        // The writer never touches the queued samples, so copy them unlocked
+        lock.unlock();
+        memcpy(samples + numSamples, &this->queue[offset], piece * sizeof(std::complex<short>));
+        lock.lock();
+
+        this->queueTail += piece;
+        numSamples += piece;
+    }
+
+    this->writable.notify_all();
+
+    return numSamples;
+}
+
+void EmulatedBlock::setStreaming(bool streaming)
+{
+    this->streaming = streaming;
+}
+
+// Run the samples through the kernel into the queue, as many as there is
+// room for, waiting up to the timeout for some room if there is none. Only
+// the TX streamer writes.
+size_t EmulatedBlock::write(const std::complex<short> *samples, size_t count, double timeout)
+{
+    if (not this->streaming.load(boost::memory_order_relaxed))
+    {
+        return count;
+    }
+
+    boost::mutex::scoped_lock lock(this->queueLock);
+
+    if (this->queueHead - this->queueTail == this->queue.size())
+    {
+        this->writable.timed_wait(lock, boost::posix_time::microseconds(long(timeout * 1e6)));
+    }
+
+    size_t numSamples = 0;
+
+    while (numSamples < count and this->queueHead - this->queueTail < this->queue.size())
+    {
+        size_t offset = this->queueHead % this->queue.size();
+        size_t room = std::min<uint64_t>(this->queue.size() - (this->queueHead - this->queueTail), this->queue.size() - offset);
+        size_t piece = std::min(count - numSamples, room);
+
+        // The reader never touches the free space, so process into it
+        // unlocked
+        lock.unlock();
+
+        {
+            boost::mutex::scoped_lock kernelLock(this->kernelLock);
+
+            this->kernel->process(samples + numSamples, &this->queue[offset], piece);
+        }
+
+        lock.lock();
+
+        this->queueHead += piece;
+        numSamples += piece;
+    }
+
+    this->readable.notify_all();
+
+    return numSamples;
+}
+
+/*
+ * EmulatedRxStreamer
+ */
+
+EmulatedRxStreamer::EmulatedRxStreamer(boost::shared_ptr<EmulatedBlock> block, size_t spp) :
+    block(block),
+    finiteDone(false),
+    finiteRemaining(0),
+    spp(spp)
+{
+}
+
+size_t EmulatedRxStreamer::get_num_channels() const
+{
+    return 1;
+}
+
+size_t EmulatedRxStreamer::get_max_num_samps() const
+{
+    return this->spp;
+}
+
+// Return whatever the block has produced, up to the end of a finite capture
+size_t EmulatedRxStreamer::recv(const buffs_type &buffs, const size_t nsamps_per_buff, uhd::rx_metadata_t &metadata, const double timeout, const bool one_packet)
+{
+    metadata.reset();
+
+    size_t numSamples = (one_packet) ? std::min(nsamps_per_buff, this->spp) : nsamps_per_buff;
+    uint64_t remaining = this->finiteRemaining.load();
+
+    if (remaining > 0)
+    {
+        numSamples = std::min<uint64_t>(numSamples, remaining);
+    }
+
+    numSamples = this->block->read((std::complex<short> *) buffs[0], numSamples, timeout);
+
+    if (numSamples == 0)
+    {
+        metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_TIMEOUT;
+        return 0;
+    }
+
+    metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_NONE;
+
+    // Finite captures stop streaming once they have their samples, ending
+    // the burst unless the command promised more to follow
+    if (remaining > 0)
+    {
+        this->finiteRemaining -= numSamples;
+
+        if (remaining == numSamples)
+        {
+            metadata.end_of_burst = this->finiteDone;
+            this->block->setStreaming(false);
+        }
+    }
+
+    return numSamples;
+}
+
+// Stream commands take effect immediately, ignoring any time spec
+void EmulatedRxStreamer::issue_stream_cmd(const uhd::stream_cmd_t &stream_cmd)
+{
+    if (stream_cmd.stream_mode == uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS)
+    {
+        this->block->setStreaming(false);
+    }
+    else
+    {
+        this->finiteDone = (stream_cmd.stream_mode == uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_DONE);
+        this->finiteRemaining = (stream_cmd.stream_mode == uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS) ? 0 : stream_cmd.num_samps;
+        this->block->setStreaming(true);
+    }
+}
+
+/*
+ * EmulatedTxStreamer
+ */
+
+EmulatedTxStreamer::EmulatedTxStreamer(boost::shared_ptr<EmulatedBlock> block, size_t spp) :
+    block(block),
+    spp(spp)
+{
+}
+
+size_t EmulatedTxStreamer::get_num_channels() const
+{
+    return 1;
+}
+
+size_t EmulatedTxStreamer::get_max_num_samps() const
+{
+    return this->spp;
+}
+
+size_t EmulatedTxStreamer::send(const buffs_type &buffs, const size_t nsamps_per_buff, const uhd::tx_metadata_t &metadata, const double timeout)
+{
+    return this->block->write((const std::complex<short> *) buffs[0], nsamps_per_buff, timeout);
+}
+
+bool EmulatedTxStreamer::recv_async_msg(uhd::async_metadata_t &async_metadata, double timeout)
+{
+    boost::this_thread::sleep(boost::posix_time::microseconds(long(timeout * 1e6)));
+
+    return false;
+}
@@ -0,0 +1,127 @@
+#ifndef EMULATEDBLOCK_H
+#define EMULATEDBLOCK_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/thread.hpp>
+
+// Local Include(s)
+#include "BlockKernels.h"
+
+// UHD Include(s)
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+
+// Standard Include(s)
+#include <complex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * An RF-NoC block emulated on the CPU, for hosts without the FPGA. Samples
+ * sent to its TX streamer are run through a kernel chosen by the args and
+ * queued for its RX streamer, which behaves as a block's would, streaming
+ * only once a stream command has been issued, and only for as many samples as
+ * a finite one asks for. Output produced while the RX streamer isn't
+ * streaming is discarded, as there is nowhere for it to go.
+ *
+ * The args stand in for the block's registers: any are accepted and read
+ * back, and the "function", "gain" and "taps" args configure the kernel. A
+ * batch which doesn't describe a kernel is rejected as a whole. The queue
+ * holds a fixed number of samples, so a TX streamer ahead of the RX streamer
+ * waits for room, as it would under the block's flow control.
+ */
+class EmulatedBlock : public boost::enable_shared_from_this<EmulatedBlock>
+{
+    public:
+        EmulatedBlock(size_t queueSamples);
+
+    // Public Method(s)
+    public:
+        // Methods for the controlling thread
+        std::string describe() const;
+
+        uhd::device_addr_t getArgs() const;
+
+        uhd::rx_streamer::sptr getRxStreamer(size_t spp);
+
+        uhd::tx_streamer::sptr getTxStreamer(size_t spp);
+
+        void setArgs(const uhd::device_addr_t &args);
+
+        // Methods for the streamers
+        size_t read(std::complex<short> *samples, size_t count, double timeout);
+
+        void setStreaming(bool streaming);
+
+        size_t write(const std::complex<short> *samples, size_t count, double timeout);
+
+    // Private Member(s)
+    private:
+        uhd::device_addr_t args;
+        mutable boost::mutex argsLock;
+        boost::shared_ptr<BlockKernel> kernel;
+        boost::mutex kernelLock;
+        std::vector<std::complex<short> > queue;
+        uint64_t queueHead;
+        boost::mutex queueLock;
+        uint64_t queueTail;
+        boost::condition_variable readable;
+        boost::atomic<bool> streaming;
+        boost::condition_variable writable;
+};
+
+/*
+ * The RX streamer of an emulated block
+ */
+class EmulatedRxStreamer : public uhd::rx_streamer
+{
+    public:
+        EmulatedRxStreamer(boost::shared_ptr<EmulatedBlock> block, size_t spp);
+
+    // Public uhd::rx_streamer Method(s)
+    public:
+        size_t get_num_channels() const;
+
+        size_t get_max_num_samps() const;
+
+        size_t recv(const buffs_type &buffs, const size_t nsamps_per_buff, uhd::rx_metadata_t &metadata, const double timeout = 0.1, const bool one_packet = false);
+
+        void issue_stream_cmd(const uhd::stream_cmd_t &stream_cmd);
+
+    // Private Member(s)
+    private:
+        boost::shared_ptr<EmulatedBlock> block;
+        boost::atomic<bool> finiteDone;
+        boost::atomic<uint64_t> finiteRemaining;
+        size_t spp;
+};
+
+/*
+ * The TX streamer of an emulated block. It never has any asynchronous
+ * messages to report.
+ */
+class EmulatedTxStreamer : public uhd::tx_streamer
+{
+    public:
+        EmulatedTxStreamer(boost::shared_ptr<EmulatedBlock> block, size_t spp);
+
+    // Public uhd::tx_streamer Method(s)
+    public:
+        size_t get_num_channels() const;
+
+        size_t get_max_num_samps() const;
+
+        size_t send(const buffs_type &buffs, const size_t nsamps_per_buff, const uhd::tx_metadata_t &metadata, const double timeout = 0.1);
+
+        bool recv_async_msg(uhd::async_metadata_t &async_metadata, double timeout = 0.1);
+
+    // Private Member(s)
+    private:
+        boost::shared_ptr<EmulatedBlock> block;
+        size_t spp;
+};
+
+#endif
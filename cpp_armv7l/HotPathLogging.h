@@ -0,0 +1,96 @@
+#ifndef HOTPATHLOGGING_H
+#define HOTPATHLOGGING_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+
+// Standard Include(s)
+#include <time.h>
+
+/*
+ * Decides which iterations of a streaming loop get to log. One in every
+ * interval calls is let through, and no more than maxPerSecond of those per
+ * second. An interval of zero silences the sampler entirely.
+ *
+ * Each sampler is meant to be used by a single streaming thread; only the
+ * configuration may be changed from another thread.
+ */
+class LogSampler
+{
+    public:
+        LogSampler(unsigned int interval = 1, unsigned int maxPerSecond = 0) :
+            count(0),
+            emitted(0),
+            interval(interval),
+            maxPerSecond(maxPerSecond),
+            windowStart(0)
+        {
+        }
+
+    // Public Method(s)
+    public:
+        void configure(unsigned int interval, unsigned int maxPerSecond)
+        {
+            this->interval.store(interval, boost::memory_order_relaxed);
+            this->maxPerSecond.store(maxPerSecond, boost::memory_order_relaxed);
+        }
+
+        bool sample()
+        {
+            unsigned int interval = this->interval.load(boost::memory_order_relaxed);
+
+            if (interval == 0 or ++this->count < interval)
+            {
+                return false;
+            }
+
+            this->count = 0;
+
+            unsigned int maxPerSecond = this->maxPerSecond.load(boost::memory_order_relaxed);
+
+            if (maxPerSecond == 0)
+            {
+                return true;
+            }
+
+            // Only consult the clock for iterations which passed the interval
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+
+            if (now.tv_sec != this->windowStart)
+            {
+                this->windowStart = now.tv_sec;
+                this->emitted = 0;
+            }
+
+            return (this->emitted++ < maxPerSecond);
+        }
+
+    // Private Member(s)
+    private:
+        unsigned int count;
+        unsigned int emitted;
+        boost::atomic<unsigned int> interval;
+        boost::atomic<unsigned int> maxPerSecond;
+        time_t windowStart;
+};
+
+/*
+ * Logging macros for the per-recv and per-send loops. Sample once per loop
+ * iteration with HOT_LOG_SAMPLE, then pass the result to the logging macros so
+ * that skipped iterations never build their log messages. Configuring with
+ * --disable-hot-path-logging compiles all of them out.
+ */
+#ifdef DISABLE_HOT_PATH_LOGGING
+#define HOT_LOG_SAMPLE(sampler) false
+#define HOT_LOG_TRACE(classname, sampled, expression) do { (void) (sampled); } while (0)
+#define HOT_LOG_DEBUG(classname, sampled, expression) do { (void) (sampled); } while (0)
+#else
+#define HOT_LOG_SAMPLE(sampler) (sampler).sample()
+#define HOT_LOG_TRACE(classname, sampled, expression) \
+    do { if (sampled) { LOG_TRACE(classname, expression); } } while (0)
+#define HOT_LOG_DEBUG(classname, sampled, expression) \
+    do { if (sampled) { LOG_DEBUG(classname, expression); } } while (0)
+#endif
+
+#endif
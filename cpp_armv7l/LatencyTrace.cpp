@@ -0,0 +1,303 @@
+// Class Include
+#include "LatencyTrace.h"
+
+// Boost Include(s)
+#include <boost/lexical_cast.hpp>
+
+// Standard Include(s)
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <time.h>
+
+namespace
+{
+    // The name of each stage, in the order of LatencyTrace::Stage
+    const char *STAGE_NAMES[LatencyTrace::NUM_STAGES] = {
+        "rx_recv",
+        "rx_fill",
+        "rx_queue",
+        "rx_push",
+        "rx_recv_age",
+        "rx_push_age",
+        "tx_read",
+        "tx_queue",
+        "tx_send",
+        "tx_burst_age"
+    };
+
+    // The Chrome trace thread each stage is drawn on. The queue stages span
+    // two threads, so they're drawn as async events instead.
+    const int STAGE_THREADS[LatencyTrace::NUM_STAGES] = {
+        1, 1, 2, 2, 1, 2, 3, 4, 4, 4
+    };
+
+    const char *THREAD_NAMES[] = {
+        "",
+        "RX recv",
+        "RX push",
+        "TX",
+        "TX send"
+    };
+
+    bool isAge(uint32_t stage)
+    {
+        return (stage == LatencyTrace::RX_RECV_AGE or stage == LatencyTrace::RX_PUSH_AGE or stage == LatencyTrace::TX_BURST_AGE);
+    }
+
+    bool isQueue(uint32_t stage)
+    {
+        return (stage == LatencyTrace::RX_QUEUE or stage == LatencyTrace::TX_QUEUE);
+    }
+}
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+LatencyTrace::LatencyTrace() :
+    active(false),
+    ages(false),
+    capacity(0),
+    head(0),
+    statusText("disabled"),
+    writers(0)
+{
+}
+
+/*
+ * Public Method(s)
+ */
+
+// The host's UTC time, which the block's time is compared against
+uhd::time_spec_t LatencyTrace::hostTime()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    return uhd::time_spec_t(time_t(now.tv_sec), now.tv_nsec / 1e9);
+}
+
+// Start or stop tracing. The ring is rounded up to a power of two events, and
+// is only replaced, discarding what it holds, when its size changes.
+void LatencyTrace::configure(bool enabled, bool endToEnd, size_t capacity)
+{
+    // Make sure no streaming thread is still writing to the ring before it's
+    // replaced
+    this->active = false;
+    this->ages = false;
+
+    while (this->writers.load() > 0)
+    {
+        boost::this_thread::yield();
+    }
+
+    size_t rounded = 1;
+
+    while (rounded < std::max(capacity, size_t(1)))
+    {
+        rounded <<= 1;
+    }
+
+    if (enabled and rounded != this->capacity)
+    {
+        this->slots.reset(new Slot[rounded]);
+        this->capacity = rounded;
+        this->head = 0;
+
+        for (size_t i = 0; i < rounded; ++i)
+        {
+            this->slots[i].sequence.store(0, boost::memory_order_relaxed);
+        }
+    }
+
+    this->ages = (enabled and endToEnd);
+    this->active = enabled;
+
+    setStatus((enabled) ? "tracing" : "disabled");
+}
+
+// Write the events in the ring to a file, oldest first, in either the Chrome
+// trace event format or as perf-friendly text. Tracing carries on meanwhile,
+// and events overwritten during the copy are left out.
+bool LatencyTrace::exportTrace(const std::string &path, const std::string &format)
+{
+    std::vector<TraceEvent> events;
+
+    snapshot(events);
+
+    std::ofstream out(path.c_str());
+
+    if (not out)
+    {
+        setStatus("error: unable to open " + path);
+        return false;
+    }
+
+    if (format == "chrome")
+    {
+        writeChrome(out, events);
+    }
+    else
+    {
+        writePerf(out, events);
+    }
+
+    out.close();
+
+    if (not out)
+    {
+        setStatus("error: unable to write " + path);
+        return false;
+    }
+
+    setStatus(std::string((this->active) ? "tracing" : "disabled") + ", exported " + boost::lexical_cast<std::string>(events.size()) + " events to " + path);
+
+    return true;
+}
+
+std::string LatencyTrace::status() const
+{
+    boost::mutex::scoped_lock lock(this->statusLock);
+
+    return this->statusText;
+}
+
+/*
+ * Private Method(s)
+ */
+
+// Claim the next slot and fill it in. The writer count keeps configure from
+// replacing the ring underneath, so tracing is checked again once counted.
+void LatencyTrace::append(Stage stage, uint64_t start, int64_t duration, size_t samples)
+{
+    this->writers.fetch_add(1);
+
+    if (this->active.load())
+    {
+        uint64_t index = this->head.fetch_add(1, boost::memory_order_relaxed);
+        Slot &slot = this->slots[index & (this->capacity - 1)];
+
+        slot.sequence.store(0, boost::memory_order_relaxed);
+        boost::atomic_thread_fence(boost::memory_order_release);
+
+        slot.start = start;
+        slot.duration = duration;
+        slot.samples = samples;
+        slot.stage = stage;
+
+        slot.sequence.store(index + 1, boost::memory_order_release);
+    }
+
+    this->writers.fetch_sub(1, boost::memory_order_release);
+}
+
+void LatencyTrace::setStatus(const std::string &status)
+{
+    boost::mutex::scoped_lock lock(this->statusLock);
+
+    this->statusText = status;
+}
+
+// Copy out every event still in the ring, skipping any slot being written or
+// overwritten while it was read
+void LatencyTrace::snapshot(std::vector<TraceEvent> &events) const
+{
+    events.clear();
+
+    if (this->capacity == 0)
+    {
+        return;
+    }
+
+    uint64_t head = this->head.load(boost::memory_order_acquire);
+    uint64_t first = (head > this->capacity) ? head - this->capacity : 0;
+
+    events.reserve(head - first);
+
+    for (uint64_t index = first; index < head; ++index)
+    {
+        const Slot &slot = this->slots[index & (this->capacity - 1)];
+
+        if (slot.sequence.load(boost::memory_order_acquire) != index + 1)
+        {
+            continue;
+        }
+
+        TraceEvent event;
+
+        event.start = slot.start;
+        event.duration = slot.duration;
+        event.samples = slot.samples;
+        event.stage = slot.stage;
+
+        boost::atomic_thread_fence(boost::memory_order_acquire);
+
+        if (slot.sequence.load(boost::memory_order_relaxed) == index + 1)
+        {
+            events.push_back(event);
+        }
+    }
+
+    // Events are claimed as they end, so put them back in order of starting
+    std::stable_sort(events.begin(), events.end());
+}
+
+// Write the Chrome trace event format, for chrome://tracing or Perfetto. Each
+// stage is drawn on the thread it runs on, the queue stages as async spans,
+// and the ages as counters in microseconds.
+void LatencyTrace::writeChrome(std::ostream &out, const std::vector<TraceEvent> &events)
+{
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+
+    for (size_t tid = 1; tid < sizeof(THREAD_NAMES) / sizeof(THREAD_NAMES[0]); ++tid)
+    {
+        out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << tid << ", \"args\": {\"name\": \"" << THREAD_NAMES[tid] << "\"}},\n";
+    }
+
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        const TraceEvent &event = events[i];
+        const char *name = STAGE_NAMES[event.stage];
+        int tid = STAGE_THREADS[event.stage];
+        double start = event.start / 1e3;
+        double duration = event.duration / 1e3;
+
+        if (isAge(event.stage))
+        {
+            out << "{\"name\": \"" << name << "\", \"ph\": \"C\", \"pid\": 1, \"tid\": " << tid << ", \"ts\": " << start << ", \"args\": {\"us\": " << duration << "}},\n";
+        }
+        else if (isQueue(event.stage))
+        {
+            out << "{\"name\": \"" << name << "\", \"cat\": \"queue\", \"ph\": \"b\", \"id\": " << i << ", \"pid\": 1, \"tid\": " << tid << ", \"ts\": " << start << ", \"args\": {\"samples\": " << event.samples << "}},\n";
+            out << "{\"name\": \"" << name << "\", \"cat\": \"queue\", \"ph\": \"e\", \"id\": " << i << ", \"pid\": 1, \"tid\": " << tid << ", \"ts\": " << start + duration << "},\n";
+        }
+        else
+        {
+            out << "{\"name\": \"" << name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << tid << ", \"ts\": " << start << ", \"dur\": " << duration << ", \"args\": {\"samples\": " << event.samples << "}},\n";
+        }
+    }
+
+    // The format allows a trailing comma, but not every viewer does
+    out << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"RFNoC_TestComponent\"}}\n";
+    out << "]}\n";
+}
+
+// Write one event per line, with the start in seconds on CLOCK_MONOTONIC so
+// that it lines up with "perf record -k CLOCK_MONOTONIC", and the duration or
+// age in microseconds
+void LatencyTrace::writePerf(std::ostream &out, const std::vector<TraceEvent> &events)
+{
+    out << "# time stage microseconds samples\n";
+
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        const TraceEvent &event = events[i];
+
+        out << event.start / 1000000000ULL << "." << std::setw(9) << std::setfill('0') << event.start % 1000000000ULL << std::setfill(' ');
+        out << " " << STAGE_NAMES[event.stage];
+        out << " " << std::fixed << std::setprecision(3) << event.duration / 1e3;
+        out << " " << event.samples << "\n";
+    }
+}
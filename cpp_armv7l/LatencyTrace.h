@@ -0,0 +1,140 @@
+#ifndef LATENCYTRACE_H
+#define LATENCYTRACE_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread.hpp>
+
+// UHD Include(s)
+#include <uhd/types/time_spec.hpp>
+
+// Standard Include(s)
+#include <iosfwd>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * An event copied out of the trace
+ */
+struct TraceEvent
+{
+    uint64_t start;
+    int64_t duration;
+    uint32_t samples;
+    uint32_t stage;
+
+    bool operator<(const TraceEvent &other) const
+    {
+        return this->start < other.start;
+    }
+};
+
+/*
+ * A trace of the time each packet spends in each stage of the RX and TX
+ * paths. Every streaming thread records into one lock-free ring of events,
+ * which holds the most recent ones, and the ring is written out as a Chrome
+ * trace or as perf-friendly text on demand.
+ *
+ * Each event is either a span on the monotonic clock, or an age: how far the
+ * host clock is past the UHD time of a sample, recorded in the end-to-end
+ * mode. The ages take the block's time to follow the host clock, as the TX
+ * lead time does, so a timed burst sent in time has a negative age.
+ *
+ * With tracing disabled, recording is a single relaxed load.
+ */
+class LatencyTrace
+{
+    public:
+        enum Stage
+        {
+            RX_RECV,            // One call to recv
+            RX_FILL,            // Filling one RX buffer, from its first recv
+            RX_QUEUE,           // An RX buffer waiting for the push thread
+            RX_PUSH,            // Pushing one RX buffer out of the ports
+            RX_RECV_AGE,        // The age of the last sample recv returned
+            RX_PUSH_AGE,        // The age of an RX buffer's last sample once pushed
+            TX_READ,            // Reading and converting one input block
+            TX_QUEUE,           // A TX buffer waiting for the send thread
+            TX_SEND,            // One call to send
+            TX_BURST_AGE,       // The age of a burst's time as it's sent, negative if early
+            NUM_STAGES
+        };
+
+        LatencyTrace();
+
+    // Public Method(s)
+    public:
+        // Methods for the streaming threads
+        bool enabled() const
+        {
+            return this->active.load(boost::memory_order_relaxed);
+        }
+
+        bool endToEnd() const
+        {
+            return this->ages.load(boost::memory_order_relaxed);
+        }
+
+        void record(Stage stage, uint64_t start, uint64_t end, size_t samples)
+        {
+            if (enabled())
+            {
+                append(stage, start, int64_t(end - start), samples);
+            }
+        }
+
+        void recordAge(Stage stage, uint64_t now, const uhd::time_spec_t &time, size_t samples)
+        {
+            if (endToEnd())
+            {
+                append(stage, now, int64_t((hostTime() - time).get_real_secs() * 1e9), samples);
+            }
+        }
+
+        static uhd::time_spec_t hostTime();
+
+        // Methods for the controlling thread
+        void configure(bool enabled, bool endToEnd, size_t capacity);
+
+        bool exportTrace(const std::string &path, const std::string &format);
+
+        std::string status() const;
+
+    // Private Method(s)
+    private:
+        void append(Stage stage, uint64_t start, int64_t duration, size_t samples);
+
+        void setStatus(const std::string &status);
+
+        void snapshot(std::vector<TraceEvent> &events) const;
+
+        static void writeChrome(std::ostream &out, const std::vector<TraceEvent> &events);
+
+        static void writePerf(std::ostream &out, const std::vector<TraceEvent> &events);
+
+    // Private Member(s)
+    private:
+        // A slot in the ring. The sequence is zero while the slot is written,
+        // and one past the index of its event once written.
+        struct Slot
+        {
+            boost::atomic<uint64_t> sequence;
+            uint64_t start;
+            int64_t duration;
+            uint32_t samples;
+            uint32_t stage;
+        };
+
+        boost::atomic<bool> active;
+        boost::atomic<bool> ages;
+        size_t capacity;
+        boost::atomic<uint64_t> head;
+        boost::scoped_array<Slot> slots;
+        std::string statusText;
+        mutable boost::mutex statusLock;
+        boost::atomic<int> writers;
+};
+
+#endif
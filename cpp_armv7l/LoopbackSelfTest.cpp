@@ -0,0 +1,384 @@
+// Class Include
+#include "LoopbackSelfTest.h"
+
+// Standard Include(s)
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+const uint64_t LoopbackSelfTest::DRAIN_TIMEOUT_NS;
+const size_t LoopbackSelfTest::MARKER_COUNT;
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+LoopbackSelfTest::LoopbackSelfTest(SampleBufferPool &pool) :
+    accounted(0),
+    bufferSamples(0),
+    dropped(0),
+    duration(0),
+    expected(0),
+    firstReceivedAt(0),
+    inCheck(false),
+    inNext(false),
+    lastReceivedAt(0),
+    markerHead(0),
+    markerTail(0),
+    pattern(NULL),
+    pool(pool),
+    rate(0),
+    received(0),
+    reordered(0),
+    samplesPerSend(0),
+    sent(0),
+    sentDoneAt(0),
+    skipped(0),
+    startedAt(0),
+    state(IDLE),
+    synchronized(false)
+{
+}
+
+// The streaming threads have stopped by now, so the pattern can be returned
+LoopbackSelfTest::~LoopbackSelfTest()
+{
+    this->pool.release(this->pattern);
+}
+
+/*
+ * Public Method(s)
+ */
+
+// Abandon a test in progress. The TX thread ends its burst on its next turn.
+void LoopbackSelfTest::abort()
+{
+    int state = this->state.load();
+
+    while ((state == SENDING or state == DRAINING) and not this->state.compare_exchange_weak(state, ABORTED))
+    {
+    }
+}
+
+// Fill in the results of the current or last test
+void LoopbackSelfTest::report(selfTestResults_struct &results)
+{
+    finishIfDrained();
+
+    uint64_t now = monotonicNanoseconds();
+    uint64_t sentDoneAt = this->sentDoneAt.load();
+    uint64_t firstReceivedAt = this->firstReceivedAt.load();
+    uint64_t lastReceivedAt = this->lastReceivedAt.load();
+    uint64_t received = this->received.load();
+
+    if (this->startedAt != 0)
+    {
+        results.duration = (((sentDoneAt != 0) ? sentDoneAt : now) - this->startedAt) / 1e9;
+    }
+
+    results.throughput = (lastReceivedAt > firstReceivedAt) ? received / ((lastReceivedAt - firstReceivedAt) / 1e9) / 1e6 : 0;
+    results.samplesSent = this->sent.load();
+    results.samplesReceived = received;
+    results.droppedSamples = this->dropped.load();
+    results.reorderedSamples = this->reordered.load();
+
+    std::vector<uint32_t> counts;
+
+    this->roundTrip.snapshot(counts);
+
+    results.roundTripP50 = LatencyHistogram::percentile(counts, 0.50);
+    results.roundTripP99 = LatencyHistogram::percentile(counts, 0.99);
+}
+
+// Start a new test in place of any in progress. The pattern is sent for the
+// given duration in seconds, paced to the rate unless it's zero, in sends of
+// the given number of samples.
+void LoopbackSelfTest::start(double duration, double rate, size_t samplesPerSend)
+{
+    abort();
+
+    // Make sure neither streaming thread is still in the last test before
+    // resetting it
+    while (this->inCheck.load() or this->inNext.load())
+    {
+        boost::this_thread::yield();
+    }
+
+    this->accounted = 0;
+    this->dropped = 0;
+    this->duration = uint64_t(std::max(duration, 0.0) * 1e9);
+    this->expected = 0;
+    this->firstReceivedAt = 0;
+    this->lastReceivedAt = 0;
+    this->markerHead = 0;
+    this->markerTail = 0;
+    this->rate = rate;
+    this->received = 0;
+    this->reordered = 0;
+    this->roundTrip.clear();
+    this->samplesPerSend = std::max(samplesPerSend, size_t(1));
+    this->sent = 0;
+    this->sentDoneAt = 0;
+    this->skipped = 0;
+    this->synchronized = false;
+    this->startedAt = monotonicNanoseconds();
+
+    this->state = SENDING;
+}
+
+// How long the TX thread should wait before its next send, in seconds, to
+// keep to the rate
+double LoopbackSelfTest::delay() const
+{
+    if (this->rate <= 0)
+    {
+        return 0;
+    }
+
+    double due = this->startedAt + this->sent.load(boost::memory_order_relaxed) / this->rate * 1e9;
+
+    return (due - monotonicNanoseconds()) / 1e9;
+}
+
+// Take the next run of the pattern for the TX thread to send. Once the
+// duration has passed, the run is empty and ends the burst. Returns false if
+// no test is sending.
+bool LoopbackSelfTest::next(const std::complex<short> *&samples, size_t &count, bool &startOfBurst, bool &endOfBurst)
+{
+    this->inNext = true;
+
+    if (this->state.load() != SENDING)
+    {
+        this->inNext = false;
+        return false;
+    }
+
+    // Only the TX thread touches the pattern buffer
+    if (this->bufferSamples < this->samplesPerSend)
+    {
+        this->pool.release(this->pattern);
+        this->pattern = this->pool.acquire<std::complex<short> >(this->samplesPerSend);
+        this->bufferSamples = this->samplesPerSend;
+    }
+
+    uint64_t now = monotonicNanoseconds();
+    uint64_t first = this->sent.load(boost::memory_order_relaxed);
+
+    samples = this->pattern;
+    startOfBurst = (first == 0);
+
+    if (now - this->startedAt >= this->duration)
+    {
+        count = 0;
+        endOfBurst = true;
+
+        this->sentDoneAt = now;
+
+        int state = SENDING;
+        this->state.compare_exchange_strong(state, DRAINING);
+
+        this->inNext = false;
+        return true;
+    }
+
+    count = this->samplesPerSend;
+    endOfBurst = false;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t number = uint32_t(first + i);
+
+        this->pattern[i] = std::complex<short>(short(number & 0xffff), short(number >> 16));
+    }
+
+    // Mark the first sample of the send, unless the RX thread is too far
+    // behind on the marks
+    uint64_t head = this->markerHead.load(boost::memory_order_relaxed);
+
+    if (head - this->markerTail.load(boost::memory_order_acquire) < MARKER_COUNT)
+    {
+        this->markers[head % MARKER_COUNT].sample = first;
+        this->markers[head % MARKER_COUNT].sentAt = now;
+
+        this->markerHead.store(head + 1, boost::memory_order_release);
+    }
+
+    this->sent.store(first + count, boost::memory_order_release);
+
+    this->inNext = false;
+    return true;
+}
+
+// Check a run of received samples against the pattern. A sample ahead of
+// the one expected means those in between were dropped, and one behind it
+// arrived late, so it's counted as reordered rather than dropped.
+void LoopbackSelfTest::check(const std::complex<short> *samples, size_t count, uint64_t receivedAt)
+{
+    this->inCheck = true;
+
+    int state = this->state.load();
+
+    if (state != SENDING and state != DRAINING)
+    {
+        this->inCheck = false;
+        return;
+    }
+
+    uint64_t sent = this->sent.load(boost::memory_order_acquire);
+    uint64_t checked = 0;
+    uint64_t dropped = 0;
+    uint64_t recovered = 0;
+    uint64_t reordered = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t number = uint32_t(uint16_t(samples[i].real())) | (uint32_t(uint16_t(samples[i].imag())) << 16);
+
+        // Skip whatever arrives ahead of the pattern
+        if (not this->synchronized)
+        {
+            if (number >= sent)
+            {
+                continue;
+            }
+
+            this->synchronized = true;
+            this->expected = number;
+
+            dropped += number;
+            this->skipped += number;
+        }
+
+        int32_t offset = int32_t(number - uint32_t(this->expected));
+
+        if (offset >= 0)
+        {
+            dropped += offset;
+            this->expected += uint64_t(offset) + 1;
+            this->skipped += offset;
+        }
+        else
+        {
+            ++reordered;
+
+            // A late sample was counted as dropped when it was skipped over,
+            // unless it's a duplicate of one which arrived already
+            if (this->skipped > 0)
+            {
+                ++recovered;
+                --this->skipped;
+            }
+        }
+
+        ++checked;
+    }
+
+    if (checked > 0)
+    {
+        // Add before taking off, so the count never dips below zero
+        this->dropped.fetch_add(dropped, boost::memory_order_relaxed);
+        this->dropped.fetch_sub(recovered, boost::memory_order_relaxed);
+        this->reordered.fetch_add(reordered, boost::memory_order_relaxed);
+        this->received.fetch_add(checked, boost::memory_order_relaxed);
+        this->accounted.store(this->expected);
+
+        uint64_t first = 0;
+        this->firstReceivedAt.compare_exchange_strong(first, receivedAt);
+        this->lastReceivedAt = receivedAt;
+
+        // Every marked sample up to here has made the round trip. One which
+        // was dropped is timed by the sample after it.
+        uint64_t tail = this->markerTail.load(boost::memory_order_relaxed);
+        uint64_t head = this->markerHead.load(boost::memory_order_acquire);
+
+        while (tail != head and this->markers[tail % MARKER_COUNT].sample < this->expected)
+        {
+            this->roundTrip.record(receivedAt - this->markers[tail % MARKER_COUNT].sentAt);
+            ++tail;
+        }
+
+        this->markerTail.store(tail, boost::memory_order_release);
+    }
+
+    // Complete as soon as the whole pattern is accounted for
+    if (state == DRAINING and this->expected >= sent)
+    {
+        this->state.compare_exchange_strong(state, COMPLETE);
+    }
+
+    this->inCheck = false;
+}
+
+// Describe the current or last test
+std::string LoopbackSelfTest::status()
+{
+    finishIfDrained();
+
+    std::ostringstream status;
+
+    switch (this->state.load())
+    {
+        case IDLE:
+            return "idle";
+
+        case SENDING:
+            status << "sending, " << this->sent.load() << " samples sent";
+            return status.str();
+
+        case DRAINING:
+            return "draining";
+
+        case ABORTED:
+            return "aborted";
+
+        default:
+            break;
+    }
+
+    selfTestResults_struct results;
+
+    report(results);
+
+    status << "complete: " << results.throughput << " Msps, ";
+    status << results.droppedSamples << " dropped, " << results.reorderedSamples << " reordered, ";
+    status << "round trip " << results.roundTripP50 << " us p50, " << results.roundTripP99 << " us p99";
+
+    return status.str();
+}
+
+/*
+ * Private Method(s)
+ */
+
+// Complete a draining test once no samples have arrived for the drain
+// timeout, counting any still missing from the end of the pattern as dropped.
+// Returns true if the test has completed.
+bool LoopbackSelfTest::finishIfDrained()
+{
+    int state = this->state.load();
+
+    if (state != DRAINING)
+    {
+        return (state == COMPLETE);
+    }
+
+    uint64_t lastActivity = std::max(this->lastReceivedAt.load(), this->sentDoneAt.load());
+
+    if (monotonicNanoseconds() - lastActivity < DRAIN_TIMEOUT_NS)
+    {
+        return false;
+    }
+
+    if (this->state.compare_exchange_strong(state, COMPLETE))
+    {
+        uint64_t sent = this->sent.load();
+        uint64_t accounted = this->accounted.load();
+
+        if (sent > accounted)
+        {
+            this->dropped.fetch_add(sent - accounted);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,134 @@
+#ifndef LOOPBACKSELFTEST_H
+#define LOOPBACKSELFTEST_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+#include "SampleBufferPool.h"
+
+// Standard Include(s)
+#include <complex>
+#include <stdint.h>
+#include <string>
+
+/*
+ * A self test of the RF-NoC block and the host link, for when the component
+ * has both a TX and an RX streamer and the block passes its input straight
+ * through. The TX thread sends a sequence-numbered sc16 pattern in one burst,
+ * and the RX thread checks each received sample against the next number
+ * expected, counting samples which never arrive as dropped and any which
+ * arrive after later ones as reordered. A sample skipped over is counted as
+ * dropped until it turns up late, but only as many late samples as were
+ * skipped are taken back off, so a duplicate can't take the count below zero.
+ *
+ * Each sample carries the low 16 bits of its number in I and the high 16 bits
+ * in Q. Received samples are skipped until one which has been sent arrives,
+ * so whatever the block held beforehand isn't counted. The round-trip latency
+ * is measured from the first sample of every send, through a lock-free queue
+ * of send times between the two threads.
+ *
+ * The test sends for its duration, then waits for the rest of the pattern to
+ * come back. It completes once every sample sent is accounted for, or once
+ * none have arrived for the drain timeout, at which point any missing from
+ * the end are counted as dropped.
+ */
+class LoopbackSelfTest
+{
+    public:
+        LoopbackSelfTest(SampleBufferPool &pool);
+
+        ~LoopbackSelfTest();
+
+    // Public Method(s)
+    public:
+        // Methods for the controlling thread
+        void abort();
+
+        void report(selfTestResults_struct &results);
+
+        void start(double duration, double rate, size_t samplesPerSend);
+
+        // Methods for the TX thread
+        double delay() const;
+
+        bool next(const std::complex<short> *&samples, size_t &count, bool &startOfBurst, bool &endOfBurst);
+
+        bool sending() const
+        {
+            return (this->state.load(boost::memory_order_relaxed) == SENDING);
+        }
+
+        // Methods for the RX thread
+        void check(const std::complex<short> *samples, size_t count, uint64_t receivedAt);
+
+        bool checking()
+        {
+            int state = this->state.load(boost::memory_order_relaxed);
+
+            return (state == SENDING or (state == DRAINING and not finishIfDrained()));
+        }
+
+        // Bookkeeping
+        std::string status();
+
+    // Private Method(s)
+    private:
+        bool finishIfDrained();
+
+        // Not copyable
+        LoopbackSelfTest(const LoopbackSelfTest &);
+
+        LoopbackSelfTest &operator=(const LoopbackSelfTest &);
+
+    // Private Member(s)
+    private:
+        static const uint64_t DRAIN_TIMEOUT_NS = 500000000ULL;
+        static const size_t MARKER_COUNT = 1024;
+
+        enum State
+        {
+            IDLE,
+            SENDING,
+            DRAINING,
+            COMPLETE,
+            ABORTED
+        };
+
+        // The send time of a numbered sample, for the round-trip latency
+        struct Marker
+        {
+            uint64_t sample;
+            uint64_t sentAt;
+        };
+
+        boost::atomic<uint64_t> accounted;
+        size_t bufferSamples;
+        boost::atomic<uint64_t> dropped;
+        uint64_t duration;
+        uint64_t expected;
+        boost::atomic<uint64_t> firstReceivedAt;
+        boost::atomic<bool> inCheck;
+        boost::atomic<bool> inNext;
+        boost::atomic<uint64_t> lastReceivedAt;
+        boost::atomic<uint64_t> markerHead;
+        Marker markers[MARKER_COUNT];
+        boost::atomic<uint64_t> markerTail;
+        std::complex<short> *pattern;
+        SampleBufferPool &pool;
+        double rate;
+        boost::atomic<uint64_t> received;
+        boost::atomic<uint64_t> reordered;
+        LatencyHistogram roundTrip;
+        size_t samplesPerSend;
+        boost::atomic<uint64_t> sent;
+        boost::atomic<uint64_t> sentDoneAt;
+        uint64_t skipped;
+        uint64_t startedAt;
+        boost::atomic<int> state;
+        bool synchronized;
+};
+
+#endif
@@ -0,0 +1,196 @@
+// Class Include
+#include "PerformanceCounters.h"
+
+/*
+ * LatencyHistogram
+ */
+
+LatencyHistogram::LatencyHistogram()
+{
+    clear();
+}
+
+// Reset every bucket to zero
+void LatencyHistogram::clear()
+{
+    for (size_t i = 0; i < NUM_BUCKETS; ++i)
+    {
+        this->buckets[i].store(0, boost::memory_order_relaxed);
+    }
+}
+
+// Copy the current bucket counts
+void LatencyHistogram::snapshot(std::vector<uint32_t> &counts) const
+{
+    counts.resize(NUM_BUCKETS);
+
+    for (size_t i = 0; i < NUM_BUCKETS; ++i)
+    {
+        counts[i] = this->buckets[i].load(boost::memory_order_relaxed);
+    }
+}
+
+// Find the duration, in microseconds, below which the given fraction of the
+// counted durations fall
+double LatencyHistogram::percentile(const std::vector<uint32_t> &counts, double fraction)
+{
+    uint64_t total = 0;
+
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        total += counts[i];
+    }
+
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    uint64_t target = fraction * total;
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        seen += counts[i];
+
+        if (seen > target)
+        {
+            return bucketUpperBound(i) / 1e3;
+        }
+    }
+
+    return bucketUpperBound(counts.size() - 1) / 1e3;
+}
+
+// Values below four get a bucket each, after which each power of two is split
+// into four buckets using the two bits below the most significant bit
+size_t LatencyHistogram::bucketIndex(uint64_t nanoseconds)
+{
+    if (nanoseconds < 4)
+    {
+        return nanoseconds;
+    }
+
+    size_t msb = 63 - __builtin_clzll(nanoseconds);
+    size_t index = 4 * (msb - 1) + ((nanoseconds >> (msb - 2)) & 3);
+
+    return std::min(index, NUM_BUCKETS - 1);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index)
+{
+    if (index < 4)
+    {
+        return index + 1;
+    }
+
+    size_t msb = index / 4 + 1;
+    size_t sub = index % 4;
+
+    return uint64_t(5 + sub) << (msb - 2);
+}
+
+/*
+ * PerformanceCounters
+ */
+
+PerformanceCounters::PerformanceCounters() :
+    emptyPackets(0),
+    gaps(0),
+    latePackets(0),
+    overflows(0),
+    pushBlockedNanoseconds(0),
+    restarts(0),
+    samplesIn(0),
+    samplesOut(0),
+    sequenceErrors(0),
+    startNanoseconds(0),
+    stopNanoseconds(0),
+    timeouts(0),
+    underflows(0),
+    lastReportTime(monotonicNanoseconds()),
+    lastSamplesIn(0),
+    lastSamplesOut(0),
+    lastPushLatency(LatencyHistogram::NUM_BUCKETS, 0),
+    lastRecvLatency(LatencyHistogram::NUM_BUCKETS, 0),
+    lastRxWakeLatency(LatencyHistogram::NUM_BUCKETS, 0),
+    lastSendLatency(LatencyHistogram::NUM_BUCKETS, 0),
+    lastTxWakeLatency(LatencyHistogram::NUM_BUCKETS, 0)
+{
+}
+
+// Fill in the performance property. Only this method touches the snapshot
+// state, so the lock here is never contended by the streaming threads.
+void PerformanceCounters::report(performance_struct &performance)
+{
+    boost::mutex::scoped_lock lock(this->reportLock);
+
+    uint64_t now = monotonicNanoseconds();
+    double elapsed = (now - this->lastReportTime) / 1e9;
+
+    uint64_t samplesIn = this->samplesIn.load(boost::memory_order_relaxed);
+    uint64_t samplesOut = this->samplesOut.load(boost::memory_order_relaxed);
+
+    if (elapsed > 0)
+    {
+        performance.inputRate = (samplesIn - this->lastSamplesIn) / elapsed;
+        performance.outputRate = (samplesOut - this->lastSamplesOut) / elapsed;
+    }
+
+    performance.overflows = this->overflows.load(boost::memory_order_relaxed);
+    performance.timeouts = this->timeouts.load(boost::memory_order_relaxed);
+    performance.restarts = this->restarts.load(boost::memory_order_relaxed);
+    performance.emptyPackets = this->emptyPackets.load(boost::memory_order_relaxed);
+    performance.gaps = this->gaps.load(boost::memory_order_relaxed);
+    performance.underflows = this->underflows.load(boost::memory_order_relaxed);
+    performance.latePackets = this->latePackets.load(boost::memory_order_relaxed);
+    performance.sequenceErrors = this->sequenceErrors.load(boost::memory_order_relaxed);
+    performance.pushBlockedTime = this->pushBlockedNanoseconds.load(boost::memory_order_relaxed) / 1e9;
+    performance.stopLatency = this->stopNanoseconds.load(boost::memory_order_relaxed) / 1e9;
+    performance.startLatency = this->startNanoseconds.load(boost::memory_order_relaxed) / 1e9;
+
+    // Report the latencies over this interval only
+    std::vector<uint32_t> counts;
+
+    intervalCounts(this->recvLatency, this->lastRecvLatency, counts);
+
+    performance.recvLatencyP50 = LatencyHistogram::percentile(counts, 0.50);
+    performance.recvLatencyP99 = LatencyHistogram::percentile(counts, 0.99);
+
+    intervalCounts(this->sendLatency, this->lastSendLatency, counts);
+
+    performance.sendLatencyP50 = LatencyHistogram::percentile(counts, 0.50);
+    performance.sendLatencyP99 = LatencyHistogram::percentile(counts, 0.99);
+
+    intervalCounts(this->pushLatency, this->lastPushLatency, counts);
+
+    performance.pushLatencyP50 = LatencyHistogram::percentile(counts, 0.50);
+    performance.pushLatencyP99 = LatencyHistogram::percentile(counts, 0.99);
+
+    intervalCounts(this->rxWakeLatency, this->lastRxWakeLatency, counts);
+
+    performance.rxWakeLatencyP50 = LatencyHistogram::percentile(counts, 0.50);
+    performance.rxWakeLatencyP99 = LatencyHistogram::percentile(counts, 0.99);
+
+    intervalCounts(this->txWakeLatency, this->lastTxWakeLatency, counts);
+
+    performance.txWakeLatencyP50 = LatencyHistogram::percentile(counts, 0.50);
+    performance.txWakeLatencyP99 = LatencyHistogram::percentile(counts, 0.99);
+
+    this->lastReportTime = now;
+    this->lastSamplesIn = samplesIn;
+    this->lastSamplesOut = samplesOut;
+}
+
+// Get the histogram counts recorded since the last snapshot, updating the
+// last snapshot
+void PerformanceCounters::intervalCounts(const LatencyHistogram &histogram, std::vector<uint32_t> &last, std::vector<uint32_t> &counts)
+{
+    histogram.snapshot(counts);
+
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        std::swap(counts[i], last[i]);
+        counts[i] = last[i] - counts[i];
+    }
+}
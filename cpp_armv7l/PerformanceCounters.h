@@ -0,0 +1,115 @@
+#ifndef PERFORMANCECOUNTERS_H
+#define PERFORMANCECOUNTERS_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+// Standard Include(s)
+#include <algorithm>
+#include <stdint.h>
+#include <time.h>
+#include <vector>
+
+// Local Include(s)
+#include "struct_props.h"
+
+// Get a monotonic time stamp in nanoseconds
+inline uint64_t monotonicNanoseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return uint64_t(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+/*
+ * A log-linear histogram of durations in nanoseconds. Each power of two is
+ * split into four buckets, giving percentiles to within 25%. Recording is a
+ * single relaxed atomic increment.
+ */
+class LatencyHistogram
+{
+    public:
+        static const size_t NUM_BUCKETS = 160;
+
+        LatencyHistogram();
+
+    // Public Method(s)
+    public:
+        void clear();
+
+        void record(uint64_t nanoseconds)
+        {
+            this->buckets[bucketIndex(nanoseconds)].fetch_add(1, boost::memory_order_relaxed);
+        }
+
+        void snapshot(std::vector<uint32_t> &counts) const;
+
+        static double percentile(const std::vector<uint32_t> &counts, double fraction);
+
+    // Private Method(s)
+    private:
+        static size_t bucketIndex(uint64_t nanoseconds);
+
+        static uint64_t bucketUpperBound(size_t index);
+
+    // Private Member(s)
+    private:
+        boost::atomic<uint32_t> buckets[NUM_BUCKETS];
+};
+
+/*
+ * Counters updated by the streaming threads and read by property queries.
+ * The streaming threads only ever perform relaxed atomic increments, so a
+ * query can never stall them. Rates and percentiles are reported over the
+ * interval since the previous query.
+ */
+class PerformanceCounters
+{
+    public:
+        PerformanceCounters();
+
+    // Public Method(s)
+    public:
+        void report(performance_struct &performance);
+
+    // Public Member(s)
+    public:
+        boost::atomic<uint64_t> emptyPackets;
+        boost::atomic<uint64_t> gaps;
+        boost::atomic<uint64_t> latePackets;
+        boost::atomic<uint64_t> overflows;
+        LatencyHistogram pushLatency;
+        LatencyHistogram recvLatency;
+        boost::atomic<uint64_t> pushBlockedNanoseconds;
+        boost::atomic<uint64_t> restarts;
+        LatencyHistogram rxWakeLatency;
+        boost::atomic<uint64_t> samplesIn;
+        boost::atomic<uint64_t> samplesOut;
+        LatencyHistogram sendLatency;
+        boost::atomic<uint64_t> sequenceErrors;
+        boost::atomic<uint64_t> startNanoseconds;
+        boost::atomic<uint64_t> stopNanoseconds;
+        boost::atomic<uint64_t> timeouts;
+        LatencyHistogram txWakeLatency;
+        boost::atomic<uint64_t> underflows;
+
+    // Private Method(s)
+    private:
+        void intervalCounts(const LatencyHistogram &histogram, std::vector<uint32_t> &last, std::vector<uint32_t> &counts);
+
+    // Private Member(s)
+    private:
+        uint64_t lastReportTime;
+        uint64_t lastSamplesIn;
+        uint64_t lastSamplesOut;
+        std::vector<uint32_t> lastPushLatency;
+        std::vector<uint32_t> lastRecvLatency;
+        std::vector<uint32_t> lastRxWakeLatency;
+        std::vector<uint32_t> lastSendLatency;
+        std::vector<uint32_t> lastTxWakeLatency;
+        boost::mutex reportLock;
+};
+
+#endif
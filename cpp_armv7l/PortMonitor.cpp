@@ -0,0 +1,148 @@
+// Class Include
+#include "PortMonitor.h"
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+
+// Standard Include(s)
+#include <algorithm>
+#include <sstream>
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+PortMonitor::PortMonitor()
+{
+}
+
+/*
+ * Public Method(s)
+ */
+
+// Start accounting for a port, returning the index to refer to it by
+size_t PortMonitor::addPort(const std::string &name)
+{
+    boost::shared_ptr<Port> port(new Port);
+
+    port->name = name;
+
+    restart(*port);
+
+    boost::mutex::scoped_lock lock(this->connectionLock);
+
+    this->ports.push_back(port);
+
+    return this->ports.size() - 1;
+}
+
+// Add a connection to a port, replacing any with the same ID, and restart its
+// counts
+void PortMonitor::connect(size_t port, const std::string &connectionID)
+{
+    boost::mutex::scoped_lock lock(this->connectionLock);
+
+    Port &monitored = *this->ports[port];
+    std::vector<std::string>::iterator it = std::find(monitored.connectionIDs.begin(), monitored.connectionIDs.end(), connectionID);
+
+    if (it == monitored.connectionIDs.end())
+    {
+        monitored.connectionIDs.push_back(connectionID);
+    }
+
+    restart(monitored);
+}
+
+void PortMonitor::disconnect(size_t port, const std::string &connectionID)
+{
+    boost::mutex::scoped_lock lock(this->connectionLock);
+
+    Port &monitored = *this->ports[port];
+    std::vector<std::string>::iterator it = std::find(monitored.connectionIDs.begin(), monitored.connectionIDs.end(), connectionID);
+
+    if (it != monitored.connectionIDs.end())
+    {
+        monitored.connectionIDs.erase(it);
+
+        restart(monitored);
+    }
+}
+
+// The nanoseconds a buffer of the given number of samples per block port
+// lasts, which its pushes to every block port have to fit in together, or
+// zero if the rate isn't known
+uint64_t PortMonitor::pushBudget(size_t samples, double sampleRate)
+{
+    return (sampleRate > 0) ? uint64_t(samples / sampleRate * 1e9) : 0;
+}
+
+// Charge a push to its port
+void PortMonitor::record(size_t port, uint64_t nanoseconds, bool stalled)
+{
+    Port &monitored = *this->ports[port];
+
+    monitored.pushes.fetch_add(1, boost::memory_order_relaxed);
+    monitored.pushNanoseconds.fetch_add(nanoseconds, boost::memory_order_relaxed);
+
+    if (stalled)
+    {
+        monitored.stalls.fetch_add(1, boost::memory_order_relaxed);
+    }
+}
+
+// Describe each connected port on a line of its own, with its connections and
+// the share of its pushes which stalled since they last changed
+std::string PortMonitor::status() const
+{
+    boost::mutex::scoped_lock lock(this->connectionLock);
+
+    std::ostringstream status;
+    uint64_t now = monotonicNanoseconds();
+    bool first = true;
+
+    for (size_t i = 0; i < this->ports.size(); ++i)
+    {
+        const Port &port = *this->ports[i];
+
+        if (port.connectionIDs.empty())
+        {
+            continue;
+        }
+
+        uint64_t pushes = port.pushes.load(boost::memory_order_relaxed);
+        uint64_t stalls = port.stalls.load(boost::memory_order_relaxed);
+        double stalledPercent = (pushes > 0) ? 100.0 * stalls / pushes : 0;
+        double averageMicroseconds = (pushes > 0) ? port.pushNanoseconds.load(boost::memory_order_relaxed) / 1e3 / pushes : 0;
+
+        status << ((first) ? "" : "\n");
+        status << port.name << " (";
+
+        for (size_t j = 0; j < port.connectionIDs.size(); ++j)
+        {
+            status << ((j > 0) ? ", " : "") << port.connectionIDs[j];
+        }
+
+        status << "): ";
+        status << "connections changed " << (now - port.since.load(boost::memory_order_relaxed)) / 1e9 << " s ago, ";
+        status << pushes << " pushes averaging " << averageMicroseconds << " us, ";
+        status << stalls << " stalled (" << stalledPercent << "%)";
+
+        first = false;
+    }
+
+    return status.str();
+}
+
+/*
+ * Private Method(s)
+ */
+
+// Start a port's counts over. A push being recorded at the same time may be
+// counted in part, which only skews the first push's share.
+void PortMonitor::restart(Port &port)
+{
+    port.pushes.store(0, boost::memory_order_relaxed);
+    port.pushNanoseconds.store(0, boost::memory_order_relaxed);
+    port.since.store(monotonicNanoseconds(), boost::memory_order_relaxed);
+    port.stalls.store(0, boost::memory_order_relaxed);
+}
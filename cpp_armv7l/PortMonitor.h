@@ -0,0 +1,72 @@
+#ifndef PORTMONITOR_H
+#define PORTMONITOR_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+// Standard Include(s)
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * Accounting of the pushes to each output port, for finding a port whose
+ * consumers hold up the pushes. BulkIO pushes to every connection of a port in
+ * turn within a single call, so a push can't be timed per connection, and the
+ * accounting is per port instead. A buffer's pushes to a port, one for each
+ * block port, stalled if together they took longer than the buffer lasts. The
+ * counts restart whenever the port's connections change, so a consumer which
+ * stalls the pushes shows up in the share of stalled pushes from when it
+ * connects, and stops once it disconnects.
+ *
+ * Ports are added before any pushes, and are referred to by the index they're
+ * given, so the pushing thread records without a lock.
+ */
+class PortMonitor
+{
+    public:
+        PortMonitor();
+
+    // Public Method(s)
+    public:
+        // Methods for setting up, before any pushes
+        size_t addPort(const std::string &name);
+
+        // Methods for the connection callbacks
+        void connect(size_t port, const std::string &connectionID);
+
+        void disconnect(size_t port, const std::string &connectionID);
+
+        // Methods for the pushing thread
+        static uint64_t pushBudget(size_t samples, double sampleRate);
+
+        void record(size_t port, uint64_t nanoseconds, bool stalled);
+
+        // Bookkeeping
+        std::string status() const;
+
+    // Private Method(s)
+    private:
+        struct Port;
+
+        void restart(Port &port);
+
+    // Private Member(s)
+    private:
+        struct Port
+        {
+            std::vector<std::string> connectionIDs;
+            std::string name;
+            boost::atomic<uint64_t> pushes;
+            boost::atomic<uint64_t> pushNanoseconds;
+            boost::atomic<uint64_t> since;
+            boost::atomic<uint64_t> stalls;
+        };
+
+        mutable boost::mutex connectionLock;
+        std::vector<boost::shared_ptr<Port> > ports;
+};
+
+#endif
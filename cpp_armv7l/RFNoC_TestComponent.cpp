@@ -4,8 +4,38 @@
 // RF-NoC RH Utils
 #include <RFNoC_Utils.h>
 
+// Local Include(s)
+#include "SampleConversion.h"
+
+// REDHAWK Include(s)
+#include <ossie/PropertyMap.h>
+
+// Standard Include(s)
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
 PREPARE_LOGGING(RFNoC_TestComponent_i)
 
+// How long recv may go without any samples before it's counted as a timeout
+static const double RX_RECV_TIMEOUT = 1.0;
+
+// Whether a time stamp is within half a sample of where it was expected. The
+// whole and fractional seconds are compared separately, as their sum in a
+// double can't resolve a sample at high rates. Without a sample period there
+// is nothing to compare against, so any time is taken to follow on.
+static bool timeContinues(const BULKIO::PrecisionUTCTime &actual, const BULKIO::PrecisionUTCTime &expected, double xdelta)
+{
+    if (xdelta <= 0)
+    {
+        return true;
+    }
+
+    double difference = (actual.twsec - expected.twsec) + (actual.tfsec - expected.tfsec);
+
+    return (std::abs(difference) < 0.5 * xdelta);
+}
+
 /*
  * Constructor(s) and/or Destructor
  */
@@ -13,11 +43,55 @@ PREPARE_LOGGING(RFNoC_TestComponent_i)
 // Initialize non-RH members
 RFNoC_TestComponent_i::RFNoC_TestComponent_i(const char *uuid, const char *label) :
     RFNoC_TestComponent_base(uuid, label),
-    receivedSRI(false),
+    floatOutputConnections(0),
+    pollTimeout(0.1),
+    rxAwaitingFirstSample(false),
+    rxBufferSize(0.8 * bulkio::Const::MAX_TRANSFER_BYTES / sizeof(std::complex<short>)),
+    rxCaptureRemaining(0),
+    rxCommandChanged(false),
+    rxDrainBuffer(NULL),
+    rxFloatBuffer(NULL),
+    rxFloatPort(0),
+    rxGapCounted(false),
+    rxNextTimeValid(false),
+    rxPaused(false),
+    rxPauses(0),
+    rxPushedGeneration(0),
+    rxSampleRate(0),
+    rxShortPort(0),
+    rxStartRequested(0),
+    rxStopping(false),
     rxStreamStarted(false),
-    spp(512)
+    rxTransferSamples(0),
+    shortOutputConnections(0),
+    spp(512),
+    txAdaptiveLeadTime(false),
+    txBatchSize(0.8 * bulkio::Const::MAX_TRANSFER_BYTES / sizeof(std::complex<short>)),
+    txBurstStream(NULL),
+    txChannels(1),
+    txConvertBuffer(NULL),
+    txConvertSize(0),
+    txLeadTime(0),
+    txMaxLeadTime(0),
+    txReplayBurstOpen(false),
+    txSelfTestBurstOpen(false),
+    txSendBurstOpen(false),
+    txStopping(false),
+    txWaitOnFloat(false),
+    txZeroBuffer(NULL),
+    txZeroSize(0)
 {
     LOG_TRACE(RFNoC_TestComponent_i, __PRETTY_FUNCTION__);
+
+    // The block's args are cached to apply new ones incrementally
+    this->blockArgs = boost::make_shared<BlockArgs>(boost::bind(&RFNoC_TestComponent_i::getBlockArgs, this), boost::bind(&RFNoC_TestComponent_i::setBlockArgs, this, _1));
+
+    // The self test is shared by the RX and TX threads
+    this->loopbackTest = boost::make_shared<LoopbackSelfTest>(boost::ref(this->samplePool));
+
+    // The push thread accounts for each output port by index
+    this->rxFloatPort = this->portMonitor.addPort(this->dataFloat_out->getName());
+    this->rxShortPort = this->portMonitor.addPort(this->dataShort_out->getName());
 }
 
 // Clean up the RF-NoC stream and threads
@@ -25,19 +99,43 @@ RFNoC_TestComponent_i::~RFNoC_TestComponent_i()
 {
     LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
 
-    // Stop streaming
-    stopRxStream();
+    // Wake the threads, then release them if necessary
+    cancelRxThreads();
+    cancelTxThreads();
 
-    // Release the threads if necessary
     if (this->rxThread)
     {
         this->rxThread->stop();
     }
 
+    // Stop streaming
+    stopRxStream();
+
+    if (this->rxPushThread)
+    {
+        this->rxPushThread->stop();
+    }
+
     if (this->txThread)
     {
         this->txThread->stop();
     }
+
+    if (this->txSendThread)
+    {
+        this->txSendThread->stop();
+    }
+
+    if (this->txAsyncThread)
+    {
+        this->txAsyncThread->stop();
+    }
+
+    // Return the buffers while the pool they came from still exists
+    this->loopbackTest.reset();
+    this->rxRing.reset();
+    this->rxTap.reset();
+    this->txQueue.reset();
 }
 
 /*
@@ -77,16 +175,35 @@ void RFNoC_TestComponent_i::start() throw (CF::Resource::StartError, CORBA::Syst
 
     RFNoC_TestComponent_base::start();
 
+    this->rxStopping = false;
+    this->txStopping = false;
+
     if (this->rxThread)
     {
+        openRxCapture();
+
         startRxStream();
 
+        this->sriPublisher.attach();
+        this->rxPushThread->start();
+        this->rxPolicy.reapply();
         this->rxThread->start();
     }
 
     if (this->txThread)
     {
+        openTxReplay();
+
+        this->txPolicy.reapply();
+
+        if (this->txQueue)
+        {
+            this->txSendBurstOpen = false;
+            this->txSendThread->start();
+        }
+
         this->txThread->start();
+        this->txAsyncThread->start();
     }
 }
 
@@ -95,8 +212,17 @@ void RFNoC_TestComponent_i::stop() throw (CF::Resource::StopError, CORBA::System
 {
     LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
 
+    uint64_t stopStart = monotonicNanoseconds();
+
     RFNoC_TestComponent_base::stop();
 
+    // A self test can't carry on past a stop
+    this->loopbackTest->abort();
+
+    // Wake every streaming thread first, so they all wind down together
+    cancelRxThreads();
+    cancelTxThreads();
+
     if (this->rxThread)
     {
         if (not this->rxThread->stop())
@@ -105,6 +231,18 @@ void RFNoC_TestComponent_i::stop() throw (CF::Resource::StopError, CORBA::System
         }
 
         stopRxStream();
+
+        if (not this->rxPushThread->stop())
+        {
+            LOG_WARN(RFNoC_TestComponent_i, "RX Push Thread had to be killed");
+        }
+
+        this->sriPublisher.detach();
+
+        // The capture finishes in the background
+        this->rxTap->close();
+
+        this->rxRing->clear();
     }
 
     if (this->txThread)
@@ -113,7 +251,27 @@ void RFNoC_TestComponent_i::stop() throw (CF::Resource::StopError, CORBA::System
         {
             LOG_WARN(RFNoC_TestComponent_i, "TX Thread had to be killed");
         }
+
+        if (this->txQueue)
+        {
+            if (not this->txSendThread->stop())
+            {
+                LOG_WARN(RFNoC_TestComponent_i, "TX Send Thread had to be killed");
+            }
+
+            this->txQueue->clear();
+        }
+
+        if (not this->txAsyncThread->stop())
+        {
+            LOG_WARN(RFNoC_TestComponent_i, "TX Async Thread had to be killed");
+        }
+
+        // A cancelled send may have left a burst open on the block
+        endTxBursts();
     }
+
+    this->counters.stopNanoseconds = monotonicNanoseconds() - stopStart;
 }
 
 /*
@@ -141,14 +299,51 @@ void RFNoC_TestComponent_i::setRxStreamer(uhd::rx_streamer::sptr rxStreamer)
         // Set the RX stream
         this->rxStreamer = rxStreamer;
 
-        // Create the RX receive thread
+        // Create the buffers shared by the RX receive and push threads, with
+        // room for every block port the streamer carries
+        size_t channels = std::max(rxStreamer->get_num_channels(), size_t(1));
+
+        this->rxRing.reset(new RxBufferRing(this->samplePool, this->rxBufferCount, this->rxBufferSize, channels));
+        this->rxRing->configure(this->rxBackpressure.policy);
+        this->rxRing->setWatermarks(this->rxBackpressure.lowWatermark, this->rxBackpressure.highWatermark);
+        this->rxRecvBuffers.resize(channels);
+
+        if (channels > 1)
+        {
+            LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "Receiving from " << channels << " block ports");
+        }
+
+        // The extra ports need their own output streams, and the new push
+        // thread pushes the SRI before its first packet
+        this->sriPublisher.setPorts(channels);
+        this->rxPushedGeneration = 0;
+
+        // The push thread converts one buffer at a time for the float port
+        this->rxFloatBuffer = this->samplePool.acquire<float>(2 * this->rxRing->bufferSize());
+
+        // Draining the stream at a stop reads into its own buffer, leaving
+        // any buffers still to be pushed in the ring
+        this->rxDrainBuffer = this->samplePool.acquire<std::complex<short> >(this->rxRing->bufferSize() * channels);
+
+        // The capture tap records from the RX thread
+        this->rxTap = boost::make_shared<CaptureTap>(boost::ref(this->samplePool));
+
+        // Create the RX receive thread and the thread to push its data
         this->rxThread = boost::make_shared<RFNoC_RH::GenericThreadedComponent>(boost::bind(&RFNoC_TestComponent_i::rxServiceFunction, this));
+        this->rxPushThread = boost::make_shared<RFNoC_RH::GenericThreadedComponent>(boost::bind(&RFNoC_TestComponent_i::rxPushServiceFunction, this));
 
-        // If the component is already started, then start the RX receive thread
+        // If the component is already started, then start the RX threads
         if (this->_started)
         {
+            this->rxStopping = false;
+
+            openRxCapture();
+
             startRxStream();
 
+            this->sriPublisher.attach();
+            this->rxPushThread->start();
+            this->rxPolicy.reapply();
             this->rxThread->start();
         }
     }
@@ -161,7 +356,13 @@ void RFNoC_TestComponent_i::setRxStreamer(uhd::rx_streamer::sptr rxStreamer)
             return;
         }
 
-        // Stop and delete the RX stream thread
+        uint64_t stopStart = monotonicNanoseconds();
+
+        this->loopbackTest->abort();
+
+        // Wake, stop and delete the RX stream thread
+        cancelRxThreads();
+
         if (not this->rxThread->stop())
         {
             LOG_WARN(RFNoC_TestComponent_i, "RX Thread had to be killed");
@@ -170,11 +371,34 @@ void RFNoC_TestComponent_i::setRxStreamer(uhd::rx_streamer::sptr rxStreamer)
         // Stop continuous streaming
         stopRxStream();
 
+        // Stop and delete the RX push thread
+        if (not this->rxPushThread->stop())
+        {
+            LOG_WARN(RFNoC_TestComponent_i, "RX Push Thread had to be killed");
+        }
+
+        this->sriPublisher.detach();
+
         // Release the RX stream pointer
         LOG_DEBUG(RFNoC_TestComponent_i, "Resetting RX stream");
         this->rxStreamer.reset();
 
         this->rxThread.reset();
+        this->rxPushThread.reset();
+        this->rxRing.reset();
+
+        this->samplePool.release(this->rxDrainBuffer);
+        this->rxDrainBuffer = NULL;
+
+        this->samplePool.release(this->rxFloatBuffer);
+        this->rxFloatBuffer = NULL;
+
+        this->rxTap->close();
+
+        this->counters.stopNanoseconds = monotonicNanoseconds() - stopStart;
+
+        // Wait for the capture to finish writing
+        this->rxTap.reset();
     }
 }
 
@@ -199,13 +423,58 @@ void RFNoC_TestComponent_i::setTxStreamer(uhd::tx_streamer::sptr txStreamer)
         // Set the TX stream
         this->txStreamer = txStreamer;
 
-        // Create the TX transmit thread
+        // Every port the streamer carries is sent together, so the ports a
+        // run isn't meant for are sent zeros alongside it
+        this->txChannels = std::max(txStreamer->get_num_channels(), size_t(1));
+        this->txSendBuffers.resize(this->txChannels);
+
+        if (this->txChannels > 1)
+        {
+            LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "Sending to " << this->txChannels << " block ports");
+
+            this->txZeroSize = std::max(this->spp, size_t(1)) * 16;
+            this->txZeroBuffer = this->samplePool.acquire<std::complex<short> >(this->txZeroSize);
+
+            std::fill(this->txZeroBuffer, this->txZeroBuffer + this->txZeroSize, std::complex<short>());
+        }
+
+        // Create the queue between the TX transmit and send threads, if
+        // enabled, with a buffer per packet. The input ports already queue
+        // packets ahead of the TX thread, so sending directly is the default.
+        if (this->txQueueDepth > 0)
+        {
+            this->txQueue.reset(new TxBufferRing(this->samplePool, this->txQueueDepth, this->spp));
+
+            if (not this->txQueue->configure(this->txQueuePolicy))
+            {
+                LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Invalid TX queue policy " << this->txQueuePolicy << ", using block");
+            }
+        }
+
+        // Create the TX transmit thread, the thread which sends the queued
+        // samples, and the thread which monitors the asynchronous messages
+        // from the block
         this->txThread = boost::make_shared<RFNoC_RH::GenericThreadedComponent>(boost::bind(&RFNoC_TestComponent_i::txServiceFunction, this));
+        this->txSendThread = boost::make_shared<RFNoC_RH::GenericThreadedComponent>(boost::bind(&RFNoC_TestComponent_i::txSendServiceFunction, this));
+        this->txAsyncThread = boost::make_shared<RFNoC_RH::GenericThreadedComponent>(boost::bind(&RFNoC_TestComponent_i::txAsyncServiceFunction, this));
 
-        // If the component is already started, then start the TX transmit thread
+        // If the component is already started, then start the TX threads
         if (this->_started)
         {
+            this->txStopping = false;
+
+            openTxReplay();
+
+            this->txPolicy.reapply();
+
+            if (this->txQueue)
+            {
+                this->txSendBurstOpen = false;
+                this->txSendThread->start();
+            }
+
             this->txThread->start();
+            this->txAsyncThread->start();
         }
     }
     else
@@ -217,16 +486,53 @@ void RFNoC_TestComponent_i::setTxStreamer(uhd::tx_streamer::sptr txStreamer)
             return;
         }
 
-        // Stop and delete the TX stream thread
+        uint64_t stopStart = monotonicNanoseconds();
+
+        this->loopbackTest->abort();
+
+        // Wake, stop and delete the TX threads
+        cancelTxThreads();
+
         if (not this->txThread->stop())
         {
             LOG_WARN(RFNoC_TestComponent_i, "TX Thread had to be killed");
         }
 
+        if (this->txQueue and not this->txSendThread->stop())
+        {
+            LOG_WARN(RFNoC_TestComponent_i, "TX Send Thread had to be killed");
+        }
+
+        if (not this->txAsyncThread->stop())
+        {
+            LOG_WARN(RFNoC_TestComponent_i, "TX Async Thread had to be killed");
+        }
+
+        endTxBursts();
+
         // Release the TX stream pointer
         this->txStreamer.reset();
 
+        this->txAsyncThread.reset();
+        this->txQueue.reset();
+        this->txSendThread.reset();
         this->txThread.reset();
+
+        {
+            boost::mutex::scoped_lock lock(this->txReplayLock);
+
+            this->txReplaySource.reset();
+        }
+
+        this->samplePool.release(this->txConvertBuffer);
+        this->txConvertBuffer = NULL;
+        this->txConvertSize = 0;
+
+        this->samplePool.release(this->txZeroBuffer);
+        this->txZeroBuffer = NULL;
+        this->txZeroSize = 0;
+
+        this->counters.stopNanoseconds = monotonicNanoseconds() - stopStart;
     }
 }
 
@@ -244,267 +550,2007 @@ void RFNoC_TestComponent_i::constructor()
 
     blockDescriptor.blockId = this->blockID;
 
-    // Grab the pointer to the specified block ID
-    this->rfnocBlock = this->persona->getBlock(blockDescriptor);
+    // Grab the pointer to the specified block ID, unless it's to be emulated
+    if (this->blockEmulation != "always")
+    {
+        this->rfnocBlock = this->persona->getBlock(blockDescriptor);
+    }
 
-    // Without this, there is no need to continue
-    if (not this->rfnocBlock)
+    // Without this or an emulation of it, there is no need to continue
+    if (this->rfnocBlock)
     {
-        LOG_FATAL(RFNoC_TestComponent_i, "Unable to retrieve RF-NoC block with ID: " << this->blockID);
-        throw std::exception();
+        LOG_DEBUG(RFNoC_TestComponent_i, "Got the block: " << this->blockID);
+    }
+    else if (this->blockEmulation == "fallback" or this->blockEmulation == "always")
+    {
+        LOG_INFO(RFNoC_TestComponent_i, "Emulating RF-NoC block with ID: " << this->blockID);
+
+        this->emulatedBlock = boost::make_shared<EmulatedBlock>(this->rxBufferSize);
     }
     else
     {
-        LOG_DEBUG(RFNoC_TestComponent_i, "Got the block: " << this->blockID);
+        LOG_FATAL(RFNoC_TestComponent_i, "Unable to retrieve RF-NoC block with ID: " << this->blockID);
+        throw std::exception();
     }
 
-    // Set the args initially
-    setArgs(this->args);
+    // Set the args initially. A rejected batch leaves the block untouched,
+    // so don't claim any of it was applied.
+    if (not setArgs(this->args))
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Unable to set initial arguments, clearing");
+        this->args.clear();
+    }
 
     // Alert the persona of stream descriptors for this component
     RFNoC_RH::StreamDescriptor streamDescriptor;
 
     streamDescriptor.cpuFormat = "sc16";
-    streamDescriptor.otwFormat = "sc16";
+    streamDescriptor.otwFormat = this->otwFormat;
+
+    if (this->otwFormat != "sc16" and this->otwFormat != "sc8")
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Unsupported over-the-wire format " << this->otwFormat << ", using sc16");
+        streamDescriptor.otwFormat = "sc16";
+    }
     streamDescriptor.streamArgs["block_id"] = this->blockID;
     streamDescriptor.streamArgs["block_port"] = blockDescriptor.port;
 
-    // Get the spp from the block
-    this->spp = this->rfnocBlock->get_args().cast<size_t>("spp", 512);
-
-    streamDescriptor.streamArgs["spp"] = boost::lexical_cast<std::string>(this->spp);
+    // Ask for a channel per block port, numbered as UHD expects
+    for (size_t port = 0; port < this->blockPorts and this->blockPorts > 1; ++port)
+    {
+        std::string channel = boost::lexical_cast<std::string>(port);
 
-    // Register the property change listener
-    this->addPropertyListener(this->args, this, &RFNoC_TestComponent_i::argsChanged);
+        streamDescriptor.streamArgs["block_id" + channel] = this->blockID;
+        streamDescriptor.streamArgs["block_port" + channel] = channel;
+    }
 
-    // Set the logger for the ports
-    this->dataShort_in->setLogger(this->getLogger());
-    this->dataShort_out->setLogger(this->getLogger());
+    // Get the spp from the args read back from the block, which are read
+    // again if a failed batch left them unknown
+    this->spp = this->blockArgs->applied().cast<size_t>("spp", 512);
 
-    // Add an SRI change listener
-    this->dataShort_in->addStreamListener(this, &RFNoC_TestComponent_i::streamChanged);
+    streamDescriptor.streamArgs["spp"] = boost::lexical_cast<std::string>(this->spp);
 
-    // Add a stream listener
-    this->dataShort_out->setNewConnectListener(this, &RFNoC_TestComponent_i::newConnection);
-    this->dataShort_out->setNewDisconnectListener(this, &RFNoC_TestComponent_i::newDisconnection);
+    // Set up everything which doesn't depend on the block
+    initializeStreaming();
 
-    // Create the receive buffer
-    this->output.resize((0.8 * bulkio::Const::MAX_TRANSFER_BYTES / sizeof(std::complex<short>)));
+    // The persona has no streams for an emulated block, so stream to and
+    // from it directly. Otherwise the persona creates the streamers from the
+    // descriptor and hands them over.
+    if (this->emulatedBlock)
+    {
+        setRxStreamer(this->emulatedBlock->getRxStreamer(this->spp));
+        setTxStreamer(this->emulatedBlock->getTxStreamer(this->spp));
+    }
+    else
+    {
+        this->persona->setRxStreamDescriptor(this->identifier(), streamDescriptor);
+        this->persona->setTxStreamDescriptor(this->identifier(), streamDescriptor);
+    }
 }
 
-// The service function for receiving from the RF-NoC block
+// The service function for receiving from the RF-NoC block. This thread only
+// calls recv, handing each filled buffer off to the RX push thread.
 int RFNoC_TestComponent_i::rxServiceFunction()
 {
-    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+    bool logBuffer = HOT_LOG_SAMPLE(this->rxLogSampler);
+
+    HOT_LOG_TRACE(RFNoC_TestComponent_i, logBuffer, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    // Apply the scheduling for this thread if it's new or has changed
+    if (this->rxPolicy.applyIfPending())
+    {
+        logThreadPolicy("RX", this->rxPolicy);
+    }
 
     // Perform RX, if necessary
     if (this->rxStreamer)
     {
-        // Don't bother doing anything until the SRI has been received
-        if (not this->receivedSRI)
+        // Don't bother doing anything until the SRI has been received, unless
+        // a self test needs the samples
+        if (not this->sriPublisher.published() and not this->loopbackTest->checking())
+        {
+            HOT_LOG_TRACE(RFNoC_TestComponent_i, logBuffer, "RX Thread active but no SRI has been received");
+            this->rxWait.idle(this->pollTimeout);
+            return NORMAL;
+        }
+
+        this->rxWait.resume(this->counters.rxWakeLatency);
+
+        // Apply any new stream command on this buffer boundary. With no
+        // command outstanding, this sleeps until one is configured.
+        if (waitForRxStreamControl())
+        {
+            LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "Applying new RX stream control");
+
+            stopRxStream();
+            startRxStream();
+        }
+
+        if (not this->rxStreamStarted)
+        {
+            return NOOP;
+        }
+
+        if (pauseRxStreamIfCongested())
         {
-            LOG_TRACE(RFNoC_TestComponent_i, "RX Thread active but no SRI has been received");
             return NOOP;
         }
 
-        // Recv from the block
+        // Get a buffer to fill, applying the overflow policy if the push
+        // thread has fallen behind
+        RxBuffer *buffer = this->rxRing->acquireFree();
+
+        // Latch the transfer size for this buffer. Changes take effect on the
+        // next buffer, and never exceed the preallocated buffer size or the
+        // remainder of a finite capture.
+        size_t transferSize = this->rxTransferSamples.load();
+
+        if (this->rxCaptureRemaining > 0)
+        {
+            transferSize = std::min(transferSize, this->rxCaptureRemaining);
+        }
+
+        // Recv from the block. Each buffer is stamped with the time of its
+        // first sample, and is flushed early at any discontinuity so that a
+        // gap never falls inside a pushed packet.
         uhd::rx_metadata_t md;
+        double rate = this->rxSampleRate.load(boost::memory_order_relaxed);
 
         size_t samplesRead = 0;
-        size_t samplesToRead = this->output.size();
+        double recvWaited = 0;
 
-        while (samplesRead < this->output.size())
+        while (buffer->size < transferSize)
         {
-            LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "Calling recv on the rx_stream");
+            size_t samplesToRead = transferSize - buffer->size;
+
+            HOT_LOG_DEBUG(RFNoC_TestComponent_i, logBuffer, this->blockID << ": " << "Calling recv on the rx_stream");
+
+            uint64_t recvStart = monotonicNanoseconds();
+
+            // Wait in short slices, so that a stop is noticed promptly
+            double timeout = this->pollTimeout.load(boost::memory_order_relaxed);
 
-            size_t num_rx_samps = this->rxStreamer->recv(&output.front() + samplesRead, samplesToRead, md, 1.0);
+            // Every port is received at once, each into its own part of the
+            // buffer
+            for (size_t channel = 0; channel < this->rxRecvBuffers.size(); ++channel)
+            {
+                this->rxRecvBuffers[channel] = this->rxRing->channelData(buffer, channel) + buffer->size;
+            }
+
+            size_t num_rx_samps = this->rxStreamer->recv(this->rxRecvBuffers, samplesToRead, md, timeout);
+
+            uint64_t recvEnd = monotonicNanoseconds();
+
+            this->counters.recvLatency.record(recvEnd - recvStart);
+            this->trace.record(LatencyTrace::RX_RECV, recvStart, recvEnd, num_rx_samps);
 
             // Check the meta data for error codes
-            if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT)
+            if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT and this->rxStopping)
             {
-                LOG_ERROR(RFNoC_TestComponent_i, this->blockID << ": " << "Timeout while streaming");
+                flushRxBuffer(buffer, false);
                 return NOOP;
             }
-            else if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_OVERFLOW)
+            else if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT and this->rxAwaitingFirstSample)
             {
-                LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Overflow while streaming");
+                // A timed command hasn't started yet, keep waiting
+                this->rxRing->release(buffer);
+                return NOOP;
             }
-            else if (md.error_code != uhd::rx_metadata_t::ERROR_CODE_NONE)
+            else if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT and recvWaited + timeout < RX_RECV_TIMEOUT)
             {
+                recvWaited += timeout;
+                continue;
+            }
+            else if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT)
+            {
+                LOG_ERROR(RFNoC_TestComponent_i, this->blockID << ": " << "Timeout while streaming");
+                ++this->counters.timeouts;
+                flushRxBuffer(buffer, false);
+                return NOOP;
+            }
+            else if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_LATE_COMMAND or md.error_code == uhd::rx_metadata_t::ERROR_CODE_BROKEN_CHAIN)
+            {
+                // The block has stopped streaming, so it has to be told to
+                // start again
                 LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << md.strerror());
+                ++this->counters.restarts;
+                flushRxBuffer(buffer, false);
                 this->rxStreamStarted = false;
                 startRxStream();
                 return NOOP;
             }
+            else if (md.error_code != uhd::rx_metadata_t::ERROR_CODE_NONE)
+            {
+                // Overflows and bad packets leave the stream running, but the
+                // next samples won't follow on from the last ones
+                if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_OVERFLOW)
+                {
+                    LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Overflow while streaming");
+                    ++this->counters.overflows;
+                }
+                else
+                {
+                    LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << md.strerror());
+                }
+
+                if (not this->rxGapCounted)
+                {
+                    ++this->counters.gaps;
+                    this->rxGapCounted = true;
+                }
+
+                buffer = flushRxBuffer(buffer, true);
+                continue;
+            }
 
-            LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "RX Thread Requested " << samplesToRead << " samples");
-            LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "RX Thread Received " << num_rx_samps << " samples");
-
-            samplesRead += num_rx_samps;
-            samplesToRead -= num_rx_samps;
-        }
+            HOT_LOG_DEBUG(RFNoC_TestComponent_i, logBuffer, this->blockID << ": " << "RX Thread Requested " << samplesToRead << " samples");
+            HOT_LOG_DEBUG(RFNoC_TestComponent_i, logBuffer, this->blockID << ": " << "RX Thread Received " << num_rx_samps << " samples");
 
-        // Get the time stamps from the meta data
-        BULKIO::PrecisionUTCTime rxTime;
+            if (num_rx_samps == 0)
+            {
+                continue;
+            }
 
-        rxTime.twsec = md.time_spec.get_full_secs();
-        rxTime.tfsec = md.time_spec.get_frac_secs();
+            // Check the self test pattern where recv left it
+            if (this->loopbackTest->checking())
+            {
+                this->loopbackTest->check(buffer->data + buffer->size, num_rx_samps, recvEnd);
+            }
 
-        // Write the data to the output stream
-        short *outputBuffer = (short *) this->output.data();
+            // Compare the time of these samples to where the last ones ended
+            if (md.has_time_spec and this->rxNextTimeValid and rate > 0)
+            {
+                double offset = (md.time_spec - this->rxNextTime).get_real_secs() * rate;
 
-        this->dataShort_out->pushPacket(outputBuffer, this->output.size() * 2, rxTime, md.end_of_burst, this->sri.streamID._ptr);
-    }
+                if (std::abs(offset) >= 0.5)
+                {
+                    HOT_LOG_DEBUG(RFNoC_TestComponent_i, logBuffer, this->blockID << ": " << "RX time discontinuity of " << offset << " samples");
 
-    return NORMAL;
-}
+                    if (not this->rxGapCounted)
+                    {
+                        ++this->counters.gaps;
+                    }
 
-// The service function for transmitting to the RF-NoC block
-int RFNoC_TestComponent_i::txServiceFunction()
-{
-    // Perform TX, if necessary
-    if (this->txStreamer)
-    {
-        // Wait on input data
-        bulkio::InShortPort::DataTransferType *packet = this->dataShort_in->getPacket(bulkio::Const::BLOCKING);
+                    // Move the new samples to the start of a fresh buffer
+                    if (buffer->size > 0)
+                    {
+                        RxBuffer *next = this->rxRing->acquireFree();
 
-        if (not packet)
-        {
-            return NOOP;
-        }
+                        for (size_t channel = 0; channel < this->rxRing->channels(); ++channel)
+                        {
+                            const std::complex<short> *samples = this->rxRing->channelData(buffer, channel) + buffer->size;
 
-        uhd::tx_metadata_t md;
-        std::complex<short> *block = (std::complex<short> *) packet->dataBuffer.data();
-        size_t blockSize = packet->dataBuffer.size() / 2;
+                            std::copy(samples, samples + num_rx_samps, this->rxRing->channelData(next, channel));
+                        }
 
-        LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "TX Thread Received " << blockSize << " samples");
+                        flushRxBuffer(buffer, false);
+                        buffer = next;
+                    }
+                }
+            }
 
-        if (blockSize == 0)
-        {
-            LOG_DEBUG(RFNoC_TestComponent_i, "Skipping empty packet");
-            delete packet;
-            return NOOP;
-        }
+            if (buffer->size == 0)
+            {
+                buffer->time = md.time_spec;
+                buffer->fillStart = recvStart;
+            }
 
-        // Get the timestamp to send to the RF-NoC block
-        BULKIO::PrecisionUTCTime time = packet->T;
+            if (this->rxAwaitingFirstSample)
+            {
+                this->rxAwaitingFirstSample = false;
+                this->rxCaptureStart = md.time_spec;
+
+                if (this->rxStartRequested != 0)
+                {
+                    this->counters.startNanoseconds = monotonicNanoseconds() - this->rxStartRequested;
+                    this->rxStartRequested = 0;
+                }
+            }
 
-        md.has_time_spec = true;
-        md.time_spec = uhd::time_spec_t(time.twsec, time.tfsec);
+            buffer->size += num_rx_samps;
+            recvWaited = 0;
+            samplesRead += num_rx_samps;
 
-        size_t samplesSent = 0;
-        size_t samplesToSend = blockSize;
+            this->rxGapCounted = false;
+            this->rxNextTimeValid = md.has_time_spec;
 
-        while (samplesToSend != 0)
-        {
-            // Send the data
-            size_t num_tx_samps = this->txStreamer->send(block + samplesSent, samplesToSend, md, 1);
+            if (rate > 0)
+            {
+                this->rxNextTime = md.time_spec + uhd::time_spec_t(num_rx_samps / rate);
 
-            samplesSent += num_tx_samps;
-            samplesToSend -= num_tx_samps;
+                if (md.has_time_spec)
+                {
+                    this->trace.recordAge(LatencyTrace::RX_RECV_AGE, recvEnd, this->rxNextTime, num_rx_samps);
+                }
+            }
 
-            LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "TX Thread Sent " << num_tx_samps << " samples");
+            // A finite capture may end short of the transfer size
+            if (md.end_of_burst)
+            {
+                break;
+            }
         }
 
-        // On EOS, forward to the RF-NoC block
-        if (packet->EOS)
+        buffer->endOfBurst = md.end_of_burst;
+
+        // Move on to the next capture if this one is complete
+        if (this->rxCaptureRemaining > 0)
         {
-            LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "EOS");
+            this->rxCaptureRemaining -= std::min(samplesRead, this->rxCaptureRemaining);
 
-            // Propagate the EOS to the RF-NoC Block
-            md.end_of_burst = true;
+            if (this->rxCaptureRemaining == 0 or md.end_of_burst)
+            {
+                buffer->endOfBurst = true;
 
-            std::vector<std::complex<short> > empty;
-            this->txStreamer->send(&empty.front(), empty.size(), md);
+                finishRxCapture();
+            }
         }
 
-        delete packet;
-        return NORMAL;
+        // Queue the buffer for the push thread
+        flushRxBuffer(buffer, false);
     }
 
-    return NOOP;
+    return NORMAL;
 }
 
-/*
- * Private Method(s)
- */
-
-// The property change listener for the args property.
-void RFNoC_TestComponent_i::argsChanged(const std::vector<arg_struct> &oldValue, const std::vector<arg_struct> &newValue)
+// The service function for pushing received data out of the BulkIO port. This
+// thread only calls pushPacket, so a slow consumer can't stall the recv calls.
+int RFNoC_TestComponent_i::rxPushServiceFunction()
 {
-    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+    // Wait briefly for a filled buffer so the thread can be stopped promptly
+    RxBuffer *buffer = this->rxRing->acquireFull(this->pollTimeout);
 
-    if (not setArgs(this->args))
+    if (not buffer)
     {
-        LOG_WARN(RFNoC_TestComponent_i, "Unable to set new arguments, reverting");
-        this->args = oldValue;
+        return NOOP;
     }
-}
 
-void RFNoC_TestComponent_i::streamChanged(bulkio::InShortPort::StreamType stream)
-{
-    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+    // The self test pattern has been checked already, and isn't pushed
+    if (this->loopbackTest->checking())
+    {
+        this->rxRing->release(buffer);
+        return NORMAL;
+    }
 
-    std::map<std::string, bool>::iterator it = this->streamMap.find(stream.streamID());
+    // Take the latest output SRI, pushing it first if it has changed
+    const SriSnapshot *snapshot = this->sriPublisher.acquire();
 
-    bool newIncomingConnection = (it == this->streamMap.end());
-    bool removedIncomingConnection = (it != this->streamMap.end() and stream.eos());
+    if (not snapshot)
+    {
+        this->rxRing->release(buffer);
+        return NORMAL;
+    }
 
-    if (newIncomingConnection)
+    if (snapshot->generation != this->rxPushedGeneration)
     {
-        LOG_DEBUG(RFNoC_TestComponent_i, "New incoming connection");
+        for (size_t port = 0; port < snapshot->portSRIs.size(); ++port)
+        {
+            this->dataFloat_out->pushSRI(snapshot->portSRIs[port]);
+            this->dataShort_out->pushSRI(snapshot->portSRIs[port]);
+        }
+
+        LOG_DEBUG(RFNoC_TestComponent_i, "Pushed stream ID to ports");
+
+        this->rxPushedGeneration = snapshot->generation;
+    }
+
+    // Get the time stamps from the buffer
+    BULKIO::PrecisionUTCTime rxTime;
+
+    rxTime.twsec = buffer->time.get_full_secs();
+    rxTime.tfsec = buffer->time.get_frac_secs();
+
+    // Write the data to whichever output ports are connected, only
+    // converting to float if something will receive it. The short port is
+    // written when nothing is connected, as before. Each block port is
+    // pushed as its own stream.
+    bool pushFloat = (this->floatOutputConnections > 0);
+    bool pushShort = (this->shortOutputConnections > 0 or not pushFloat);
+    size_t channels = std::min(this->rxRing->channels(), snapshot->streamIDs.size());
+
+    uint64_t pushStart = monotonicNanoseconds();
+    uint64_t floatNanoseconds = 0;
+    uint64_t shortNanoseconds = 0;
+
+    for (size_t channel = 0; channel < channels; ++channel)
+    {
+        short *outputBuffer = (short *) this->rxRing->channelData(buffer, channel);
+        const std::string &streamID = snapshot->streamIDs[channel];
+
+        if (pushShort)
+        {
+            uint64_t shortStart = monotonicNanoseconds();
+
+            this->dataShort_out->pushPacket(outputBuffer, buffer->size * 2, rxTime, buffer->endOfBurst, streamID);
+
+            shortNanoseconds += monotonicNanoseconds() - shortStart;
+        }
+
+        if (pushFloat)
+        {
+            convertShortToFloat(outputBuffer, this->rxFloatBuffer, buffer->size * 2, this->floatScale);
+
+            uint64_t floatStart = monotonicNanoseconds();
+
+            this->dataFloat_out->pushPacket(this->rxFloatBuffer, buffer->size * 2, rxTime, buffer->endOfBurst, streamID);
+
+            floatNanoseconds += monotonicNanoseconds() - floatStart;
+        }
+    }
+
+    uint64_t pushEnd = monotonicNanoseconds();
+    uint64_t pushDuration = pushEnd - pushStart;
+
+    // Charge each port's pushes to it. Every block port's samples in a buffer
+    // cover the same stretch of time, so the pushes for all of the ports
+    // together have to fit in one buffer's duration to keep up. They stalled
+    // if they took longer, or if the rate isn't known, if the RX queue is
+    // congested.
+    double rate = this->rxSampleRate.load(boost::memory_order_relaxed);
+    uint64_t budget = PortMonitor::pushBudget(buffer->size, rate);
+    bool congested = (rate <= 0 and this->rxRing->congested());
+
+    if (pushShort)
+    {
+        this->portMonitor.record(this->rxShortPort, shortNanoseconds, (budget > 0) ? shortNanoseconds > budget : congested);
+    }
+
+    if (pushFloat)
+    {
+        this->portMonitor.record(this->rxFloatPort, floatNanoseconds, (budget > 0) ? floatNanoseconds > budget : congested);
+    }
+
+    this->counters.pushLatency.record(pushDuration);
+    this->counters.pushBlockedNanoseconds.fetch_add(pushDuration, boost::memory_order_relaxed);
+    this->counters.samplesOut.fetch_add(buffer->size * channels, boost::memory_order_relaxed);
+
+    // Trace the wait in the ring, the push, and how old the last sample was
+    // by the time it went out
+    if (buffer->queuedAt != 0)
+    {
+        this->trace.record(LatencyTrace::RX_QUEUE, buffer->queuedAt, pushStart, buffer->size);
+        this->trace.record(LatencyTrace::RX_PUSH, pushStart, pushEnd, buffer->size);
+
+        if (rate > 0)
+        {
+            this->trace.recordAge(LatencyTrace::RX_PUSH_AGE, pushEnd, buffer->time + uhd::time_spec_t(buffer->size / rate), buffer->size);
+        }
+    }
+
+    // Return the buffer to be refilled
+    this->rxRing->release(buffer);
+
+    return NORMAL;
+}
+
+// The service function for the asynchronous messages the RF-NoC block sends
+// back while transmitting. Underflows and late packets are counted, and a late
+// packet widens the TX lead time if that is enabled.
+int RFNoC_TestComponent_i::txAsyncServiceFunction()
+{
+    uhd::async_metadata_t md;
+
+    if (not this->txStreamer->recv_async_msg(md, this->pollTimeout))
+    {
+        return NORMAL;
+    }
+
+    switch (md.event_code)
+    {
+        case uhd::async_metadata_t::EVENT_CODE_BURST_ACK:
+            break;
+
+        case uhd::async_metadata_t::EVENT_CODE_UNDERFLOW:
+        case uhd::async_metadata_t::EVENT_CODE_UNDERFLOW_IN_PACKET:
+            ++this->counters.underflows;
+            break;
+
+        case uhd::async_metadata_t::EVENT_CODE_SEQ_ERROR:
+        case uhd::async_metadata_t::EVENT_CODE_SEQ_ERROR_IN_BURST:
+            ++this->counters.sequenceErrors;
+            break;
+
+        case uhd::async_metadata_t::EVENT_CODE_TIME_ERROR:
+        {
+            ++this->counters.latePackets;
+
+            // Double the lead time, starting from a millisecond
+            double leadTime = this->txLeadTime.load();
+            double maxLeadTime = this->txMaxLeadTime.load();
+
+            if (this->txAdaptiveLeadTime.load() and leadTime < maxLeadTime)
+            {
+                leadTime = std::min(std::max(2 * leadTime, 0.001), maxLeadTime);
+
+                this->txLeadTime.store(leadTime);
+
+                LOG_INFO(RFNoC_TestComponent_i, this->blockID << ": " << "Late TX packet, widened the lead time to " << leadTime << " s");
+            }
+
+            break;
+        }
+
+        default:
+            LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "Unexpected TX async message with event code " << md.event_code);
+            break;
+    }
+
+    return NORMAL;
+}
+
+// The service function for sending the buffers queued by the TX thread to the
+// RF-NoC block when the TX queue is enabled. A buffer dropped from the queue
+// may have held the start or end of a burst, so either is made up here.
+int RFNoC_TestComponent_i::txSendServiceFunction()
+{
+    // This thread calls send, so it takes the TX scheduling
+    if (this->txPolicy.applyIfPending())
+    {
+        logThreadPolicy("TX", this->txPolicy);
+    }
+
+    TxBuffer *buffer = this->txQueue->acquireFull();
+
+    if (not buffer)
+    {
+        this->txSendWait.idle(this->pollTimeout);
+        return NORMAL;
+    }
+
+    this->txSendWait.resume(this->counters.txWakeLatency);
+
+    if (buffer->queuedAt != 0)
+    {
+        this->trace.record(LatencyTrace::TX_QUEUE, buffer->queuedAt, monotonicNanoseconds(), buffer->size);
+    }
+
+    if (buffer->startOfBurst and this->txSendBurstOpen)
+    {
+        std::complex<short> empty;
+
+        sendSamples(&empty, 0, false, NULL, true, false);
+    }
+
+    // A burst missing its start is sent as soon as possible
+    bool startOfBurst = (buffer->startOfBurst or not this->txSendBurstOpen);
+
+    sendSamples(buffer->data, buffer->size, startOfBurst, (buffer->startOfBurst) ? &buffer->time : NULL, buffer->endOfBurst, false, buffer->port);
+
+    this->txSendBurstOpen = not buffer->endOfBurst;
+
+    return NORMAL;
+}
+
+// The service function for transmitting to the RF-NoC block
+int RFNoC_TestComponent_i::txServiceFunction()
+{
+    // Apply the scheduling for this thread if it's new or has changed. With
+    // the TX queue enabled, the send thread takes it instead.
+    if (not this->txQueue and this->txPolicy.applyIfPending())
+    {
+        logThreadPolicy("TX", this->txPolicy);
+    }
+
+    // Perform TX, if necessary
+    if (this->txStreamer)
+    {
+        // A self test takes the place of the input ports and any replay
+        // until it's done sending
+        if (this->loopbackTest->sending())
+        {
+            serviceSelfTest();
+            return NORMAL;
+        }
+
+        // A self test aborted part way through leaves its burst open
+        if (this->txSelfTestBurstOpen)
+        {
+            endTxSelfTestBurst();
+        }
+
+        // A replay takes the place of the input ports until it completes
+        boost::shared_ptr<TxReplaySource> replay;
+
+        {
+            boost::mutex::scoped_lock lock(this->txReplayLock);
+
+            replay = this->txReplaySource;
+        }
+
+        if (replay and not replay->finished())
+        {
+            serviceTxReplay(*replay);
+            return NORMAL;
+        }
+
+        // A replay replaced or disabled part way through leaves its burst
+        // open
+        if (this->txReplayBurstOpen)
+        {
+            endTxReplayBurst();
+        }
+
+        // Give each input stream a turn in round-robin order, stopping at
+        // the first one with something to do
+        TxStreamState *state = this->txScheduler.next();
+
+        for (size_t turns = 1; state; ++turns)
+        {
+            if (serviceTxStream(state))
+            {
+                this->txWait.resume(this->counters.txWakeLatency);
+                return NORMAL;
+            }
+
+            if (turns >= this->txScheduler.size())
+            {
+                break;
+            }
+
+            state = this->txScheduler.next();
+        }
+
+        // Every stream is idle. Unless the wait is event driven, poll both
+        // ports and then wait according to the strategy.
+        if (this->txWait.mode() != WaitStrategy::EVENT)
+        {
+            bulkio::InFloatStream floatStream = this->dataFloat_in->getCurrentStream(bulkio::Const::NON_BLOCKING);
+            bulkio::InShortStream shortStream = this->dataShort_in->getCurrentStream(bulkio::Const::NON_BLOCKING);
+
+            if (floatStream)
+            {
+                this->txScheduler.add(floatStream);
+            }
+
+            if (shortStream)
+            {
+                this->txScheduler.add(shortStream);
+            }
+
+            if (not floatStream and not shortStream)
+            {
+                this->txWait.idle(this->pollTimeout);
+            }
+
+            return NORMAL;
+        }
+
+        // Otherwise, wait on a packet for any stream. The wait is bounded so
+        // that streams starting on the other port are noticed. When both
+        // ports have streams, or neither does, they take turns.
+        size_t floatStreams = this->txScheduler.floatStreams();
+        size_t shortStreams = this->txScheduler.size() - floatStreams;
+        float timeout = (floatStreams > 0 and shortStreams > 0) ? 0.001 : this->pollTimeout.load();
+
+        if ((floatStreams > 0) == (shortStreams > 0))
+        {
+            this->txWaitOnFloat = not this->txWaitOnFloat;
+        }
+        else
+        {
+            this->txWaitOnFloat = (floatStreams > 0);
+        }
+
+        // Make sure the stream is scheduled, in case its packet arrived
+        // before the stream listener was called
+        if (this->txWaitOnFloat)
+        {
+            bulkio::InFloatStream stream = this->dataFloat_in->getCurrentStream(timeout);
+
+            if (stream)
+            {
+                this->txScheduler.add(stream);
+            }
+        }
+        else
+        {
+            bulkio::InShortStream stream = this->dataShort_in->getCurrentStream(timeout);
+
+            if (stream)
+            {
+                this->txScheduler.add(stream);
+            }
+        }
+
+        return NORMAL;
+    }
+
+    return NOOP;
+}
+
+/*
+ * Private Method(s)
+ */
+
+// Record a new or changed input stream from either input port. Returns true
+// if the stream is new.
+bool RFNoC_TestComponent_i::addIncomingStream(const std::string &streamID, const BULKIO::StreamSRI &inputSRI, size_t portHash)
+{
+    boost::mutex::scoped_lock lock(this->streamLock);
+
+    std::map<std::string, IncomingStream>::iterator it = this->streamMap.find(streamID);
+    bool newStream = (it == this->streamMap.end());
+
+    if (newStream)
+    {
+        LOG_DEBUG(RFNoC_TestComponent_i, "New incoming connection");
 
         this->persona->incomingConnectionAdded(this->identifier(),
-        									   stream.streamID(),
-											   this->dataShort_in->_this()->_hash(RFNoC_RH::HASH_SIZE));
+        									   streamID,
+											   portHash);
+
+        this->txWait.notify();
+    }
+    else
+    {
+        LOG_DEBUG(RFNoC_TestComponent_i, "Existing connection changed");
+    }
+
+    LOG_DEBUG(RFNoC_TestComponent_i, "Got SRI for stream ID: " << streamID);
+
+    this->streamMap[streamID].portHash = portHash;
+    this->streamMap[streamID].sri = inputSRI;
+
+    // The output SRI follows the first stream received, rather than
+    // whichever stream changed last
+    if (not this->sriPublisher.published() or streamID == this->sriStreamID)
+    {
+        this->sriStreamID = streamID;
+
+        updateOutputSRI(inputSRI);
+    }
+
+    return newStream;
+}
+
+// Forget an input stream, handing the output SRI over to another stream if
+// it was taken from this one
+void RFNoC_TestComponent_i::removeIncomingStream(const std::string &streamID)
+{
+    boost::mutex::scoped_lock lock(this->streamLock);
+
+    std::map<std::string, IncomingStream>::iterator it = this->streamMap.find(streamID);
+
+    if (it == this->streamMap.end())
+    {
+        return;
+    }
+
+    LOG_DEBUG(RFNoC_TestComponent_i, "Removed incoming connection");
+
+    this->persona->incomingConnectionRemoved(this->identifier(),
+                                             streamID,
+                                             it->second.portHash);
+
+    this->streamMap.erase(it);
+
+    if (streamID == this->sriStreamID and not this->streamMap.empty())
+    {
+        this->sriStreamID = this->streamMap.begin()->first;
+
+        updateOutputSRI(this->streamMap.begin()->second.sri);
+    }
+}
+
+// The block port an input stream is sent to, from its BLOCK_PORT keyword.
+// Streams without one, or naming a port the block doesn't have, go to the
+// first port.
+size_t RFNoC_TestComponent_i::blockPortForSRI(const BULKIO::StreamSRI &sri)
+{
+    const redhawk::PropertyMap &keywords = redhawk::PropertyMap::cast(sri.keywords);
+    redhawk::PropertyMap::const_iterator it = keywords.find("BLOCK_PORT");
+
+    if (it == keywords.end())
+    {
+        return 0;
+    }
+
+    size_t port = it->getValue().toULong();
+
+    if (port >= this->txChannels)
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Stream " << sri.streamID.in() << " is for block port " << port << ", which doesn't exist. Sending it to port 0");
+        return 0;
+    }
+
+    return port;
+}
+
+// Choose the time a TX burst starts at. A burst due sooner than the lead time
+// from now is delayed, so that it doesn't reach the block late. The block's
+// time is taken to follow the host clock.
+uhd::time_spec_t RFNoC_TestComponent_i::scheduleTxBurst(const BULKIO::PrecisionUTCTime &time)
+{
+    uhd::time_spec_t burstTime(time.twsec, time.tfsec);
+    double leadTime = this->txLeadTime.load(boost::memory_order_relaxed);
+
+    if (leadTime > 0)
+    {
+        BULKIO::PrecisionUTCTime now = bulkio::time::utils::now();
+        uhd::time_spec_t earliest = uhd::time_spec_t(now.twsec, now.tfsec) + uhd::time_spec_t(leadTime);
+
+        if (burstTime < earliest)
+        {
+            burstTime = earliest;
+        }
+    }
+
+    return burstTime;
+}
+
+// A helper method for sending a contiguous run of samples to the RF-NoC block.
+// Only the first send of a burst carries its time, if it has one, and the end
+// of the burst goes out with the send which completes the run. With several
+// block ports, the run goes to the given port and the others are sent zeros,
+// a slice at a time.
+void RFNoC_TestComponent_i::sendSamples(const std::complex<short> *samples, size_t numSamples, bool startOfBurst, const uhd::time_spec_t *time, bool endOfBurst, bool logSends, size_t port)
+{
+    uhd::tx_metadata_t md;
+
+    md.start_of_burst = startOfBurst;
+    md.has_time_spec = (startOfBurst and time);
+    md.end_of_burst = endOfBurst;
+
+    if (md.has_time_spec)
+    {
+        md.time_spec = *time;
+    }
+
+    size_t samplesSent = 0;
+    size_t samplesToSend = numSamples;
+
+    // An empty run is still sent once, for the end of burst. The send waits
+    // in short slices, and gives up on the rest of the run after a stop.
+    double timeout = this->pollTimeout.load(boost::memory_order_relaxed);
+
+    do
+    {
+        // Send the data
+        uint64_t sendStart = monotonicNanoseconds();
+
+        if (md.has_time_spec)
+        {
+            this->trace.recordAge(LatencyTrace::TX_BURST_AGE, sendStart, md.time_spec, samplesToSend);
+        }
+
+        size_t num_tx_samps = 0;
+
+        if (this->txChannels > 1)
+        {
+            for (size_t channel = 0; channel < this->txChannels; ++channel)
+            {
+                this->txSendBuffers[channel] = (channel == port) ? samples + samplesSent : this->txZeroBuffer;
+            }
+
+            // Only the last slice can end the burst
+            size_t slice = std::min(samplesToSend, this->txZeroSize);
+
+            md.end_of_burst = (endOfBurst and slice == samplesToSend);
+
+            num_tx_samps = this->txStreamer->send(this->txSendBuffers, slice, md, timeout);
+        }
+        else
+        {
+            num_tx_samps = this->txStreamer->send(samples + samplesSent, samplesToSend, md, timeout);
+        }
+
+        uint64_t sendEnd = monotonicNanoseconds();
+
+        this->counters.sendLatency.record(sendEnd - sendStart);
+        this->trace.record(LatencyTrace::TX_SEND, sendStart, sendEnd, num_tx_samps);
+        this->counters.samplesIn.fetch_add(num_tx_samps, boost::memory_order_relaxed);
+
+        samplesSent += num_tx_samps;
+        samplesToSend -= num_tx_samps;
+
+        if (num_tx_samps > 0)
+        {
+            md.start_of_burst = false;
+            md.has_time_spec = false;
+        }
+
+        HOT_LOG_DEBUG(RFNoC_TestComponent_i, logSends, this->blockID << ": " << "TX Thread Sent " << num_tx_samps << " samples");
+    } while (samplesToSend != 0 and not this->txStopping);
+}
+
+// Send a block read from an input stream to the RF-NoC block, along with
+// the samples it holds in sc16. If the block ends its stream, the burst ends
+// with its last send.
+template <typename BlockType>
+bool RFNoC_TestComponent_i::sendTxBlock(TxStreamState *state, const BlockType &block, const std::complex<short> *samples, bool endOfStream)
+{
+    if (block.sriChanged() or state->samplesSent == 0)
+    {
+        state->sri = block.sri();
+        state->port = blockPortForSRI(state->sri);
+    }
+
+    size_t blockSize = block.size() / 2;
+
+    bool logBlock = HOT_LOG_SAMPLE(this->txLogSampler);
+
+    HOT_LOG_DEBUG(RFNoC_TestComponent_i, logBlock, this->blockID << ": " << "TX Thread Received " << blockSize << " samples from stream ID: " << state->streamID());
+
+    if (blockSize == 0)
+    {
+        HOT_LOG_DEBUG(RFNoC_TestComponent_i, logBlock, "Skipping empty packet");
+        ++this->counters.emptyPackets;
+        return true;
+    }
+
+    BULKIO::PrecisionUTCTime segmentTime = block.getStartTime();
+    double xdelta = state->sri.xdelta;
+
+    // Only one burst may be open on the block at a time, so end the burst of
+    // any other stream. A stream which jumps in time also starts over.
+    if (this->txBurstStream and this->txBurstStream != state)
+    {
+        endTxBurst(this->txBurstStream);
+    }
+
+    if (state->burstOpen and state->nextTimeValid and not timeContinues(segmentTime, state->nextTime, xdelta))
+    {
+        endTxBurst(state);
+    }
+
+    // Split the block wherever the packets it was built from are not
+    // contiguous in time. Each piece but the last ends its burst, and the
+    // piece after it starts a new one at its own time stamp.
+    bool startOfBurst = not state->burstOpen;
+    std::list<bulkio::SampleTimestamp> timestamps = block.getTimestamps();
+    size_t samplesPerOffset = (block.complex()) ? 1 : 2;
+
+    size_t segmentStart = 0;
+
+    for (std::list<bulkio::SampleTimestamp>::iterator it = timestamps.begin(); it != timestamps.end(); ++it)
+    {
+        size_t offset = it->offset / samplesPerOffset;
+
+        if (offset == segmentStart or it->synthetic)
+        {
+            continue;
+        }
+
+        BULKIO::PrecisionUTCTime expected = bulkio::time::utils::addSampleOffset(segmentTime, (offset - segmentStart) * samplesPerOffset, xdelta);
+
+        if (timeContinues(it->time, expected, xdelta))
+        {
+            continue;
+        }
+
+        uhd::time_spec_t burstTime = (startOfBurst) ? scheduleTxBurst(segmentTime) : uhd::time_spec_t();
+
+        transmitSamples(samples + segmentStart, offset - segmentStart, startOfBurst, &burstTime, true, logBlock, state->port);
+
+        startOfBurst = true;
+        segmentStart = offset;
+        segmentTime = it->time;
+    }
+
+    uhd::time_spec_t burstTime = (startOfBurst) ? scheduleTxBurst(segmentTime) : uhd::time_spec_t();
+
+    transmitSamples(samples + segmentStart, blockSize - segmentStart, startOfBurst, &burstTime, endOfStream, logBlock, state->port);
+
+    // Remember where this stream's time base continues from
+    state->burstOpen = not endOfStream;
+    state->nextTime = bulkio::time::utils::addSampleOffset(segmentTime, (blockSize - segmentStart) * samplesPerOffset, xdelta);
+    state->nextTimeValid = true;
+    state->samplesSent += blockSize;
+
+    this->txBurstStream = (endOfStream) ? NULL : state;
+
+    return true;
+}
+
+// Hand a run of samples to the RF-NoC block, through the TX queue if it's
+// enabled
+void RFNoC_TestComponent_i::transmitSamples(const std::complex<short> *samples, size_t numSamples, bool startOfBurst, const uhd::time_spec_t *time, bool endOfBurst, bool logSends, size_t port)
+{
+    if (this->txQueue)
+    {
+        queueTxSamples(samples, numSamples, startOfBurst, time, endOfBurst, port);
+    }
+    else
+    {
+        sendSamples(samples, numSamples, startOfBurst, time, endOfBurst, logSends, port);
+    }
+}
+
+// Split a run of samples across TX queue buffers for the send thread, with
+// the start of the burst on the first buffer and the end on the last. A
+// buffer dropped by the overflow policy is skipped.
+void RFNoC_TestComponent_i::queueTxSamples(const std::complex<short> *samples, size_t numSamples, bool startOfBurst, const uhd::time_spec_t *time, bool endOfBurst, size_t port)
+{
+    size_t offset = 0;
+
+    do
+    {
+        size_t count = std::min(numSamples - offset, this->txQueue->bufferSize());
+        TxBuffer *buffer = this->txQueue->acquireFree();
+
+        if (buffer)
+        {
+            std::copy(samples + offset, samples + offset + count, buffer->data);
+
+            buffer->size = count;
+            buffer->port = port;
+            buffer->startOfBurst = (startOfBurst and offset == 0);
+            buffer->endOfBurst = (endOfBurst and offset + count == numSamples);
+
+            if (buffer->startOfBurst and time)
+            {
+                buffer->time = *time;
+            }
+
+            if (this->trace.enabled())
+            {
+                buffer->queuedAt = monotonicNanoseconds();
+            }
+
+            if (this->txQueue->commit())
+            {
+                this->txSendWait.notify();
+            }
+        }
+
+        offset += count;
+    } while (offset < numSamples);
+}
+
+// Hand the next run of the TX replay to the RF-NoC block once the replay
+// rate allows. The replay has the block to itself, so any burst left open by
+// an input stream is ended first.
+void RFNoC_TestComponent_i::serviceTxReplay(TxReplaySource &replay)
+{
+    double delay = replay.delay();
+
+    if (delay > 0)
+    {
+        boost::this_thread::sleep(boost::posix_time::microseconds(long(std::min(delay, this->pollTimeout.load()) * 1e6)));
+        return;
+    }
+
+    if (this->txBurstStream)
+    {
+        endTxBurst(this->txBurstStream);
+    }
+
+    size_t maxSamples = (this->txReplay.samplesPerSend > 0) ? size_t(this->txReplay.samplesPerSend) : this->spp;
+    TxReplayRun run;
+
+    if (not replay.next(maxSamples, scheduleTxBurst(bulkio::time::utils::now()), run))
+    {
+        return;
+    }
+
+    if (run.startOfBurst and this->txReplayBurstOpen)
+    {
+        endTxReplayBurst();
+    }
+
+    bool logRun = HOT_LOG_SAMPLE(this->txLogSampler);
+
+    HOT_LOG_DEBUG(RFNoC_TestComponent_i, logRun, this->blockID << ": " << "TX Thread Replaying " << run.size << " samples");
+
+    transmitSamples(run.data, run.size, run.startOfBurst, (run.hasTime) ? &run.time : NULL, run.endOfBurst, logRun);
+
+    this->txReplayBurstOpen = not run.endOfBurst;
+
+    if (replay.finished())
+    {
+        LOG_INFO(RFNoC_TestComponent_i, this->blockID << ": " << "TX replay " << replay.status());
+    }
+}
+
+// Hand the next run of the self test pattern to the RF-NoC block once the
+// self test rate allows. Like a replay, the self test has the block to
+// itself, so any other burst left open is ended first.
+void RFNoC_TestComponent_i::serviceSelfTest()
+{
+    double delay = this->loopbackTest->delay();
+
+    if (delay > 0)
+    {
+        boost::this_thread::sleep(boost::posix_time::microseconds(long(std::min(delay, this->pollTimeout.load()) * 1e6)));
+        return;
+    }
+
+    if (this->txBurstStream)
+    {
+        endTxBurst(this->txBurstStream);
+    }
+
+    if (this->txReplayBurstOpen)
+    {
+        endTxReplayBurst();
+    }
+
+    const std::complex<short> *samples;
+    size_t count;
+    bool startOfBurst;
+    bool endOfBurst;
+
+    if (not this->loopbackTest->next(samples, count, startOfBurst, endOfBurst))
+    {
+        return;
+    }
+
+    bool logRun = HOT_LOG_SAMPLE(this->txLogSampler);
+
+    HOT_LOG_DEBUG(RFNoC_TestComponent_i, logRun, this->blockID << ": " << "TX Thread Sending " << count << " self test samples");
+
+    transmitSamples(samples, count, startOfBurst, NULL, endOfBurst, logRun);
+
+    this->txSelfTestBurstOpen = not endOfBurst;
+}
+
+// Give an input stream its turn on the RF-NoC block, sending at most one
+// batch of its samples. Returns false if the stream had nothing to do.
+bool RFNoC_TestComponent_i::serviceTxStream(TxStreamState *state)
+{
+    // Coalesce whatever is already queued into a single block, without
+    // waiting on more. A short block read from a single packet shares the
+    // transport buffer rather than copying it.
+    uint64_t readStart = (this->trace.enabled()) ? monotonicNanoseconds() : 0;
+
+    if (state->floatInput)
+    {
+        bulkio::InFloatStream &stream = state->floatStream;
+        size_t samplesAvailable = stream.samplesAvailable();
+        bulkio::FloatDataBlock block;
+
+        if (samplesAvailable > 0)
+        {
+            block = stream.tryread(std::min(samplesAvailable, this->txBatchSize));
+        }
+        else
+        {
+            block = stream.tryread();
+        }
+
+        if (not block)
+        {
+            return (stream.eos()) ? endTxStream(state) : false;
+        }
+
+        // Convert the samples to sc16 for the RF-NoC block, only replacing
+        // the conversion buffer when a larger block than any before arrives
+        if (this->txConvertSize < block.size())
+        {
+            this->samplePool.release(this->txConvertBuffer);
+            this->txConvertBuffer = this->samplePool.acquire<short>(block.size());
+            this->txConvertSize = block.size();
+        }
+
+        convertFloatToShort(block.data(), this->txConvertBuffer, block.size(), this->floatScale);
+
+        if (readStart != 0)
+        {
+            this->trace.record(LatencyTrace::TX_READ, readStart, monotonicNanoseconds(), block.size() / 2);
+        }
+
+        return sendTxBlock(state, block, (const std::complex<short> *) this->txConvertBuffer, stream.eos());
+    }
+    else
+    {
+        bulkio::InShortStream &stream = state->stream;
+        size_t samplesAvailable = stream.samplesAvailable();
+        bulkio::ShortDataBlock block;
+
+        if (samplesAvailable > 0)
+        {
+            block = stream.tryread(std::min(samplesAvailable, this->txBatchSize));
+        }
+        else
+        {
+            block = stream.tryread();
+        }
+
+        if (not block)
+        {
+            return (stream.eos()) ? endTxStream(state) : false;
+        }
+
+        if (readStart != 0)
+        {
+            this->trace.record(LatencyTrace::TX_READ, readStart, monotonicNanoseconds(), block.size() / 2);
+        }
+
+        return sendTxBlock(state, block, (const std::complex<short> *) block.data(), stream.eos());
+    }
+}
+
+// The property change listener for the bufferPool property
+void RFNoC_TestComponent_i::bufferPoolChanged(const bufferPool_struct &oldValue, const bufferPool_struct &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (newValue.limit < 0)
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "The buffer pool limit can't be negative, reverting");
+        this->bufferPool = oldValue;
+        return;
+    }
+
+    this->samplePool.configure(newValue.hugePages, newValue.lockPages, size_t(newValue.limit * 1024 * 1024));
+}
+
+// Tell the RX threads to stop, waking any wait they're in so they return
+// within a poll timeout
+void RFNoC_TestComponent_i::cancelRxThreads()
+{
+    this->rxStopping = true;
+    this->rxWait.notify();
+
+    if (this->rxRing)
+    {
+        this->rxRing->cancel();
+    }
+
+    boost::mutex::scoped_lock lock(this->rxCommandLock);
+    this->rxCommandCondition.notify_all();
+}
+
+// Tell the TX threads to stop, waking any wait they're in and abandoning any
+// send in progress
+void RFNoC_TestComponent_i::cancelTxThreads()
+{
+    this->txStopping = true;
+    this->txWait.notify();
+    this->txSendWait.notify();
+
+    if (this->txQueue)
+    {
+        this->txQueue->cancel();
+    }
+}
+
+// The property change listener for the args property.
+void RFNoC_TestComponent_i::argsChanged(const std::vector<arg_struct> &oldValue, const std::vector<arg_struct> &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (not setArgs(this->args))
+    {
+        LOG_WARN(RFNoC_TestComponent_i, "Unable to set new arguments, reverting");
+        this->args = oldValue;
+    }
+
+    // The spp may have changed, so update it and the RX transfer size
+    if (this->rfnocBlock or this->emulatedBlock)
+    {
+        this->spp = this->blockArgs->applied().cast<size_t>("spp", this->spp);
+
+        updateRxTransferSize();
+    }
+}
+
+void RFNoC_TestComponent_i::streamChanged(bulkio::InShortPort::StreamType stream)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (stream.eos())
+    {
+        removeIncomingStream(stream.streamID());
+        return;
+    }
+
+    // Schedule new streams for transmission
+    if (addIncomingStream(stream.streamID(), stream.sri(), this->dataShort_in->_this()->_hash(RFNoC_RH::HASH_SIZE)))
+    {
+        this->txScheduler.add(stream);
+    }
+}
+
+void RFNoC_TestComponent_i::floatStreamChanged(bulkio::InFloatPort::StreamType stream)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (stream.eos())
+    {
+        removeIncomingStream(stream.streamID());
+        return;
+    }
+
+    // Schedule new streams for transmission
+    if (addIncomingStream(stream.streamID(), stream.sri(), this->dataFloat_in->_this()->_hash(RFNoC_RH::HASH_SIZE)))
+    {
+        this->txScheduler.add(stream);
+    }
+}
+
+// Query callback for the latencyTraceStatus property
+std::string RFNoC_TestComponent_i::getLatencyTraceStatus()
+{
+    return this->trace.status();
+}
+
+// Query callback for the performance property
+performance_struct RFNoC_TestComponent_i::getPerformance()
+{
+    this->counters.report(this->performance);
+
+    this->performance.txLeadTime = this->txLeadTime.load();
+
+    this->performance.bufferPoolInUse = this->samplePool.bytesInUse();
+    this->performance.bufferPoolHighWater = this->samplePool.highWaterMark();
+    this->performance.bufferPoolReserved = this->samplePool.bytesReserved();
+    this->performance.bufferPoolExhaustions = this->samplePool.exhaustions();
+
+    if (this->rxTap)
+    {
+        this->performance.captureDroppedSamples = this->rxTap->droppedSamples();
+    }
+
+    {
+        boost::mutex::scoped_lock lock(this->txReplayLock);
+
+        if (this->txReplaySource)
+        {
+            this->performance.replayLoops = this->txReplaySource->loops();
+            this->performance.replayLateRuns = this->txReplaySource->lateRuns();
+        }
+    }
+
+    if (this->rxRing)
+    {
+        this->performance.rxBlockTimeouts = this->rxRing->blockTimeouts();
+    }
+
+    if (this->txQueue)
+    {
+        this->performance.txQueueDroppedOldest = this->txQueue->droppedOldest();
+        this->performance.txQueueDroppedNewest = this->txQueue->droppedNewest();
+        this->performance.txQueueBlockedTime = this->txQueue->blockedTime();
+    }
+
+    return this->performance;
+}
+
+// Read the arguments from the RF-NoC block, or its emulation
+uhd::device_addr_t RFNoC_TestComponent_i::getBlockArgs()
+{
+    return (this->emulatedBlock) ? this->emulatedBlock->getArgs() : this->rfnocBlock->get_args();
+}
+
+// Query callback for the blockEmulationStatus property
+std::string RFNoC_TestComponent_i::getBlockEmulationStatus()
+{
+    if (this->emulatedBlock)
+    {
+        return "emulated: " + this->emulatedBlock->describe();
+    }
+
+    return (this->rfnocBlock) ? "hardware" : "no block";
+}
+
+// Query callback for the bufferPoolStatus property
+std::string RFNoC_TestComponent_i::getBufferPoolStatus()
+{
+    return this->samplePool.status();
+}
+
+// Query callback for the rxBackpressureStatus property
+std::string RFNoC_TestComponent_i::getRxBackpressureStatus()
+{
+    std::ostringstream status;
+
+    status << "policy " << this->rxBackpressure.policy;
+
+    if (this->rxRing)
+    {
+        status << ", " << this->rxRing->depth() << " of " << this->rxRing->capacity() << " buffers queued";
+        status << ((this->rxRing->congested()) ? " (congested)" : "") << ", ";
+        status << this->rxRing->dropped() << " dropped, " << this->rxRing->decimated() << " decimated, ";
+        status << this->rxPauses.load() << " pauses, " << this->rxRing->blockedTime() << " s blocked, ";
+        status << this->rxRing->blockTimeouts() << " block timeouts";
+    }
+
+    std::string ports = this->portMonitor.status();
+
+    if (not ports.empty())
+    {
+        status << "\n" << ports;
+    }
+
+    return status.str();
+}
+
+// Query callback for the rxDroppedBuffers property
+CORBA::ULong RFNoC_TestComponent_i::getRxDroppedBuffers()
+{
+    return (this->rxRing) ? this->rxRing->dropped() : 0;
+}
+
+// Query callback for the rxCaptureStatus property
+std::string RFNoC_TestComponent_i::getRxCaptureStatus()
+{
+    return (this->rxTap) ? this->rxTap->status() : "idle";
+}
+
+// Query callback for the rxQueueDepth property
+CORBA::ULong RFNoC_TestComponent_i::getRxQueueDepth()
+{
+    return (this->rxRing) ? this->rxRing->depth() : 0;
+}
+
+// Query callback for the selfTestResults property
+selfTestResults_struct RFNoC_TestComponent_i::getSelfTestResults()
+{
+    this->loopbackTest->report(this->selfTestResults);
+
+    return this->selfTestResults;
+}
+
+// Query callback for the selfTestStatus property
+std::string RFNoC_TestComponent_i::getSelfTestStatus()
+{
+    return this->loopbackTest->status();
+}
+
+// Query callback for the threadPolicyStatus property
+std::string RFNoC_TestComponent_i::getThreadPolicyStatus()
+{
+    boost::mutex::scoped_lock lock(this->memoryStatusLock);
+
+    std::string memoryStatus = (not this->lockMemory) ? "unlocked" : (this->memoryLockStatus.empty()) ? "locked" : this->memoryLockStatus;
+
+    return "RX: " + this->rxPolicy.status() + ", TX: " + this->txPolicy.status() + ", memory: " + memoryStatus;
+}
+
+// Query callback for the txReplayStatus property
+std::string RFNoC_TestComponent_i::getTxReplayStatus()
+{
+    boost::mutex::scoped_lock lock(this->txReplayLock);
+
+    return (this->txReplaySource) ? this->txReplaySource->status() : "idle";
+}
+
+// The property change listener for the hot path logging properties
+void RFNoC_TestComponent_i::hotPathLogChanged(const CORBA::ULong &oldValue, const CORBA::ULong &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    this->rxLogSampler.configure(this->hotPathLogInterval, this->hotPathLogRate);
+    this->txLogSampler.configure(this->hotPathLogInterval, this->hotPathLogRate);
+}
+
+// Set up the listeners, log samplers and buffer sizing used while streaming.
+// None of this touches the RF-NoC block, only the spp read from it.
+void RFNoC_TestComponent_i::initializeStreaming()
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    // Take the initial RX stream control
+    this->rxPendingControl = this->rxStreamControl;
+
+    // Configure the streaming loop log samplers
+    this->rxLogSampler.configure(this->hotPathLogInterval, this->hotPathLogRate);
+    this->txLogSampler.configure(this->hotPathLogInterval, this->hotPathLogRate);
+
+    // Take the initial wait strategy
+    if (not this->rxWait.configure(this->waitStrategy) or not this->txWait.configure(this->waitStrategy) or not this->txSendWait.configure(this->waitStrategy))
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Invalid wait strategy " << this->waitStrategy << ", using event");
+        this->waitStrategy = "event";
+    }
+
+    // Take the initial thread scheduling, which is applied as each streaming
+    // thread starts
+    this->rxPolicy.configure(this->rxThreadPolicy.cpus, this->rxThreadPolicy.policy, this->rxThreadPolicy.priority);
+    this->txPolicy.configure(this->txThreadPolicy.cpus, this->txThreadPolicy.policy, this->txThreadPolicy.priority);
+
+    // Take the initial stop deadline
+    if (this->stopDeadline > 0)
+    {
+        this->pollTimeout = std::min(0.1, this->stopDeadline / 4);
+    }
+
+    // Set up the buffer pool before any buffers are taken from it
+    bufferPoolChanged(this->bufferPool, this->bufferPool);
+
+    // Take the initial TX burst scheduling
+    txBurstControlChanged(this->txBurstControl, this->txBurstControl);
+
+    // Start tracing from the first packet if asked to
+    latencyTraceChanged(this->latencyTrace, this->latencyTrace);
+
+    if (this->lockMemory)
+    {
+        this->memoryLockStatus = applyMemoryLock(true);
+    }
+
+    // Size the RX transfers now that the spp is known
+    updateRxTransferSize();
+
+    // Register the property change listeners
+    this->addPropertyListener(this->args, this, &RFNoC_TestComponent_i::argsChanged);
+    this->addPropertyListener(this->bufferPool, this, &RFNoC_TestComponent_i::bufferPoolChanged);
+    this->addPropertyListener(this->hotPathLogInterval, this, &RFNoC_TestComponent_i::hotPathLogChanged);
+    this->addPropertyListener(this->hotPathLogRate, this, &RFNoC_TestComponent_i::hotPathLogChanged);
+    this->addPropertyListener(this->latencyTrace, this, &RFNoC_TestComponent_i::latencyTraceChanged);
+    this->addPropertyListener(this->latencyTraceExport, this, &RFNoC_TestComponent_i::latencyTraceExportChanged);
+    this->addPropertyListener(this->lockMemory, this, &RFNoC_TestComponent_i::lockMemoryChanged);
+    this->addPropertyListener(this->rxBackpressure, this, &RFNoC_TestComponent_i::rxBackpressureChanged);
+    this->addPropertyListener(this->rxCapture, this, &RFNoC_TestComponent_i::rxCaptureChanged);
+    this->addPropertyListener(this->rxCaptureTrigger, this, &RFNoC_TestComponent_i::rxCaptureTriggerChanged);
+    this->addPropertyListener(this->rxLatencyBudget, this, &RFNoC_TestComponent_i::rxLatencyBudgetChanged);
+    this->addPropertyListener(this->rxStreamControl, this, &RFNoC_TestComponent_i::rxStreamControlChanged);
+    this->addPropertyListener(this->rxThreadPolicy, this, &RFNoC_TestComponent_i::rxThreadPolicyChanged);
+    this->addPropertyListener(this->rxTransferMode, this, &RFNoC_TestComponent_i::rxTransferModeChanged);
+    this->addPropertyListener(this->rxTransferPackets, this, &RFNoC_TestComponent_i::rxTransferPacketsChanged);
+    this->addPropertyListener(this->selfTest, this, &RFNoC_TestComponent_i::selfTestChanged);
+    this->addPropertyListener(this->selfTestRun, this, &RFNoC_TestComponent_i::selfTestRunChanged);
+    this->addPropertyListener(this->stopDeadline, this, &RFNoC_TestComponent_i::stopDeadlineChanged);
+    this->addPropertyListener(this->txBurstControl, this, &RFNoC_TestComponent_i::txBurstControlChanged);
+    this->addPropertyListener(this->txQueuePolicy, this, &RFNoC_TestComponent_i::txQueuePolicyChanged);
+    this->addPropertyListener(this->txReplay, this, &RFNoC_TestComponent_i::txReplayChanged);
+    this->addPropertyListener(this->txThreadPolicy, this, &RFNoC_TestComponent_i::txThreadPolicyChanged);
+    this->addPropertyListener(this->waitStrategy, this, &RFNoC_TestComponent_i::waitStrategyChanged);
+
+    // Set the logger for the ports
+    this->dataFloat_in->setLogger(this->getLogger());
+    this->dataFloat_out->setLogger(this->getLogger());
+    this->dataShort_in->setLogger(this->getLogger());
+    this->dataShort_out->setLogger(this->getLogger());
+
+    // Add an SRI change listener
+    this->dataFloat_in->addStreamListener(this, &RFNoC_TestComponent_i::floatStreamChanged);
+    this->dataShort_in->addStreamListener(this, &RFNoC_TestComponent_i::streamChanged);
+
+    // Add a stream listener
+    this->dataFloat_out->setNewConnectListener(this, &RFNoC_TestComponent_i::newFloatConnection);
+    this->dataFloat_out->setNewDisconnectListener(this, &RFNoC_TestComponent_i::newFloatDisconnection);
+    this->dataShort_out->setNewConnectListener(this, &RFNoC_TestComponent_i::newConnection);
+    this->dataShort_out->setNewDisconnectListener(this, &RFNoC_TestComponent_i::newDisconnection);
+
+    LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "Using " << conversionKernelName() << " sample conversion");
+
+    // Report the RX queue statistics as they are queried
+    this->setPropertyQueryImpl(this->rxDroppedBuffers, this, &RFNoC_TestComponent_i::getRxDroppedBuffers);
+    this->setPropertyQueryImpl(this->rxQueueDepth, this, &RFNoC_TestComponent_i::getRxQueueDepth);
+    this->setPropertyQueryImpl(this->rxBackpressureStatus, this, &RFNoC_TestComponent_i::getRxBackpressureStatus);
+
+    // Report the state of the RX capture as it's queried
+    this->setPropertyQueryImpl(this->rxCaptureStatus, this, &RFNoC_TestComponent_i::getRxCaptureStatus);
+
+    // Report the state of the TX replay as it's queried
+    this->setPropertyQueryImpl(this->txReplayStatus, this, &RFNoC_TestComponent_i::getTxReplayStatus);
+
+    // Report the state and results of the self test as they're queried
+    this->setPropertyQueryImpl(this->selfTestResults, this, &RFNoC_TestComponent_i::getSelfTestResults);
+    this->setPropertyQueryImpl(this->selfTestStatus, this, &RFNoC_TestComponent_i::getSelfTestStatus);
+
+    // Report the state of the latency trace as it's queried
+    this->setPropertyQueryImpl(this->latencyTraceStatus, this, &RFNoC_TestComponent_i::getLatencyTraceStatus);
+
+    // Report whether the block is emulated as it's queried
+    this->setPropertyQueryImpl(this->blockEmulationStatus, this, &RFNoC_TestComponent_i::getBlockEmulationStatus);
+
+    // Report how the buffer pool is backed as it's queried
+    this->setPropertyQueryImpl(this->bufferPoolStatus, this, &RFNoC_TestComponent_i::getBufferPoolStatus);
+
+    // Report the results of applying the thread scheduling as it's queried
+    this->setPropertyQueryImpl(this->threadPolicyStatus, this, &RFNoC_TestComponent_i::getThreadPolicyStatus);
+
+    // Report the performance counters as they are queried
+    this->setPropertyQueryImpl(this->performance, this, &RFNoC_TestComponent_i::getPerformance);
+}
+
+// The property change listener for the latencyTrace property. Changing the
+// number of events discards the trace so far.
+void RFNoC_TestComponent_i::latencyTraceChanged(const latencyTrace_struct &oldValue, const latencyTrace_struct &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (newValue.events == 0 or (newValue.format != "chrome" and newValue.format != "perf"))
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Invalid latency trace settings, reverting");
+        this->latencyTrace = oldValue;
+        return;
+    }
+
+    this->trace.configure(newValue.enabled, newValue.endToEnd, newValue.events);
+}
+
+// The property change listener for the latencyTraceExport property, which
+// acts as a button
+void RFNoC_TestComponent_i::latencyTraceExportChanged(const bool &oldValue, const bool &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (not newValue)
+    {
+        return;
+    }
+
+    this->latencyTraceExport = false;
+
+    if (this->latencyTrace.path.empty())
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "No latency trace path is set");
+        return;
+    }
+
+    if (this->trace.exportTrace(this->latencyTrace.path, this->latencyTrace.format))
+    {
+        LOG_INFO(RFNoC_TestComponent_i, this->blockID << ": " << "Exported latency trace to " << this->latencyTrace.path);
+    }
+    else
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Unable to export latency trace, " << this->trace.status());
+    }
+}
+
+// The property change listener for the lockMemory property
+void RFNoC_TestComponent_i::lockMemoryChanged(const bool &oldValue, const bool &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    boost::mutex::scoped_lock lock(this->memoryStatusLock);
+
+    this->memoryLockStatus = applyMemoryLock(newValue);
+
+    if (not this->memoryLockStatus.empty())
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << this->memoryLockStatus);
+    }
+}
+
+// Report the result of applying a streaming thread's scheduling
+void RFNoC_TestComponent_i::logThreadPolicy(const std::string &threadName, const ThreadPolicy &policy)
+{
+    std::string status = policy.status();
+
+    if (status == "applied")
+    {
+        LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "Applied " << threadName << " thread scheduling");
+    }
+    else
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Unable to apply " << threadName << " thread scheduling: " << status);
+    }
+}
+
+void RFNoC_TestComponent_i::newConnection(const char *connectionID)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+	BULKIO::UsesPortStatisticsProvider_ptr port = BULKIO::UsesPortStatisticsProvider::_narrow(this->getPort(this->dataShort_out->getName().c_str()));
+
+	this->persona->outgoingConnectionAdded(this->identifier(), connectionID, port->_hash(RFNoC_RH::HASH_SIZE));
+
+	++this->shortOutputConnections;
+
+	this->portMonitor.connect(this->rxShortPort, connectionID);
+}
+
+void RFNoC_TestComponent_i::newDisconnection(const char *connectionID)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+	BULKIO::UsesPortStatisticsProvider_ptr port = BULKIO::UsesPortStatisticsProvider::_narrow(this->getPort(this->dataShort_out->getName().c_str()));
+
+	this->persona->outgoingConnectionRemoved(this->identifier(), connectionID, port->_hash(RFNoC_RH::HASH_SIZE));
+
+	--this->shortOutputConnections;
+
+	this->portMonitor.disconnect(this->rxShortPort, connectionID);
+}
+
+void RFNoC_TestComponent_i::newFloatConnection(const char *connectionID)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+	BULKIO::UsesPortStatisticsProvider_ptr port = BULKIO::UsesPortStatisticsProvider::_narrow(this->getPort(this->dataFloat_out->getName().c_str()));
+
+	this->persona->outgoingConnectionAdded(this->identifier(), connectionID, port->_hash(RFNoC_RH::HASH_SIZE));
+
+	++this->floatOutputConnections;
+
+	this->portMonitor.connect(this->rxFloatPort, connectionID);
+}
+
+void RFNoC_TestComponent_i::newFloatDisconnection(const char *connectionID)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+	BULKIO::UsesPortStatisticsProvider_ptr port = BULKIO::UsesPortStatisticsProvider::_narrow(this->getPort(this->dataFloat_out->getName().c_str()));
+
+	this->persona->outgoingConnectionRemoved(this->identifier(), connectionID, port->_hash(RFNoC_RH::HASH_SIZE));
+
+	--this->floatOutputConnections;
+
+	this->portMonitor.disconnect(this->rxFloatPort, connectionID);
+}
+
+// A helper method for starting a new RX capture, if one is configured. The
+// staging ring holds a few RX buffers, so the writer can fall that far behind
+// before any are dropped.
+void RFNoC_TestComponent_i::openRxCapture()
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (not this->rxTap or this->rxCapture.path.empty())
+    {
+        return;
+    }
+
+    size_t fileSamples = this->rxCapture.fileSize * 1024 * 1024 / sizeof(std::complex<short>);
+    size_t stagingSamples = 4 * this->rxRing->bufferSize();
+    bool triggerNow = (this->rxCapture.trigger == "immediate");
+
+    if (this->rxTap->open(this->rxCapture.path, fileSamples, stagingSamples, this->rxSampleRate, this->rxCapture.preTrigger, this->rxCapture.postTrigger, triggerNow, this->blockID))
+    {
+        LOG_INFO(RFNoC_TestComponent_i, this->blockID << ": " << "Capturing RX samples to " << this->rxCapture.path);
+    }
+    else
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Unable to capture RX samples, " << this->rxTap->status());
+    }
+}
+
+// A helper method for starting a new TX replay, if one is configured, in
+// place of any replay already running
+void RFNoC_TestComponent_i::openTxReplay()
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    boost::shared_ptr<TxReplaySource> replay;
+
+    if (not this->txReplay.path.empty())
+    {
+        replay = boost::make_shared<TxReplaySource>();
+
+        if (replay->open(this->txReplay.path, this->txReplay.rate, this->txReplay.loop, this->txReplay.timestamps))
+        {
+            LOG_INFO(RFNoC_TestComponent_i, this->blockID << ": " << "Replaying TX samples from " << this->txReplay.path);
+        }
+        else
+        {
+            LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Unable to replay TX samples, " << replay->status());
+        }
+    }
+
+    boost::mutex::scoped_lock lock(this->txReplayLock);
+
+    this->txReplaySource = replay;
+}
+
+// The property change listener for the rxBackpressure property. The policy and
+// watermarks apply to the RX queue at once.
+void RFNoC_TestComponent_i::rxBackpressureChanged(const rxBackpressure_struct &oldValue, const rxBackpressure_struct &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    const std::string &policy = newValue.policy;
+
+    if (policy != "block" and policy != "dropOldest" and policy != "decimate" and policy != "pause")
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Invalid RX backpressure policy " << policy << ", reverting");
+        this->rxBackpressure = oldValue;
+        return;
+    }
+
+    if (newValue.lowWatermark < 0 or newValue.highWatermark > 1 or newValue.lowWatermark >= newValue.highWatermark)
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "RX backpressure watermarks must satisfy 0 <= low < high <= 1, reverting");
+        this->rxBackpressure = oldValue;
+        return;
+    }
+
+    if (this->rxRing)
+    {
+        this->rxRing->configure(policy);
+        this->rxRing->setWatermarks(newValue.lowWatermark, newValue.highWatermark);
+    }
+}
+
+// The property change listener for the rxCapture property. A running capture
+// is finished, and a new one started with the new settings.
+void RFNoC_TestComponent_i::rxCaptureChanged(const rxCapture_struct &oldValue, const rxCapture_struct &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (newValue.fileSize <= 0 or (newValue.trigger != "immediate" and newValue.trigger != "manual"))
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Invalid RX capture settings, reverting");
+        this->rxCapture = oldValue;
+        return;
+    }
+
+    if (this->rxTap and this->_started)
+    {
+        this->rxTap->close();
+
+        openRxCapture();
+    }
+}
+
+// The property change listener for the rxCaptureTrigger property, which acts
+// as a button
+void RFNoC_TestComponent_i::rxCaptureTriggerChanged(const bool &oldValue, const bool &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (not newValue)
+    {
+        return;
+    }
+
+    if (this->rxTap)
+    {
+        this->rxTap->trigger();
+    }
+
+    this->rxCaptureTrigger = false;
+}
+
+// The property change listener for the rxLatencyBudget property
+void RFNoC_TestComponent_i::rxLatencyBudgetChanged(const double &oldValue, const double &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    updateRxTransferSize();
+}
+
+// The property change listener for the rxThreadPolicy property
+void RFNoC_TestComponent_i::rxThreadPolicyChanged(const rxThreadPolicy_struct &oldValue, const rxThreadPolicy_struct &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    this->rxPolicy.configure(newValue.cpus, newValue.policy, newValue.priority);
+}
 
-        this->streamMap[stream.streamID()] = true;
+// The property change listener for the rxTransferMode property
+void RFNoC_TestComponent_i::rxTransferModeChanged(const std::string &oldValue, const std::string &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (newValue != "throughput" and newValue != "packets" and newValue != "latency")
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Invalid RX transfer mode " << newValue << ", reverting");
+        this->rxTransferMode = oldValue;
+        return;
     }
-    else if (removedIncomingConnection)
+
+    updateRxTransferSize();
+}
+
+// The property change listener for the rxTransferPackets property
+void RFNoC_TestComponent_i::rxTransferPacketsChanged(const CORBA::ULong &oldValue, const CORBA::ULong &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    updateRxTransferSize();
+}
+
+// The property change listener for the selfTest property. The settings are
+// taken when the next test starts.
+void RFNoC_TestComponent_i::selfTestChanged(const selfTest_struct &oldValue, const selfTest_struct &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (newValue.duration <= 0 or newValue.rate < 0)
     {
-        LOG_DEBUG(RFNoC_TestComponent_i, "Removed incoming connection");
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Invalid self test settings, reverting");
+        this->selfTest = oldValue;
+    }
+}
 
-        this->persona->incomingConnectionRemoved(this->identifier(),
-        										 stream.streamID(),
-												 this->dataShort_in->_this()->_hash(RFNoC_RH::HASH_SIZE));
+// The property change listener for the selfTestRun property, which acts as a
+// button. The self test needs both streamers and the streaming threads.
+void RFNoC_TestComponent_i::selfTestRunChanged(const bool &oldValue, const bool &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
 
-        this->streamMap.erase(it);
+    if (not newValue)
+    {
+        return;
     }
-    else
+
+    this->selfTestRun = false;
+
+    if (not this->rxStreamer or not this->txStreamer)
     {
-        LOG_DEBUG(RFNoC_TestComponent_i, "Existing connection changed");
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Unable to start a self test without both a TX and an RX streamer");
+        return;
     }
 
-    LOG_DEBUG(RFNoC_TestComponent_i, "Got SRI for stream ID: " << stream.streamID());
+    if (not this->_started)
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Unable to start a self test until the component is started");
+        return;
+    }
+
+    size_t samplesPerSend = (this->selfTest.samplesPerSend > 0) ? size_t(this->selfTest.samplesPerSend) : this->spp;
+
+    this->loopbackTest->start(this->selfTest.duration, this->selfTest.rate, samplesPerSend);
 
-    this->sri = stream.sri();
+    // The RX thread may be waiting on the SRI
+    this->rxWait.notify();
+    this->txWait.notify();
 
-    // Default to complex
-    this->sri.mode = 1;
+    LOG_INFO(RFNoC_TestComponent_i, this->blockID << ": " << "Started a " << this->selfTest.duration << " s self test");
+}
 
-    this->dataShort_out->pushSRI(this->sri);
+// The property change listener for the stopDeadline property. The streaming
+// threads check for a stop at least four times within the deadline.
+void RFNoC_TestComponent_i::stopDeadlineChanged(const double &oldValue, const double &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
 
-    LOG_DEBUG(RFNoC_TestComponent_i, "Pushed stream ID to port");
+    if (newValue <= 0)
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "The stop deadline must be positive, reverting");
+        this->stopDeadline = oldValue;
+        return;
+    }
 
-    this->receivedSRI = true;
+    this->pollTimeout = std::min(0.1, newValue / 4);
 }
 
-void RFNoC_TestComponent_i::newConnection(const char *connectionID)
+// The property change listener for the txBurstControl property. Setting the
+// lead time discards any widening after late packets.
+void RFNoC_TestComponent_i::txBurstControlChanged(const txBurstControl_struct &oldValue, const txBurstControl_struct &newValue)
 {
     LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
 
-	BULKIO::UsesPortStatisticsProvider_ptr port = BULKIO::UsesPortStatisticsProvider::_narrow(this->getPort(this->dataShort_out->getName().c_str()));
+    if (newValue.leadTime < 0 or newValue.maxLeadTime < 0)
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "TX lead times must not be negative, reverting");
+        this->txBurstControl = oldValue;
+        return;
+    }
 
-	this->persona->outgoingConnectionAdded(this->identifier(), connectionID, port->_hash(RFNoC_RH::HASH_SIZE));
+    this->txAdaptiveLeadTime = newValue.adaptiveLeadTime;
+    this->txMaxLeadTime = newValue.maxLeadTime;
+    this->txLeadTime = newValue.leadTime;
 }
 
-void RFNoC_TestComponent_i::newDisconnection(const char *connectionID)
+// The property change listener for the txQueuePolicy property
+void RFNoC_TestComponent_i::txQueuePolicyChanged(const std::string &oldValue, const std::string &newValue)
 {
     LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
 
-	BULKIO::UsesPortStatisticsProvider_ptr port = BULKIO::UsesPortStatisticsProvider::_narrow(this->getPort(this->dataShort_out->getName().c_str()));
+    if (newValue != "block" and newValue != "dropOldest" and newValue != "dropNewest")
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Invalid TX queue policy " << newValue << ", reverting");
+        this->txQueuePolicy = oldValue;
+        return;
+    }
 
-	this->persona->outgoingConnectionRemoved(this->identifier(), connectionID, port->_hash(RFNoC_RH::HASH_SIZE));
+    if (this->txQueue)
+    {
+        this->txQueue->configure(newValue);
+    }
+}
+
+// The property change listener for the txReplay property. A running replay
+// is replaced by a new one with the new settings.
+void RFNoC_TestComponent_i::txReplayChanged(const txReplay_struct &oldValue, const txReplay_struct &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (newValue.rate < 0 or (newValue.timestamps != "none" and newValue.timestamps != "regenerate" and newValue.timestamps != "preserve"))
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Invalid TX replay settings, reverting");
+        this->txReplay = oldValue;
+        return;
+    }
+
+    if (this->txThread and this->_started)
+    {
+        openTxReplay();
+    }
+}
+
+// The property change listener for the txThreadPolicy property
+void RFNoC_TestComponent_i::txThreadPolicyChanged(const txThreadPolicy_struct &oldValue, const txThreadPolicy_struct &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    this->txPolicy.configure(newValue.cpus, newValue.policy, newValue.priority);
 }
 
 void RFNoC_TestComponent_i::startRxStream()
@@ -513,14 +2559,49 @@ void RFNoC_TestComponent_i::startRxStream()
 
     if (not this->rxStreamStarted and this->rxStreamer)
     {
-        // Start continuous streaming
+        // Take the latest stream control
+        {
+            boost::mutex::scoped_lock lock(this->rxCommandLock);
+
+            this->rxActiveControl = this->rxPendingControl;
+            this->rxCommandChanged = false;
+        }
+
+        const std::string &mode = this->rxActiveControl.mode;
+        bool finite = (mode != "continuous");
+
+        // Start streaming as configured
         uhd::stream_cmd_t stream_cmd(uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
-        stream_cmd.num_samps = 0;
-        stream_cmd.stream_now = true;
-        stream_cmd.time_spec = uhd::time_spec_t();
+
+        if (mode == "finite_more")
+        {
+            stream_cmd.stream_mode = uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_MORE;
+        }
+        else if (finite)
+        {
+            stream_cmd.stream_mode = uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_DONE;
+        }
+
+        stream_cmd.num_samps = (finite) ? this->rxActiveControl.numSamples : 0;
+        stream_cmd.stream_now = (this->rxActiveControl.startTime <= 0);
+        stream_cmd.time_spec = uhd::time_spec_t(this->rxActiveControl.startTime);
 
         this->rxStreamer->issue_stream_cmd(stream_cmd);
 
+        // Keep a chained capture queued behind the current one so the chain
+        // isn't broken
+        if (mode == "finite_more")
+        {
+            stream_cmd.stream_now = true;
+
+            this->rxStreamer->issue_stream_cmd(stream_cmd);
+        }
+
+        this->rxAwaitingFirstSample = true;
+        this->rxCaptureRemaining = stream_cmd.num_samps;
+        this->rxNextTimeValid = false;
+        this->rxPaused = false;
+        this->rxStartRequested = monotonicNanoseconds();
         this->rxStreamStarted = true;
     }
 }
@@ -536,58 +2617,389 @@ void RFNoC_TestComponent_i::stopRxStream()
 
         this->rxStreamer->issue_stream_cmd(stream_cmd);
 
+        this->rxPaused = false;
         this->rxStreamStarted = false;
 
-        // Run recv until nothing is left
+        // Run recv until nothing is left, into the drain buffer. Each recv
+        // waits only briefly, and the drain gives up at the stop deadline.
         uhd::rx_metadata_t md;
         int num_post_samps = 0;
+        uint64_t deadline = monotonicNanoseconds() + uint64_t(std::max(this->stopDeadline, 0.0) * 1e9);
+        bool expired = false;
 
         LOG_DEBUG(RFNoC_TestComponent_i, "Emptying receive queue...");
 
+        for (size_t channel = 0; channel < this->rxRecvBuffers.size(); ++channel)
+        {
+            this->rxRecvBuffers[channel] = this->rxDrainBuffer + channel * this->rxRing->bufferSize();
+        }
+
         do
         {
-            num_post_samps = this->rxStreamer->recv(&this->output.front(), this->output.size(), md, 1.0);
-        } while(num_post_samps and md.error_code == uhd::rx_metadata_t::ERROR_CODE_NONE);
+            num_post_samps = this->rxStreamer->recv(this->rxRecvBuffers, this->rxRing->bufferSize(), md, this->pollTimeout);
+            expired = (monotonicNanoseconds() >= deadline);
+        } while(num_post_samps and md.error_code == uhd::rx_metadata_t::ERROR_CODE_NONE and not expired);
+
+        if (expired and num_post_samps)
+        {
+            LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "RX stream still draining at the stop deadline");
+        }
+        else
+        {
+            LOG_DEBUG(RFNoC_TestComponent_i, "Emptied receive queue");
+        }
+    }
+}
+
+// Ends the open burst of an input stream on the RF-NoC block. This takes an
+// empty send, so it's only used when the end of the burst wasn't known when
+// its last samples were sent, such as another stream taking over the block.
+void RFNoC_TestComponent_i::endTxBurst(TxStreamState *state)
+{
+    std::complex<short> empty;
+
+    transmitSamples(&empty, 0, false, NULL, true, false);
+
+    state->burstOpen = false;
+
+    if (this->txBurstStream == state)
+    {
+        this->txBurstStream = NULL;
+    }
+}
+
+// End any burst left open on the RF-NoC block once the TX threads have
+// stopped, so that the next start begins a fresh burst
+void RFNoC_TestComponent_i::endTxBursts()
+{
+    if (not this->txBurstStream and not this->txSendBurstOpen and not this->txReplayBurstOpen and not this->txSelfTestBurstOpen)
+    {
+        return;
+    }
+
+    std::complex<short> empty;
+
+    sendSamples(&empty, 0, false, NULL, true, false);
+
+    if (this->txBurstStream)
+    {
+        this->txBurstStream->burstOpen = false;
+        this->txBurstStream = NULL;
+    }
+
+    this->txReplayBurstOpen = false;
+    this->txSelfTestBurstOpen = false;
+    this->txSendBurstOpen = false;
+}
+
+// End the burst the TX replay left open when it was replaced or disabled part
+// way through
+void RFNoC_TestComponent_i::endTxReplayBurst()
+{
+    std::complex<short> empty;
+
+    transmitSamples(&empty, 0, false, NULL, true, false);
+
+    this->txReplayBurstOpen = false;
+}
+
+// End the burst the self test left open when it was aborted part way through
+void RFNoC_TestComponent_i::endTxSelfTestBurst()
+{
+    std::complex<short> empty;
+
+    transmitSamples(&empty, 0, false, NULL, true, false);
+
+    this->txSelfTestBurstOpen = false;
+}
+
+// Handle the EOS of an input stream, ending its burst on the RF-NoC block
+bool RFNoC_TestComponent_i::endTxStream(TxStreamState *state)
+{
+    LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "EOS for stream ID: " << state->streamID());
+
+    // Propagate the EOS to the RF-NoC Block
+    if (state->burstOpen)
+    {
+        endTxBurst(state);
+    }
+
+    removeIncomingStream(state->streamID());
+
+    this->txScheduler.remove(state);
+
+    return true;
+}
+
+// A helper method for the RX thread which queues a buffer for the push thread,
+// or returns it to the ring if it is empty. If requested, a fresh buffer is
+// returned to continue receiving into.
+RxBuffer *RFNoC_TestComponent_i::flushRxBuffer(RxBuffer *buffer, bool getNext)
+{
+    if (buffer->size > 0)
+    {
+        if (this->trace.enabled())
+        {
+            buffer->queuedAt = monotonicNanoseconds();
+
+            this->trace.record(LatencyTrace::RX_FILL, buffer->fillStart, buffer->queuedAt, buffer->size);
+        }
+
+        this->rxTap->write(buffer->data, buffer->size, buffer->time);
+        this->rxRing->commit(buffer);
+    }
+    else if (getNext)
+    {
+        return buffer;
+    }
+    else
+    {
+        this->rxRing->release(buffer);
+    }
+
+    return (getNext) ? this->rxRing->acquireFree() : NULL;
+}
+
+// A helper method for issuing the stream command which follows a completed
+// finite capture, if any
+void RFNoC_TestComponent_i::finishRxCapture()
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    const std::string &mode = this->rxActiveControl.mode;
+
+    if (mode == "finite_more")
+    {
+        // The next capture is already queued, so queue the one after it
+        uhd::stream_cmd_t stream_cmd(uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_MORE);
+        stream_cmd.num_samps = this->rxActiveControl.numSamples;
+        stream_cmd.stream_now = true;
+
+        this->rxStreamer->issue_stream_cmd(stream_cmd);
+
+        this->rxCaptureRemaining = stream_cmd.num_samps;
+    }
+    else if (mode == "periodic")
+    {
+        // Schedule the next capture one period after this one started
+        uhd::stream_cmd_t stream_cmd(uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_DONE);
+        stream_cmd.num_samps = this->rxActiveControl.numSamples;
+        stream_cmd.stream_now = false;
+        stream_cmd.time_spec = this->rxCaptureStart + uhd::time_spec_t(this->rxActiveControl.period);
+
+        this->rxStreamer->issue_stream_cmd(stream_cmd);
+
+        this->rxAwaitingFirstSample = true;
+        this->rxCaptureRemaining = stream_cmd.num_samps;
+        this->rxNextTimeValid = false;
+    }
+    else
+    {
+        // The block stops on its own after a single capture, leaving the RX
+        // thread idle until the stream control changes
+        LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "Finite capture complete");
+
+        this->rxStreamStarted = false;
+    }
+}
+
+// The property change listener for the rxStreamControl property. The RX thread
+// applies the change on its next buffer boundary.
+void RFNoC_TestComponent_i::rxStreamControlChanged(const rxStreamControl_struct &oldValue, const rxStreamControl_struct &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    if (newValue.mode != "continuous" and newValue.mode != "finite" and newValue.mode != "finite_more" and newValue.mode != "periodic")
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Invalid RX stream mode " << newValue.mode << ", reverting");
+        this->rxStreamControl = oldValue;
+        return;
+    }
+
+    {
+        boost::mutex::scoped_lock lock(this->rxCommandLock);
+
+        this->rxPendingControl = newValue;
+        this->rxCommandChanged = true;
+    }
+
+    this->rxCommandCondition.notify_all();
+}
+
+// A helper method for the RX thread which reports whether the stream control
+// has changed. If no stream command is outstanding, this waits briefly for a
+// change rather than polling the block.
+bool RFNoC_TestComponent_i::waitForRxStreamControl()
+{
+    boost::mutex::scoped_lock lock(this->rxCommandLock);
+
+    if (not this->rxStreamStarted and not this->rxCommandChanged and not this->rxStopping)
+    {
+        this->rxCommandCondition.timed_wait(lock, boost::posix_time::microseconds(long(this->pollTimeout * 1e6)));
+    }
+
+    return this->rxCommandChanged;
+}
+
+// The property change listener for the waitStrategy property
+void RFNoC_TestComponent_i::waitStrategyChanged(const std::string &oldValue, const std::string &newValue)
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
 
-        LOG_DEBUG(RFNoC_TestComponent_i, "Emptied receive queue");
+    if (not this->rxWait.configure(newValue) or not this->txWait.configure(newValue) or not this->txSendWait.configure(newValue))
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Invalid wait strategy " << newValue << ", reverting");
+        this->waitStrategy = oldValue;
+        this->rxWait.configure(oldValue);
+        this->txWait.configure(oldValue);
+        this->txSendWait.configure(oldValue);
     }
 }
 
-// A helper method for setting arguments on the RF-NoC block.
-bool RFNoC_TestComponent_i::setArgs(std::vector<arg_struct> &newArgs)
+// A helper method for setting arguments on the RF-NoC block. Only the
+// arguments which differ from those last applied are sent, together in one
+// batch, which is rolled back as a whole if the block rejects any of it.
+bool RFNoC_TestComponent_i::setArgs(const std::vector<arg_struct> &newArgs)
 {
     LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
 
     // This should never be necessary, but just in case...
-    if (not this->rfnocBlock)
+    if (not this->rfnocBlock and not this->emulatedBlock)
     {
         LOG_ERROR(RFNoC_TestComponent_i, this->blockID << ": " << "Unable to set new arguments, RF-NoC block is not set");
         return false;
     }
 
-    // Iterate over each argument, keeping track of the indices whose values
-    // were rejected by the block
-    std::vector<size_t> invalidIndices;
+    uhd::device_addr_t args;
 
     for (size_t i = 0; i < newArgs.size(); ++i)
     {
         LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << newArgs[i].id << ": " << newArgs[i].value);
 
-        this->rfnocBlock->set_arg(newArgs[i].id, newArgs[i].value);
+        args[newArgs[i].id] = newArgs[i].value;
+    }
 
-        if (this->rfnocBlock->get_arg(newArgs[i].id) != newArgs[i].value)
-        {
-            LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Failed to set " << newArgs[i].id << " to " << newArgs[i].value);
-            invalidIndices.push_back(i);
-        }
+    std::vector<std::string> warnings;
+    bool applied = this->blockArgs->apply(args, this->verifyArgs, warnings);
+
+    for (size_t i = 0; i < warnings.size(); ++i)
+    {
+        LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << warnings[i]);
     }
 
-    // Iterate over the invalid indices in reverse order to remove the invalid
-    // arguments
-    for (std::vector<size_t>::reverse_iterator i = invalidIndices.rbegin(); i != invalidIndices.rend(); ++i)
+    return applied;
+}
+
+// Set arguments on the RF-NoC block, or its emulation
+void RFNoC_TestComponent_i::setBlockArgs(const uhd::device_addr_t &args)
+{
+    if (this->emulatedBlock)
+    {
+        this->emulatedBlock->setArgs(args);
+    }
+    else
     {
-        this->args.erase(this->args.begin() + *i);
+        this->rfnocBlock->set_args(args);
     }
+}
 
-    return true;
+// A helper method for the pause backpressure policy. A continuous stream is
+// stopped once the RX queue is congested, and restarted once it has drained,
+// with the gap detected like any other. Returns true while the stream is
+// paused, so the RX thread can wait instead of calling recv.
+bool RFNoC_TestComponent_i::pauseRxStreamIfCongested()
+{
+    bool pausing = (this->rxRing->overflowPolicy() == RxBufferRing::PAUSE and this->rxActiveControl.mode == "continuous");
+    bool congested = this->rxRing->congested();
+
+    if (this->rxPaused and (not pausing or not congested))
+    {
+        LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "Resuming the RX stream");
+
+        uhd::stream_cmd_t stream_cmd(uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
+        stream_cmd.stream_now = true;
+
+        this->rxStreamer->issue_stream_cmd(stream_cmd);
+
+        this->rxPaused = false;
+    }
+    else if (not this->rxPaused and pausing and congested)
+    {
+        LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "Pausing the RX stream until the push thread catches up");
+
+        uhd::stream_cmd_t stream_cmd(uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS);
+
+        this->rxStreamer->issue_stream_cmd(stream_cmd);
+
+        this->rxPaused = true;
+        ++this->rxPauses;
+    }
+
+    if (this->rxPaused)
+    {
+        this->rxWait.idle(this->pollTimeout);
+    }
+
+    return this->rxPaused;
+}
+
+// Publish the SRI of an input stream as the SRI of the output stream. The RX
+// push thread pushes it ahead of its next buffer.
+void RFNoC_TestComponent_i::updateOutputSRI(const BULKIO::StreamSRI &inputSRI)
+{
+    this->sriPublisher.setSRI(inputSRI);
+
+    LOG_DEBUG(RFNoC_TestComponent_i, "Published the output SRI");
+
+    // Wake the RX thread if it's waiting on the SRI
+    this->rxWait.notify();
+}
+
+// A helper method for choosing the number of samples to receive per pushed
+// packet. The result is always a whole number of spp sized packets and never
+// exceeds the preallocated RX buffer size.
+void RFNoC_TestComponent_i::updateRxTransferSize()
+{
+    LOG_TRACE(RFNoC_TestComponent_i, this->blockID << ": " << __PRETTY_FUNCTION__);
+
+    // Find the rate the block is producing samples at
+    double rate = uhd::rfnoc::rate_node_ctrl::RATE_UNDEFINED;
+    uhd::rfnoc::rate_node_ctrl::sptr rateNode = boost::dynamic_pointer_cast<uhd::rfnoc::rate_node_ctrl>(this->rfnocBlock);
+
+    if (rateNode)
+    {
+        rate = rateNode->get_output_samp_rate();
+    }
+
+    this->rxSampleRate = rate;
+
+    // The output SRI's xdelta follows the block's rate
+    this->sriPublisher.setSampleRate((rate > 0) ? rate : 0);
+
+    size_t packetSize = std::max(this->spp, size_t(1));
+    size_t maxPackets = std::max(this->rxBufferSize / packetSize, size_t(1));
+    size_t numPackets = maxPackets;
+
+    if (this->rxTransferMode == "packets")
+    {
+        numPackets = this->rxTransferPackets;
+    }
+    else if (this->rxTransferMode == "latency")
+    {
+        if (rate > 0)
+        {
+            numPackets = (this->rxLatencyBudget * 1e-6 * rate) / packetSize;
+        }
+        else
+        {
+            LOG_WARN(RFNoC_TestComponent_i, this->blockID << ": " << "Unable to determine the block's rate, using maximum RX transfer size");
+        }
+    }
+
+    numPackets = std::min(std::max(numPackets, size_t(1)), maxPackets);
+
+    this->rxTransferSamples = std::min(numPackets * packetSize, this->rxBufferSize);
+    this->rxTransferSize = this->rxTransferSamples;
+
+    LOG_DEBUG(RFNoC_TestComponent_i, this->blockID << ": " << "RX transfer size set to " << this->rxTransferSize << " samples");
 }
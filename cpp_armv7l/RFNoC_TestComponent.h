@@ -4,15 +4,47 @@
 // Base Include(s)
 #include "RFNoC_TestComponent_base.h"
 
+// Local Include(s)
+#include "BlockArgs.h"
+#include "CaptureTap.h"
+#include "EmulatedBlock.h"
+#include "HotPathLogging.h"
+#include "LatencyTrace.h"
+#include "LoopbackSelfTest.h"
+#include "PerformanceCounters.h"
+#include "PortMonitor.h"
+#include "RxBufferRing.h"
+#include "SampleBufferPool.h"
+#include "SampleConversion.h"
+#include "SriPublisher.h"
+#include "ThreadPolicy.h"
+#include "TxBufferRing.h"
+#include "TxReplaySource.h"
+#include "TxStreamScheduler.h"
+#include "WaitStrategy.h"
+
 // RF-NoC RH Include(s)
 #include <GenericThreadedComponent.h>
 #include <RFNoC_Component.h>
 
+// Boost Include(s)
+#include <boost/atomic.hpp>
+
 // UHD Include(s)
 #include <uhd/rfnoc/block_ctrl.hpp>
 #include <uhd/rfnoc/graph.hpp>
+#include <uhd/rfnoc/rate_node_ctrl.hpp>
 #include <uhd/device3.hpp>
 
+/*
+ * The port an input stream arrived on, and its latest SRI
+ */
+struct IncomingStream
+{
+    size_t portHash;
+    BULKIO::StreamSRI sri;
+};
+
 /*
  * The class for the component
  */
@@ -20,6 +52,9 @@ class RFNoC_TestComponent_i : public RFNoC_TestComponent_base, public RFNoC_RH::
 {
     ENABLE_LOGGING
 
+    // The hardware-free benchmark drives the streaming paths directly
+    friend class ComponentBenchmark;
+
 	// Constructor(s) and/or Destructor
     public:
         RFNoC_TestComponent_i(const char *uuid, const char *label);
@@ -49,37 +84,244 @@ class RFNoC_TestComponent_i : public RFNoC_TestComponent_base, public RFNoC_RH::
 
         int rxServiceFunction();
 
+        int rxPushServiceFunction();
+
+        int txAsyncServiceFunction();
+
+        int txSendServiceFunction();
+
         int txServiceFunction();
 
     // Private Method(s)
     private:
+        bool addIncomingStream(const std::string &streamID, const BULKIO::StreamSRI &inputSRI, size_t portHash);
+
         void argsChanged(const std::vector<arg_struct> &oldValue, const std::vector<arg_struct> &newValue);
 
+        size_t blockPortForSRI(const BULKIO::StreamSRI &sri);
+
+        void bufferPoolChanged(const bufferPool_struct &oldValue, const bufferPool_struct &newValue);
+
+        void cancelRxThreads();
+
+        void cancelTxThreads();
+
+        void endTxBurst(TxStreamState *state);
+
+        void endTxBursts();
+
+        void endTxReplayBurst();
+
+        void endTxSelfTestBurst();
+
+        bool endTxStream(TxStreamState *state);
+
+        void finishRxCapture();
+
+        void floatStreamChanged(bulkio::InFloatPort::StreamType stream);
+
+        RxBuffer *flushRxBuffer(RxBuffer *buffer, bool getNext);
+
+        uhd::device_addr_t getBlockArgs();
+
+        std::string getBlockEmulationStatus();
+
+        std::string getBufferPoolStatus();
+
+        std::string getLatencyTraceStatus();
+
+        performance_struct getPerformance();
+
+        std::string getRxBackpressureStatus();
+
+        CORBA::ULong getRxDroppedBuffers();
+
+        std::string getRxCaptureStatus();
+
+        selfTestResults_struct getSelfTestResults();
+
+        std::string getSelfTestStatus();
+
+        CORBA::ULong getRxQueueDepth();
+
+        std::string getThreadPolicyStatus();
+
+        std::string getTxReplayStatus();
+
+        void hotPathLogChanged(const CORBA::ULong &oldValue, const CORBA::ULong &newValue);
+
+        void initializeStreaming();
+
+        void latencyTraceChanged(const latencyTrace_struct &oldValue, const latencyTrace_struct &newValue);
+
+        void latencyTraceExportChanged(const bool &oldValue, const bool &newValue);
+
+        void lockMemoryChanged(const bool &oldValue, const bool &newValue);
+
+        void logThreadPolicy(const std::string &threadName, const ThreadPolicy &policy);
+
         void newConnection(const char *connectionID);
 
         void newDisconnection(const char *connectionID);
 
-        bool setArgs(std::vector<arg_struct> &newArgs);
+        void newFloatConnection(const char *connectionID);
+
+        void newFloatDisconnection(const char *connectionID);
+
+        void openRxCapture();
+
+        void openTxReplay();
+
+        bool pauseRxStreamIfCongested();
+
+        void queueTxSamples(const std::complex<short> *samples, size_t numSamples, bool startOfBurst, const uhd::time_spec_t *time, bool endOfBurst, size_t port = 0);
+
+        void removeIncomingStream(const std::string &streamID);
+
+        void rxBackpressureChanged(const rxBackpressure_struct &oldValue, const rxBackpressure_struct &newValue);
+
+        void rxCaptureChanged(const rxCapture_struct &oldValue, const rxCapture_struct &newValue);
+
+        void rxCaptureTriggerChanged(const bool &oldValue, const bool &newValue);
+
+        void rxLatencyBudgetChanged(const double &oldValue, const double &newValue);
+
+        void rxStreamControlChanged(const rxStreamControl_struct &oldValue, const rxStreamControl_struct &newValue);
+
+        void rxThreadPolicyChanged(const rxThreadPolicy_struct &oldValue, const rxThreadPolicy_struct &newValue);
+
+        void rxTransferModeChanged(const std::string &oldValue, const std::string &newValue);
+
+        void rxTransferPacketsChanged(const CORBA::ULong &oldValue, const CORBA::ULong &newValue);
+
+        uhd::time_spec_t scheduleTxBurst(const BULKIO::PrecisionUTCTime &time);
+
+        void selfTestChanged(const selfTest_struct &oldValue, const selfTest_struct &newValue);
+
+        void selfTestRunChanged(const bool &oldValue, const bool &newValue);
+
+        void sendSamples(const std::complex<short> *samples, size_t numSamples, bool startOfBurst, const uhd::time_spec_t *time, bool endOfBurst, bool logSends, size_t port = 0);
+
+        template <typename BlockType>
+        bool sendTxBlock(TxStreamState *state, const BlockType &block, const std::complex<short> *samples, bool endOfStream);
+
+        void serviceSelfTest();
+
+        void serviceTxReplay(TxReplaySource &replay);
+
+        bool serviceTxStream(TxStreamState *state);
+
+        bool setArgs(const std::vector<arg_struct> &newArgs);
+
+        void setBlockArgs(const uhd::device_addr_t &args);
 
         void startRxStream();
 
+        void stopDeadlineChanged(const double &oldValue, const double &newValue);
+
         void stopRxStream();
 
         void streamChanged(bulkio::InShortPort::StreamType stream);
 
+        void transmitSamples(const std::complex<short> *samples, size_t numSamples, bool startOfBurst, const uhd::time_spec_t *time, bool endOfBurst, bool logSends, size_t port = 0);
+
+        void txBurstControlChanged(const txBurstControl_struct &oldValue, const txBurstControl_struct &newValue);
+
+        void txQueuePolicyChanged(const std::string &oldValue, const std::string &newValue);
+
+        void txReplayChanged(const txReplay_struct &oldValue, const txReplay_struct &newValue);
+
+        void txThreadPolicyChanged(const txThreadPolicy_struct &oldValue, const txThreadPolicy_struct &newValue);
+
+        void updateOutputSRI(const BULKIO::StreamSRI &inputSRI);
+
+        void updateRxTransferSize();
+
+        bool waitForRxStreamControl();
+
+        void waitStrategyChanged(const std::string &oldValue, const std::string &newValue);
+
     // Private Member(s)
     private:
-        std::vector<std::complex<short> > output;
-        bool receivedSRI;
+        boost::shared_ptr<BlockArgs> blockArgs;
+        PerformanceCounters counters;
+        boost::shared_ptr<EmulatedBlock> emulatedBlock;
+        boost::atomic<int> floatOutputConnections;
+        boost::shared_ptr<LoopbackSelfTest> loopbackTest;
+        std::string memoryLockStatus;
+        boost::mutex memoryStatusLock;
+        boost::atomic<double> pollTimeout;
+        PortMonitor portMonitor;
         uhd::rfnoc::block_ctrl_base::sptr rfnocBlock;
+        rxStreamControl_struct rxActiveControl;
+        bool rxAwaitingFirstSample;
+        size_t rxBufferSize;
+        size_t rxCaptureRemaining;
+        uhd::time_spec_t rxCaptureStart;
+        bool rxCommandChanged;
+        boost::condition_variable rxCommandCondition;
+        boost::mutex rxCommandLock;
+        std::complex<short> *rxDrainBuffer;
+        float *rxFloatBuffer;
+        size_t rxFloatPort;
+        bool rxGapCounted;
+        LogSampler rxLogSampler;
+        uhd::time_spec_t rxNextTime;
+        bool rxNextTimeValid;
+        bool rxPaused;
+        boost::atomic<uint64_t> rxPauses;
+        rxStreamControl_struct rxPendingControl;
+        ThreadPolicy rxPolicy;
+        uint64_t rxPushedGeneration;
+        boost::shared_ptr<RFNoC_RH::GenericThreadedComponent> rxPushThread;
+        std::vector<void *> rxRecvBuffers;
+        boost::shared_ptr<RxBufferRing> rxRing;
+        boost::atomic<double> rxSampleRate;
+        size_t rxShortPort;
+        uint64_t rxStartRequested;
+        boost::atomic<bool> rxStopping;
         uhd::rx_streamer::sptr rxStreamer;
         bool rxStreamStarted;
+        boost::shared_ptr<CaptureTap> rxTap;
         boost::shared_ptr<RFNoC_RH::GenericThreadedComponent> rxThread;
+        boost::atomic<size_t> rxTransferSamples;
+        WaitStrategy rxWait;
+        SampleBufferPool samplePool;
+        boost::atomic<int> shortOutputConnections;
         size_t spp;
-        BULKIO::StreamSRI sri;
-        std::map<std::string, bool> streamMap;
+        SriPublisher sriPublisher;
+        std::string sriStreamID;
+        boost::mutex streamLock;
+        std::map<std::string, IncomingStream> streamMap;
+        LatencyTrace trace;
+        boost::atomic<bool> txAdaptiveLeadTime;
+        boost::shared_ptr<RFNoC_RH::GenericThreadedComponent> txAsyncThread;
+        size_t txBatchSize;
+        TxStreamState *txBurstStream;
+        size_t txChannels;
+        short *txConvertBuffer;
+        size_t txConvertSize;
+        boost::atomic<double> txLeadTime;
+        LogSampler txLogSampler;
+        boost::atomic<double> txMaxLeadTime;
+        ThreadPolicy txPolicy;
+        boost::shared_ptr<TxBufferRing> txQueue;
+        bool txReplayBurstOpen;
+        boost::mutex txReplayLock;
+        boost::shared_ptr<TxReplaySource> txReplaySource;
+        TxStreamScheduler txScheduler;
+        bool txSelfTestBurstOpen;
+        std::vector<const void *> txSendBuffers;
+        bool txSendBurstOpen;
+        boost::shared_ptr<RFNoC_RH::GenericThreadedComponent> txSendThread;
+        WaitStrategy txSendWait;
+        boost::atomic<bool> txStopping;
         uhd::tx_streamer::sptr txStreamer;
         boost::shared_ptr<RFNoC_RH::GenericThreadedComponent> txThread;
+        WaitStrategy txWait;
+        bool txWaitOnFloat;
+        std::complex<short> *txZeroBuffer;
+        size_t txZeroSize;
 };
 
 #endif
@@ -18,16 +18,24 @@ RFNoC_TestComponent_base::RFNoC_TestComponent_base(const char *uuid, const char
 
     dataShort_in = new bulkio::InShortPort("dataShort_in");
     addPort("dataShort_in", dataShort_in);
+    dataFloat_in = new bulkio::InFloatPort("dataFloat_in");
+    addPort("dataFloat_in", dataFloat_in);
     dataShort_out = new bulkio::OutShortPort("dataShort_out");
     addPort("dataShort_out", dataShort_out);
+    dataFloat_out = new bulkio::OutFloatPort("dataFloat_out");
+    addPort("dataFloat_out", dataFloat_out);
 }
 
 RFNoC_TestComponent_base::~RFNoC_TestComponent_base()
 {
     delete dataShort_in;
     dataShort_in = 0;
+    delete dataFloat_in;
+    dataFloat_in = 0;
     delete dataShort_out;
     dataShort_out = 0;
+    delete dataFloat_out;
+    dataFloat_out = 0;
 }
 
 /*******************************************************************************************
@@ -79,6 +87,376 @@ void RFNoC_TestComponent_base::loadProperties()
                 "external",
                 "property");
 
+    addProperty(performance,
+                performance_struct(),
+                "performance",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(hotPathLogInterval,
+                1,
+                "hotPathLogInterval",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(hotPathLogRate,
+                10,
+                "hotPathLogRate",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxBufferCount,
+                8,
+                "rxBufferCount",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxTransferMode,
+                "throughput",
+                "rxTransferMode",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxTransferPackets,
+                16,
+                "rxTransferPackets",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxLatencyBudget,
+                10000.0,
+                "rxLatencyBudget",
+                "",
+                "readwrite",
+                "us",
+                "external",
+                "property");
+
+    addProperty(rxTransferSize,
+                0,
+                "rxTransferSize",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxQueueDepth,
+                0,
+                "rxQueueDepth",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxDroppedBuffers,
+                0,
+                "rxDroppedBuffers",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxStreamControl,
+                rxStreamControl_struct(),
+                "rxStreamControl",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(waitStrategy,
+                "event",
+                "waitStrategy",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(otwFormat,
+                "sc16",
+                "otwFormat",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(floatScale,
+                3.0517578125e-05,
+                "floatScale",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxThreadPolicy,
+                rxThreadPolicy_struct(),
+                "rxThreadPolicy",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(txThreadPolicy,
+                txThreadPolicy_struct(),
+                "txThreadPolicy",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(lockMemory,
+                false,
+                "lockMemory",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(threadPolicyStatus,
+                "threadPolicyStatus",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(txBurstControl,
+                txBurstControl_struct(),
+                "txBurstControl",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(txQueueDepth,
+                0,
+                "txQueueDepth",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(txQueuePolicy,
+                "block",
+                "txQueuePolicy",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(stopDeadline,
+                0.5,
+                "stopDeadline",
+                "",
+                "readwrite",
+                "s",
+                "external",
+                "property");
+
+    addProperty(verifyArgs,
+                true,
+                "verifyArgs",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(bufferPool,
+                bufferPool_struct(),
+                "bufferPool",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(bufferPoolStatus,
+                "bufferPoolStatus",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxCapture,
+                rxCapture_struct(),
+                "rxCapture",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxCaptureTrigger,
+                false,
+                "rxCaptureTrigger",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxCaptureStatus,
+                "rxCaptureStatus",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(txReplay,
+                txReplay_struct(),
+                "txReplay",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(txReplayStatus,
+                "txReplayStatus",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(latencyTrace,
+                latencyTrace_struct(),
+                "latencyTrace",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(latencyTraceExport,
+                false,
+                "latencyTraceExport",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(latencyTraceStatus,
+                "latencyTraceStatus",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(selfTest,
+                selfTest_struct(),
+                "selfTest",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(selfTestRun,
+                false,
+                "selfTestRun",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(selfTestStatus,
+                "selfTestStatus",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(selfTestResults,
+                selfTestResults_struct(),
+                "selfTestResults",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(blockEmulation,
+                "never",
+                "blockEmulation",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(blockEmulationStatus,
+                "blockEmulationStatus",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(blockPorts,
+                1,
+                "blockPorts",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxBackpressure,
+                rxBackpressure_struct(),
+                "rxBackpressure",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(rxBackpressureStatus,
+                "rxBackpressureStatus",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
 }
 
 
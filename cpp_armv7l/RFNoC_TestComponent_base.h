@@ -28,12 +28,100 @@ class RFNoC_TestComponent_base : public Component, protected ThreadedComponent
         std::string blockID;
         /// Property: args
         std::vector<arg_struct> args;
+        /// Property: performance
+        performance_struct performance;
+        /// Property: hotPathLogInterval
+        CORBA::ULong hotPathLogInterval;
+        /// Property: hotPathLogRate
+        CORBA::ULong hotPathLogRate;
+        /// Property: rxBufferCount
+        CORBA::ULong rxBufferCount;
+        /// Property: rxTransferMode
+        std::string rxTransferMode;
+        /// Property: rxTransferPackets
+        CORBA::ULong rxTransferPackets;
+        /// Property: rxLatencyBudget
+        double rxLatencyBudget;
+        /// Property: rxTransferSize
+        CORBA::ULong rxTransferSize;
+        /// Property: rxQueueDepth
+        CORBA::ULong rxQueueDepth;
+        /// Property: rxDroppedBuffers
+        CORBA::ULong rxDroppedBuffers;
+        /// Property: rxStreamControl
+        rxStreamControl_struct rxStreamControl;
+        /// Property: waitStrategy
+        std::string waitStrategy;
+        /// Property: otwFormat
+        std::string otwFormat;
+        /// Property: floatScale
+        float floatScale;
+        /// Property: rxThreadPolicy
+        rxThreadPolicy_struct rxThreadPolicy;
+        /// Property: txThreadPolicy
+        txThreadPolicy_struct txThreadPolicy;
+        /// Property: lockMemory
+        bool lockMemory;
+        /// Property: threadPolicyStatus
+        std::string threadPolicyStatus;
+        /// Property: txBurstControl
+        txBurstControl_struct txBurstControl;
+        /// Property: txQueueDepth
+        CORBA::ULong txQueueDepth;
+        /// Property: txQueuePolicy
+        std::string txQueuePolicy;
+        /// Property: stopDeadline
+        double stopDeadline;
+        /// Property: verifyArgs
+        bool verifyArgs;
+        /// Property: bufferPool
+        bufferPool_struct bufferPool;
+        /// Property: bufferPoolStatus
+        std::string bufferPoolStatus;
+        /// Property: rxCapture
+        rxCapture_struct rxCapture;
+        /// Property: rxCaptureTrigger
+        bool rxCaptureTrigger;
+        /// Property: rxCaptureStatus
+        std::string rxCaptureStatus;
+        /// Property: txReplay
+        txReplay_struct txReplay;
+        /// Property: txReplayStatus
+        std::string txReplayStatus;
+        /// Property: latencyTrace
+        latencyTrace_struct latencyTrace;
+        /// Property: latencyTraceExport
+        bool latencyTraceExport;
+        /// Property: latencyTraceStatus
+        std::string latencyTraceStatus;
+        /// Property: selfTest
+        selfTest_struct selfTest;
+        /// Property: selfTestRun
+        bool selfTestRun;
+        /// Property: selfTestStatus
+        std::string selfTestStatus;
+        /// Property: selfTestResults
+        selfTestResults_struct selfTestResults;
+        /// Property: blockEmulation
+        std::string blockEmulation;
+        /// Property: blockEmulationStatus
+        std::string blockEmulationStatus;
+        /// Property: blockPorts
+        CORBA::ULong blockPorts;
+        /// Property: rxBackpressure
+        rxBackpressure_struct rxBackpressure;
+        /// Property: rxBackpressureStatus
+        std::string rxBackpressureStatus;
 
         // Ports
         /// Port: dataShort_in
         bulkio::InShortPort *dataShort_in;
+        /// Port: dataFloat_in
+        bulkio::InFloatPort *dataFloat_in;
         /// Port: dataShort_out
         bulkio::OutShortPort *dataShort_out;
+        /// Port: dataFloat_out
+        bulkio::OutFloatPort *dataFloat_out;
 
     private:
 };
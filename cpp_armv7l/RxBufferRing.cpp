@@ -0,0 +1,352 @@
+// Class Include
+#include "RxBufferRing.h"
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+
+// Standard Include(s)
+#include <cmath>
+
+// How long a blocked recv side waits for a free buffer before it reclaims the
+// oldest queued one instead
+const double RxBufferRing::BLOCK_TIMEOUT = 1.0;
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+// Preallocate every buffer up front so that steady state streaming never
+// touches the heap. At least three are needed: one being filled, one being
+// pushed, and one to split a buffer into at a discontinuity.
+RxBufferRing::RxBufferRing(SampleBufferPool &pool, size_t numBuffers, size_t bufferSize, size_t numChannels) :
+    blockedNanoseconds(0),
+    blockTimeoutCount(0),
+    buffers(std::max(numBuffers, size_t(3))),
+    bufferSamples(bufferSize),
+    cancelled(false),
+    channelCount(std::max(numChannels, size_t(1))),
+    congestedState(false),
+    decimatedBuffers(0),
+    decimateSkip(false),
+    droppedBuffers(0),
+    freeBuffers(buffers.size()),
+    fullBuffers(buffers.size()),
+    highWatermark(buffers.size()),
+    lowWatermark(0),
+    policy(DROP_OLDEST),
+    pool(pool)
+{
+    for (size_t i = 0; i < this->buffers.size(); ++i)
+    {
+        this->buffers[i].data = pool.acquire<std::complex<short> >(bufferSize * this->channelCount);
+        this->buffers[i].size = 0;
+        this->buffers[i].endOfBurst = false;
+        this->buffers[i].fillStart = 0;
+        this->buffers[i].queuedAt = 0;
+
+        this->freeBuffers.push_back(&this->buffers[i]);
+    }
+
+    setWatermarks(0.25, 0.75);
+}
+
+// Return the buffers to the pool
+RxBufferRing::~RxBufferRing()
+{
+    for (size_t i = 0; i < this->buffers.size(); ++i)
+    {
+        this->pool.release(this->buffers[i].data);
+    }
+}
+
+/*
+ * Public Method(s)
+ */
+
+// Wake any wait on either side at once, and keep later ones from waiting
+// until the ring is cleared. A blocked recv side goes on to reclaim the oldest
+// queued buffer.
+void RxBufferRing::cancel()
+{
+    {
+        boost::mutex::scoped_lock lock(this->bufferLock);
+
+        this->cancelled.store(true);
+    }
+
+    this->freeCondition.notify_all();
+    this->fullCondition.notify_all();
+}
+
+// Select the overflow policy by name, returning false if it isn't recognized
+bool RxBufferRing::configure(const std::string &policy)
+{
+    if (policy == "block")
+    {
+        this->policy = BLOCK;
+    }
+    else if (policy == "dropOldest")
+    {
+        this->policy = DROP_OLDEST;
+    }
+    else if (policy == "decimate")
+    {
+        this->policy = DECIMATE;
+    }
+    else if (policy == "pause")
+    {
+        this->policy = PAUSE;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+RxBufferRing::OverflowPolicy RxBufferRing::overflowPolicy() const
+{
+    return OverflowPolicy(this->policy.load(boost::memory_order_relaxed));
+}
+
+// Set the watermarks as fractions of the ring. The high watermark is at least
+// one buffer, and the low one is always below it.
+void RxBufferRing::setWatermarks(double low, double high)
+{
+    boost::mutex::scoped_lock lock(this->bufferLock);
+
+    size_t capacity = this->buffers.size();
+
+    this->highWatermark = std::min(std::max(size_t(std::ceil(high * capacity)), size_t(1)), capacity);
+    this->lowWatermark = std::min(size_t(std::max(low, 0.0) * capacity), this->highWatermark - 1);
+}
+
+// Get an empty buffer to fill. If none are free, reclaim the oldest buffer
+// which has not yet been pushed, after waiting for one to be freed if the
+// policy is to block.
+RxBuffer *RxBufferRing::acquireFree()
+{
+    boost::mutex::scoped_lock lock(this->bufferLock);
+
+    RxBuffer *buffer = NULL;
+    bool blocked = false;
+
+    if (this->freeBuffers.empty() and not this->fullBuffers.empty() and OverflowPolicy(this->policy.load(boost::memory_order_relaxed)) == BLOCK)
+    {
+        blocked = true;
+
+        uint64_t blockStart = monotonicNanoseconds();
+        boost::system_time deadline = boost::get_system_time() + boost::posix_time::microseconds(long(BLOCK_TIMEOUT * 1e6));
+
+        while (this->freeBuffers.empty() and not this->cancelled.load(boost::memory_order_relaxed))
+        {
+            if (not this->freeCondition.timed_wait(lock, deadline))
+            {
+                break;
+            }
+        }
+
+        this->blockedNanoseconds += monotonicNanoseconds() - blockStart;
+    }
+
+    if (not this->freeBuffers.empty())
+    {
+        buffer = this->freeBuffers.front();
+        this->freeBuffers.pop_front();
+    }
+    else if (not this->fullBuffers.empty())
+    {
+        buffer = this->fullBuffers.front();
+        this->fullBuffers.pop_front();
+
+        ++this->droppedBuffers;
+
+        // A block which timed out, rather than being cancelled, falls back to
+        // dropping the oldest buffer, which is counted on its own
+        if (blocked and not this->cancelled.load(boost::memory_order_relaxed))
+        {
+            ++this->blockTimeoutCount;
+        }
+    }
+
+    if (buffer)
+    {
+        buffer->size = 0;
+        buffer->endOfBurst = false;
+        buffer->queuedAt = 0;
+    }
+
+    return buffer;
+}
+
+// Queue a filled buffer to be pushed. While congested under the decimate
+// policy, every other buffer is freed instead. Returns true if the buffer was
+// queued.
+bool RxBufferRing::commit(RxBuffer *buffer)
+{
+    {
+        boost::mutex::scoped_lock lock(this->bufferLock);
+
+        if (this->congestedState and OverflowPolicy(this->policy.load(boost::memory_order_relaxed)) == DECIMATE)
+        {
+            this->decimateSkip = not this->decimateSkip;
+
+            if (this->decimateSkip)
+            {
+                this->freeBuffers.push_back(buffer);
+
+                ++this->decimatedBuffers;
+
+                return false;
+            }
+        }
+
+        this->fullBuffers.push_back(buffer);
+
+        if (this->fullBuffers.size() >= this->highWatermark)
+        {
+            this->congestedState = true;
+        }
+    }
+
+    this->fullCondition.notify_one();
+
+    return true;
+}
+
+// Wait up to timeout seconds for a filled buffer
+RxBuffer *RxBufferRing::acquireFull(double timeout)
+{
+    boost::mutex::scoped_lock lock(this->bufferLock);
+
+    if (this->fullBuffers.empty())
+    {
+        boost::system_time deadline = boost::get_system_time() + boost::posix_time::microseconds(long(timeout * 1e6));
+
+        while (this->fullBuffers.empty() and not this->cancelled.load(boost::memory_order_relaxed))
+        {
+            if (not this->fullCondition.timed_wait(lock, deadline))
+            {
+                break;
+            }
+        }
+
+        if (this->fullBuffers.empty())
+        {
+            return NULL;
+        }
+    }
+
+    RxBuffer *buffer = this->fullBuffers.front();
+    this->fullBuffers.pop_front();
+
+    if (this->fullBuffers.size() <= this->lowWatermark)
+    {
+        this->congestedState = false;
+        this->decimateSkip = false;
+    }
+
+    return buffer;
+}
+
+// Return a buffer to the free list, whether or not it was used
+void RxBufferRing::release(RxBuffer *buffer)
+{
+    {
+        boost::mutex::scoped_lock lock(this->bufferLock);
+
+        this->freeBuffers.push_back(buffer);
+    }
+
+    this->freeCondition.notify_one();
+}
+
+// The total time the recv side has spent waiting for a free buffer, in
+// seconds
+double RxBufferRing::blockedTime() const
+{
+    boost::mutex::scoped_lock lock(this->bufferLock);
+
+    return this->blockedNanoseconds / 1e9;
+}
+
+// The number of times the block policy gave up waiting for a free buffer and
+// reclaimed the oldest queued one instead
+uint64_t RxBufferRing::blockTimeouts() const
+{
+    boost::mutex::scoped_lock lock(this->bufferLock);
+
+    return this->blockTimeoutCount;
+}
+
+// The number of samples each buffer can hold
+size_t RxBufferRing::bufferSize() const
+{
+    return this->bufferSamples;
+}
+
+// The number of buffers in the ring
+size_t RxBufferRing::capacity() const
+{
+    return this->buffers.size();
+}
+
+// The number of channels each buffer holds
+size_t RxBufferRing::channels() const
+{
+    return this->channelCount;
+}
+
+// Discard any buffers waiting to be pushed, and lift a cancel
+void RxBufferRing::clear()
+{
+    {
+        boost::mutex::scoped_lock lock(this->bufferLock);
+
+        while (not this->fullBuffers.empty())
+        {
+            this->freeBuffers.push_back(this->fullBuffers.front());
+            this->fullBuffers.pop_front();
+        }
+
+        this->cancelled.store(false);
+        this->congestedState = false;
+        this->decimateSkip = false;
+    }
+
+    this->freeCondition.notify_all();
+}
+
+// Whether the queued buffers have reached the high watermark and not yet
+// fallen back to the low one
+bool RxBufferRing::congested() const
+{
+    boost::mutex::scoped_lock lock(this->bufferLock);
+
+    return this->congestedState;
+}
+
+// The number of buffers freed rather than queued by the decimate policy
+uint64_t RxBufferRing::decimated() const
+{
+    boost::mutex::scoped_lock lock(this->bufferLock);
+
+    return this->decimatedBuffers;
+}
+
+// The number of buffers waiting to be pushed
+size_t RxBufferRing::depth() const
+{
+    boost::mutex::scoped_lock lock(this->bufferLock);
+
+    return this->fullBuffers.size();
+}
+
+// The number of buffers reclaimed before they could be pushed
+uint64_t RxBufferRing::dropped() const
+{
+    boost::mutex::scoped_lock lock(this->bufferLock);
+
+    return this->droppedBuffers;
+}
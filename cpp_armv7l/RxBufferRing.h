@@ -0,0 +1,142 @@
+#ifndef RXBUFFERRING_H
+#define RXBUFFERRING_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/circular_buffer.hpp>
+#include <boost/thread.hpp>
+
+// UHD Include(s)
+#include <uhd/types/time_spec.hpp>
+
+// Local Include(s)
+#include "SampleBufferPool.h"
+
+// Standard Include(s)
+#include <algorithm>
+#include <complex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * A single preallocated RX buffer along with the metadata describing its
+ * contents. The monotonic times of its first recv and of being queued are
+ * kept for the latency trace, and the latter is zero when not tracing. A
+ * buffer for several channels holds each in turn, a buffer size apart, and
+ * the size is that of each channel.
+ */
+struct RxBuffer
+{
+    std::complex<short> *data;
+    size_t size;
+    uhd::time_spec_t time;
+    bool endOfBurst;
+    uint64_t fillStart;
+    uint64_t queuedAt;
+};
+
+/*
+ * A fixed ring of preallocated RX buffers used to hand data from the thread
+ * calling recv to the thread calling pushPacket. The buffers are taken from a
+ * sample buffer pool, which they're returned to on destruction, and no memory
+ * is allocated in between.
+ *
+ * The ring is congested from when the queued buffers reach the high watermark
+ * until they fall back to the low one. The overflow policy decides what the
+ * recv side does about it: "dropOldest" only acts once every buffer is
+ * queued, reclaiming the oldest, "block" waits for the push side instead, for
+ * up to a second, and "decimate" queues every other buffer while congested.
+ * "pause" is left to the caller, which stops the stream while congested. Every
+ * policy falls back to reclaiming the oldest buffer when full, block only once
+ * its wait times out, and each outcome is counted. A block which timed out is
+ * counted on its own as well, as under a long stall it drops like dropOldest.
+ */
+class RxBufferRing
+{
+    public:
+        enum OverflowPolicy
+        {
+            BLOCK,
+            DROP_OLDEST,
+            DECIMATE,
+            PAUSE
+        };
+
+        RxBufferRing(SampleBufferPool &pool, size_t numBuffers, size_t bufferSize, size_t numChannels = 1);
+
+        ~RxBufferRing();
+
+    // Public Method(s)
+    public:
+        // Methods for any thread
+        void cancel();
+
+        bool configure(const std::string &policy);
+
+        OverflowPolicy overflowPolicy() const;
+
+        void setWatermarks(double low, double high);
+
+        // Methods for the thread filling buffers
+        RxBuffer *acquireFree();
+
+        bool commit(RxBuffer *buffer);
+
+        // Methods for the thread draining buffers
+        RxBuffer *acquireFull(double timeout);
+
+        void release(RxBuffer *buffer);
+
+        // Bookkeeping, clear also lifts a cancel
+        double blockedTime() const;
+
+        uint64_t blockTimeouts() const;
+
+        size_t bufferSize() const;
+
+        size_t capacity() const;
+
+        size_t channels() const;
+
+        std::complex<short> *channelData(RxBuffer *buffer, size_t channel) const
+        {
+            return buffer->data + channel * this->bufferSamples;
+        }
+
+        void clear();
+
+        bool congested() const;
+
+        uint64_t decimated() const;
+
+        size_t depth() const;
+
+        uint64_t dropped() const;
+
+    // Private Member(s)
+    private:
+        static const double BLOCK_TIMEOUT;
+
+        uint64_t blockedNanoseconds;
+        uint64_t blockTimeoutCount;
+        std::vector<RxBuffer> buffers;
+        size_t bufferSamples;
+        boost::atomic<bool> cancelled;
+        size_t channelCount;
+        bool congestedState;
+        uint64_t decimatedBuffers;
+        bool decimateSkip;
+        uint64_t droppedBuffers;
+        boost::condition_variable freeCondition;
+        boost::circular_buffer<RxBuffer *> freeBuffers;
+        boost::condition_variable fullCondition;
+        boost::circular_buffer<RxBuffer *> fullBuffers;
+        size_t highWatermark;
+        mutable boost::mutex bufferLock;
+        size_t lowWatermark;
+        boost::atomic<int> policy;
+        SampleBufferPool &pool;
+};
+
+#endif
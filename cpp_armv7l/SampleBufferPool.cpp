@@ -0,0 +1,275 @@
+// Class Include
+#include "SampleBufferPool.h"
+
+// Boost Include(s)
+#include <boost/lexical_cast.hpp>
+
+// Standard Include(s)
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+
+// Definitions for the constants passed by reference
+const size_t SampleBufferPool::MIN_SLAB_SIZE;
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+SampleBufferPool::SampleBufferPool() :
+    exhaustionCount(0),
+    highWater(0),
+    hugePages(false),
+    inUse(0),
+    limit(0),
+    lockPages(false),
+    reserved(0)
+{
+}
+
+// Every buffer should have been released by now, but the memory is returned
+// regardless
+SampleBufferPool::~SampleBufferPool()
+{
+    for (std::map<void *, size_t>::iterator i = this->heapBuffers.begin(); i != this->heapBuffers.end(); ++i)
+    {
+        free(i->first);
+    }
+
+    for (size_t i = 0; i < this->slabs.size(); ++i)
+    {
+        munmap(this->slabs[i].address, this->slabs[i].size);
+    }
+}
+
+/*
+ * Public Method(s)
+ */
+
+// Get a buffer of at least the given number of bytes. A request which can't
+// be met from the pool is met from the heap and counted, so this only fails,
+// with std::bad_alloc, when the heap is exhausted too.
+void *SampleBufferPool::acquire(size_t bytes)
+{
+    boost::mutex::scoped_lock lock(this->poolLock);
+
+    size_t size = std::max((bytes + NORMAL_PAGE_SIZE - 1) / NORMAL_PAGE_SIZE, size_t(1)) * NORMAL_PAGE_SIZE;
+
+    std::vector<void *> &available = this->freeBuffers[size];
+    void *buffer = NULL;
+
+    if (available.empty())
+    {
+        // Map a new slab, sharing it between as many buffers of this size as
+        // fit, and keeping the rest for later. Small buffers share a slab of
+        // at least the minimum size, and larger ones get one to themselves.
+        size_t slabSize = std::max(MIN_SLAB_SIZE / size, size_t(1)) * size;
+
+        if (this->hugePages)
+        {
+            slabSize = (slabSize + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        }
+
+        char *slab = NULL;
+
+        if (this->limit == 0 or this->reserved + slabSize <= this->limit)
+        {
+            slab = (char *) mapSlab(slabSize);
+        }
+
+        if (slab)
+        {
+            for (size_t offset = size; offset + size <= slabSize; offset += size)
+            {
+                available.push_back(slab + offset);
+            }
+
+            buffer = slab;
+        }
+    }
+    else
+    {
+        buffer = available.back();
+        available.pop_back();
+    }
+
+    if (buffer)
+    {
+        this->buffers[buffer] = size;
+    }
+    else
+    {
+        if (posix_memalign(&buffer, ALIGNMENT, size) != 0)
+        {
+            throw std::bad_alloc();
+        }
+
+        this->heapBuffers[buffer] = size;
+
+        ++this->exhaustionCount;
+    }
+
+    this->inUse += size;
+    this->highWater = std::max(this->highWater, this->inUse);
+
+    return buffer;
+}
+
+// Set how new slabs are mapped, and the most memory the slabs may use in
+// total, with zero for no limit. Existing slabs are locked or unlocked to
+// match.
+void SampleBufferPool::configure(bool hugePages, bool lockPages, size_t limit)
+{
+    boost::mutex::scoped_lock lock(this->poolLock);
+
+    if (lockPages != this->lockPages)
+    {
+        for (size_t i = 0; i < this->slabs.size(); ++i)
+        {
+            int result = (lockPages) ? mlock(this->slabs[i].address, this->slabs[i].size) : munlock(this->slabs[i].address, this->slabs[i].size);
+
+            if (result != 0)
+            {
+                this->mapStatus = std::string((lockPages) ? "mlock" : "munlock") + " failed: " + strerror(errno);
+            }
+        }
+    }
+
+    this->hugePages = hugePages;
+    this->limit = limit;
+    this->lockPages = lockPages;
+}
+
+// Return a buffer to the pool, or to the heap if that's where it came from
+void SampleBufferPool::release(void *buffer)
+{
+    if (not buffer)
+    {
+        return;
+    }
+
+    boost::mutex::scoped_lock lock(this->poolLock);
+
+    std::map<void *, size_t>::iterator pooled = this->buffers.find(buffer);
+
+    if (pooled != this->buffers.end())
+    {
+        this->freeBuffers[pooled->second].push_back(buffer);
+        this->inUse -= pooled->second;
+        this->buffers.erase(pooled);
+
+        return;
+    }
+
+    std::map<void *, size_t>::iterator heap = this->heapBuffers.find(buffer);
+
+    if (heap != this->heapBuffers.end())
+    {
+        free(buffer);
+
+        this->inUse -= heap->second;
+        this->heapBuffers.erase(heap);
+    }
+}
+
+// The bytes in buffers currently handed out, including any from the heap
+uint64_t SampleBufferPool::bytesInUse() const
+{
+    boost::mutex::scoped_lock lock(this->poolLock);
+
+    return this->inUse;
+}
+
+// The bytes mapped for slabs
+uint64_t SampleBufferPool::bytesReserved() const
+{
+    boost::mutex::scoped_lock lock(this->poolLock);
+
+    return this->reserved;
+}
+
+// The number of buffers which had to come from the heap
+uint64_t SampleBufferPool::exhaustions() const
+{
+    boost::mutex::scoped_lock lock(this->poolLock);
+
+    return this->exhaustionCount;
+}
+
+// The most bytes ever handed out at once
+uint64_t SampleBufferPool::highWaterMark() const
+{
+    boost::mutex::scoped_lock lock(this->poolLock);
+
+    return this->highWater;
+}
+
+// A description of how the slabs are backed, including the last failure to
+// map or lock one
+std::string SampleBufferPool::status() const
+{
+    boost::mutex::scoped_lock lock(this->poolLock);
+
+    std::string status = boost::lexical_cast<std::string>(this->slabs.size()) + " slab(s), " + ((this->hugePages) ? "huge pages" : "normal pages") + ", " + ((this->lockPages) ? "locked" : "unlocked");
+
+    if (not this->mapStatus.empty())
+    {
+        status += "; " + this->mapStatus;
+    }
+
+    return status;
+}
+
+/*
+ * Private Method(s)
+ */
+
+// Map and optionally lock a slab, falling back to normal pages if no huge
+// pages are available. Returns NULL if nothing could be mapped.
+void *SampleBufferPool::mapSlab(size_t bytes)
+{
+    void *address = MAP_FAILED;
+
+    if (this->hugePages)
+    {
+#ifdef MAP_HUGETLB
+        address = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (address == MAP_FAILED)
+        {
+            this->mapStatus = std::string("huge pages unavailable: ") + strerror(errno);
+        }
+#else
+        this->mapStatus = "huge pages unsupported";
+#endif
+    }
+
+    if (address == MAP_FAILED)
+    {
+        address = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    if (address == MAP_FAILED)
+    {
+        this->mapStatus = std::string("mmap failed: ") + strerror(errno);
+        return NULL;
+    }
+
+    if (this->lockPages and mlock(address, bytes) != 0)
+    {
+        this->mapStatus = std::string("mlock failed: ") + strerror(errno);
+    }
+
+    Slab slab;
+
+    slab.address = address;
+    slab.size = bytes;
+
+    this->slabs.push_back(slab);
+    this->reserved += bytes;
+
+    return address;
+}
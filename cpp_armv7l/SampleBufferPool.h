@@ -0,0 +1,93 @@
+#ifndef SAMPLEBUFFERPOOL_H
+#define SAMPLEBUFFERPOOL_H
+
+// Boost Include(s)
+#include <boost/thread.hpp>
+
+// Standard Include(s)
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * A pool of sample buffers shared by the RX and TX paths. Memory is mapped in
+ * slabs, optionally backed by huge pages and locked into RAM, and carved into
+ * cache line aligned buffers. Requests are rounded up to a whole number of
+ * pages, and a released buffer is kept for the next request of the same size,
+ * so a ring rebuilt with the same sizes reuses the same memory.
+ *
+ * Buffers are only taken while setting up, so streaming never touches the
+ * pool. Once the limit is reached, further buffers come from the heap instead,
+ * and each one is counted as an exhaustion.
+ */
+class SampleBufferPool
+{
+    public:
+        SampleBufferPool();
+
+        ~SampleBufferPool();
+
+    // Public Method(s)
+    public:
+        void *acquire(size_t bytes);
+
+        template <typename T>
+        T *acquire(size_t count)
+        {
+            return static_cast<T *>(acquire(count * sizeof(T)));
+        }
+
+        void configure(bool hugePages, bool lockPages, size_t limit);
+
+        void release(void *buffer);
+
+        // Bookkeeping
+        uint64_t bytesInUse() const;
+
+        uint64_t bytesReserved() const;
+
+        uint64_t exhaustions() const;
+
+        uint64_t highWaterMark() const;
+
+        std::string status() const;
+
+    // Private Method(s)
+    private:
+        void *mapSlab(size_t bytes);
+
+        // Not copyable
+        SampleBufferPool(const SampleBufferPool &);
+
+        SampleBufferPool &operator=(const SampleBufferPool &);
+
+    // Private Member(s)
+    private:
+        static const size_t ALIGNMENT = 64;
+        static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+        static const size_t MIN_SLAB_SIZE = 64 * 1024;
+        static const size_t NORMAL_PAGE_SIZE = 4096;
+
+        struct Slab
+        {
+            void *address;
+            size_t size;
+        };
+
+        std::map<void *, size_t> buffers;
+        uint64_t exhaustionCount;
+        std::map<size_t, std::vector<void *> > freeBuffers;
+        std::map<void *, size_t> heapBuffers;
+        uint64_t highWater;
+        bool hugePages;
+        uint64_t inUse;
+        size_t limit;
+        bool lockPages;
+        std::string mapStatus;
+        mutable boost::mutex poolLock;
+        uint64_t reserved;
+        std::vector<Slab> slabs;
+};
+
+#endif
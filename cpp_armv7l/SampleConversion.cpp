@@ -0,0 +1,138 @@
+// Class Include
+#include "SampleConversion.h"
+
+// Standard Include(s)
+#include <algorithm>
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CONVERSION_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define CONVERSION_SSE2
+#endif
+
+namespace
+{
+    const float SHORT_MIN = -32768.0f;
+    const float SHORT_MAX = 32767.0f;
+
+    // Convert a single float which has already been scaled
+    inline short roundToShort(float value)
+    {
+        value = std::min(std::max(value, SHORT_MIN), SHORT_MAX);
+
+        return short((value < 0) ? value - 0.5f : value + 0.5f);
+    }
+}
+
+/*
+ * Public Method(s)
+ */
+
+void convertShortToFloat(const short *input, float *output, size_t count, float scale)
+{
+    size_t i = 0;
+
+#if defined(CONVERSION_NEON)
+    float32x4_t scaleVector = vdupq_n_f32(scale);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        int16x8_t shorts = vld1q_s16(input + i);
+
+        float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(shorts)));
+        float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(shorts)));
+
+        vst1q_f32(output + i, vmulq_f32(low, scaleVector));
+        vst1q_f32(output + i + 4, vmulq_f32(high, scaleVector));
+    }
+#elif defined(CONVERSION_SSE2)
+    __m128 scaleVector = _mm_set1_ps(scale);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i shorts = _mm_loadu_si128((const __m128i *) (input + i));
+
+        // Sign extend each half to 32 bits
+        __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 16);
+        __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(shorts, shorts), 16);
+
+        _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scaleVector));
+        _mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scaleVector));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        output[i] = input[i] * scale;
+    }
+}
+
+void convertFloatToShort(const float *input, short *output, size_t count, float scale)
+{
+    float inverse = (scale != 0) ? 1.0f / scale : 0.0f;
+    size_t i = 0;
+
+#if defined(CONVERSION_NEON)
+    float32x4_t inverseVector = vdupq_n_f32(inverse);
+    float32x4_t half = vdupq_n_f32(0.5f);
+    uint32x4_t signMask = vdupq_n_u32(0x80000000);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        float32x4_t low = vmulq_f32(vld1q_f32(input + i), inverseVector);
+        float32x4_t high = vmulq_f32(vld1q_f32(input + i + 4), inverseVector);
+
+        // Add a half with the sign of each value, then truncate. The
+        // conversion and narrowing both saturate.
+        low = vaddq_f32(low, vbslq_f32(signMask, low, half));
+        high = vaddq_f32(high, vbslq_f32(signMask, high, half));
+
+        int16x4_t lowShorts = vqmovn_s32(vcvtq_s32_f32(low));
+        int16x4_t highShorts = vqmovn_s32(vcvtq_s32_f32(high));
+
+        vst1q_s16(output + i, vcombine_s16(lowShorts, highShorts));
+    }
+#elif defined(CONVERSION_SSE2)
+    __m128 inverseVector = _mm_set1_ps(inverse);
+    __m128 half = _mm_set1_ps(0.5f);
+    __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 minimum = _mm_set1_ps(SHORT_MIN);
+    __m128 maximum = _mm_set1_ps(SHORT_MAX);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128 low = _mm_mul_ps(_mm_loadu_ps(input + i), inverseVector);
+        __m128 high = _mm_mul_ps(_mm_loadu_ps(input + i + 4), inverseVector);
+
+        // Clamp first, as out of range conversions don't saturate
+        low = _mm_min_ps(_mm_max_ps(low, minimum), maximum);
+        high = _mm_min_ps(_mm_max_ps(high, minimum), maximum);
+
+        // Add a half with the sign of each value, then truncate
+        low = _mm_add_ps(low, _mm_or_ps(_mm_and_ps(low, signMask), half));
+        high = _mm_add_ps(high, _mm_or_ps(_mm_and_ps(high, signMask), half));
+
+        __m128i shorts = _mm_packs_epi32(_mm_cvttps_epi32(low), _mm_cvttps_epi32(high));
+
+        _mm_storeu_si128((__m128i *) (output + i), shorts);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        output[i] = roundToShort(input[i] * inverse);
+    }
+}
+
+const char *conversionKernelName()
+{
+#if defined(CONVERSION_NEON)
+    return "NEON";
+#elif defined(CONVERSION_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
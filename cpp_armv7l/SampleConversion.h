@@ -0,0 +1,25 @@
+#ifndef SAMPLECONVERSION_H
+#define SAMPLECONVERSION_H
+
+// Standard Include(s)
+#include <stddef.h>
+
+/*
+ * Conversions between the sc16 samples exchanged with the RF-NoC block and
+ * the float samples on the float ports. Counts are of real values, so a
+ * complex sample counts twice. The kernels are vectorized with NEON or SSE2
+ * where the compiler targets them, falling back to scalar code otherwise.
+ */
+
+// Convert shorts to floats, multiplying each by scale
+void convertShortToFloat(const short *input, float *output, size_t count, float scale);
+
+// Convert floats to shorts, dividing each by scale. Results are rounded to
+// the nearest integer, with halves rounded away from zero, and saturate at
+// the limits of a short.
+void convertFloatToShort(const float *input, short *output, size_t count, float scale);
+
+// The name of the instruction set the kernels were built for
+const char *conversionKernelName();
+
+#endif
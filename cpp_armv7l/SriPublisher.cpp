@@ -0,0 +1,207 @@
+// Class Include
+#include "SriPublisher.h"
+
+// REDHAWK Include(s)
+#include <ossie/PropertyMap.h>
+
+// Standard Include(s)
+#include <algorithm>
+#include <sstream>
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+SriPublisher::SriPublisher() :
+    current(NULL),
+    generation(0),
+    ports(1),
+    readerAttached(false),
+    readerGeneration(0),
+    sampleRate(0),
+    sriSet(false)
+{
+}
+
+// The pushing thread has stopped by now, so every snapshot can go
+SriPublisher::~SriPublisher()
+{
+    delete this->current.load();
+
+    for (size_t i = 0; i < this->retired.size(); ++i)
+    {
+        delete this->retired[i];
+    }
+}
+
+/*
+ * Public Method(s)
+ */
+
+// Set the number of block ports to publish an SRI for
+void SriPublisher::setPorts(size_t ports)
+{
+    boost::mutex::scoped_lock lock(this->publishLock);
+
+    this->ports = std::max(ports, size_t(1));
+
+    publish();
+}
+
+// Set the rate the block produces samples at, or zero if it isn't known
+void SriPublisher::setSampleRate(double sampleRate)
+{
+    boost::mutex::scoped_lock lock(this->publishLock);
+
+    if (sampleRate == this->sampleRate)
+    {
+        return;
+    }
+
+    this->sampleRate = sampleRate;
+
+    publish();
+}
+
+// Set the input SRI the output SRI is taken from
+void SriPublisher::setSRI(const BULKIO::StreamSRI &sri)
+{
+    boost::mutex::scoped_lock lock(this->publishLock);
+
+    this->sri = sri;
+    this->sriSet = true;
+
+    publish();
+}
+
+// Take the latest snapshot, or NULL if none has been published. It stays
+// valid until the next call, or until detaching.
+const SriSnapshot *SriPublisher::acquire()
+{
+    const SriSnapshot *snapshot = this->current.load();
+
+    if (snapshot)
+    {
+        this->readerGeneration.store(snapshot->generation, boost::memory_order_release);
+    }
+
+    return snapshot;
+}
+
+// Mark the pushing thread as holding snapshots, before its first acquire. The
+// flag and the current snapshot are both sequentially consistent, so either a
+// publish sees the thread attached, or the thread's first acquire sees what
+// was published.
+void SriPublisher::attach()
+{
+    this->readerAttached.store(true);
+}
+
+// Mark the pushing thread as stopped, reclaiming every retired snapshot
+void SriPublisher::detach()
+{
+    boost::mutex::scoped_lock lock(this->publishLock);
+
+    this->readerAttached.store(false);
+
+    reclaim();
+}
+
+// Whether an SRI has been published yet
+bool SriPublisher::published() const
+{
+    return (this->current.load(boost::memory_order_acquire) != NULL);
+}
+
+/*
+ * Private Method(s)
+ */
+
+// Build a snapshot from the current settings and swap it in, retiring the
+// one it replaces. Nothing is published until there's an SRI.
+void SriPublisher::publish()
+{
+    if (not this->sriSet)
+    {
+        return;
+    }
+
+    SriSnapshot *snapshot = new SriSnapshot;
+
+    snapshot->generation = ++this->generation;
+
+    for (size_t port = 0; port < this->ports; ++port)
+    {
+        BULKIO::StreamSRI portSRI = this->sri;
+
+        // Default to complex
+        portSRI.mode = 1;
+
+        if (this->sampleRate > 0)
+        {
+            portSRI.xdelta = 1.0 / this->sampleRate;
+        }
+
+        if (this->ports > 1)
+        {
+            std::ostringstream streamID;
+
+            streamID << this->sri.streamID.in();
+
+            if (port > 0)
+            {
+                streamID << "_port" << port;
+            }
+
+            portSRI.streamID = streamID.str().c_str();
+
+            redhawk::PropertyMap::cast(portSRI.keywords)["BLOCK_PORT"] = CORBA::ULong(port);
+        }
+
+        snapshot->portSRIs.push_back(portSRI);
+        snapshot->streamIDs.push_back(portSRI.streamID.in());
+    }
+
+    const SriSnapshot *previous = this->current.exchange(snapshot);
+
+    if (previous)
+    {
+        this->retired.push_back(previous);
+    }
+
+    reclaim();
+}
+
+// Delete the retired snapshots the pushing thread has moved past, or all of
+// them if it isn't attached
+void SriPublisher::reclaim()
+{
+    if (not this->readerAttached.load())
+    {
+        for (size_t i = 0; i < this->retired.size(); ++i)
+        {
+            delete this->retired[i];
+        }
+
+        this->retired.clear();
+
+        return;
+    }
+
+    uint64_t inUse = this->readerGeneration.load(boost::memory_order_acquire);
+    size_t kept = 0;
+
+    for (size_t i = 0; i < this->retired.size(); ++i)
+    {
+        if (this->retired[i]->generation < inUse)
+        {
+            delete this->retired[i];
+        }
+        else
+        {
+            this->retired[kept++] = this->retired[i];
+        }
+    }
+
+    this->retired.resize(kept);
+}
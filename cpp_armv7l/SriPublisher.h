@@ -0,0 +1,91 @@
+#ifndef SRIPUBLISHER_H
+#define SRIPUBLISHER_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+// BULKIO Include(s)
+#include <bulkio/bulkio.h>
+
+// Standard Include(s)
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * The output SRI of every block port, as published at one time. A snapshot
+ * is never changed once published.
+ */
+struct SriSnapshot
+{
+    uint64_t generation;
+    std::vector<BULKIO::StreamSRI> portSRIs;
+    std::vector<std::string> streamIDs;
+};
+
+/*
+ * Publishes the output SRI from the threads which change it to the thread
+ * pushing the output, without a lock on the pushing side. Each change builds
+ * a new snapshot and swaps it in atomically, so the pushing thread takes the
+ * latest with a single atomic load and sees a change at its next buffer.
+ *
+ * Replaced snapshots are reclaimed once the pushing thread has moved past
+ * them: it reports the generation it took with each load, and a snapshot
+ * older than that can't still be in use, as the thread only holds a snapshot
+ * for one buffer. Until then they're kept on a retired list. The pushing
+ * thread attaches before its first load and detaches once stopped, and while
+ * it's detached nothing but the current snapshot is kept.
+ *
+ * The first block port's stream keeps the ID of the input SRI, and each
+ * other port's is suffixed with its port. With several ports, each stream is
+ * labelled with its port by a BLOCK_PORT keyword. Once the block's rate is
+ * known, the xdelta follows it rather than the input.
+ */
+class SriPublisher
+{
+    public:
+        SriPublisher();
+
+        ~SriPublisher();
+
+    // Public Method(s)
+    public:
+        // Methods for the publishing threads
+        void setPorts(size_t ports);
+
+        void setSampleRate(double sampleRate);
+
+        void setSRI(const BULKIO::StreamSRI &sri);
+
+        // Methods for the pushing thread
+        const SriSnapshot *acquire();
+
+        void attach();
+
+        void detach();
+
+        // Methods for any thread
+        bool published() const;
+
+    // Private Method(s)
+    private:
+        void publish();
+
+        void reclaim();
+
+    // Private Member(s)
+    private:
+        boost::atomic<const SriSnapshot *> current;
+        uint64_t generation;
+        size_t ports;
+        boost::mutex publishLock;
+        boost::atomic<bool> readerAttached;
+        boost::atomic<uint64_t> readerGeneration;
+        std::vector<const SriSnapshot *> retired;
+        double sampleRate;
+        BULKIO::StreamSRI sri;
+        bool sriSet;
+};
+
+#endif
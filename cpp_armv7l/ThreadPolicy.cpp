@@ -0,0 +1,193 @@
+// Class Include
+#include "ThreadPolicy.h"
+
+// Boost Include(s)
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+// Standard Include(s)
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <vector>
+
+namespace
+{
+    // Parse a list of CPUs and CPU ranges into a CPU set
+    bool parseCpuList(const std::string &cpus, cpu_set_t &cpuSet)
+    {
+        std::vector<std::string> entries;
+
+        boost::split(entries, cpus, boost::is_any_of(","));
+
+        CPU_ZERO(&cpuSet);
+
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            std::string entry = boost::trim_copy(entries[i]);
+            size_t dash = entry.find('-');
+
+            try
+            {
+                int first = boost::lexical_cast<int>(entry.substr(0, dash));
+                int last = (dash == std::string::npos) ? first : boost::lexical_cast<int>(entry.substr(dash + 1));
+
+                if (first < 0 or last < first or last >= CPU_SETSIZE)
+                {
+                    return false;
+                }
+
+                for (int cpu = first; cpu <= last; ++cpu)
+                {
+                    CPU_SET(cpu, &cpuSet);
+                }
+            }
+            catch (boost::bad_lexical_cast &)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+ThreadPolicy::ThreadPolicy() :
+    pending(false),
+    policy("other"),
+    priority(0),
+    result("not applied")
+{
+}
+
+/*
+ * Public Method(s)
+ */
+
+// Request a new policy, to be applied when the thread next checks in
+void ThreadPolicy::configure(const std::string &cpus, const std::string &policy, int priority)
+{
+    boost::mutex::scoped_lock lock(this->policyLock);
+
+    this->cpus = cpus;
+    this->policy = policy;
+    this->priority = priority;
+
+    this->pending = true;
+}
+
+// Apply the current policy again, such as when the thread has been recreated
+void ThreadPolicy::reapply()
+{
+    this->pending = true;
+}
+
+// Get the result of the last attempt to apply the policy
+std::string ThreadPolicy::status() const
+{
+    boost::mutex::scoped_lock lock(this->policyLock);
+
+    return this->result;
+}
+
+// Apply the policy to the calling thread if it has changed since it was last
+// applied. Returns true if it was applied, successfully or not.
+bool ThreadPolicy::applyIfPending()
+{
+    if (not this->pending.exchange(false))
+    {
+        return false;
+    }
+
+    boost::mutex::scoped_lock lock(this->policyLock);
+
+    std::string failures = applyThreadPolicy(this->cpus, this->policy, this->priority);
+
+    this->result = (failures.empty()) ? "applied" : failures;
+
+    return true;
+}
+
+std::string applyThreadPolicy(const std::string &cpus, const std::string &policy, int priority)
+{
+    std::string failures;
+
+    if (not cpus.empty())
+    {
+        cpu_set_t cpuSet;
+
+        if (not parseCpuList(cpus, cpuSet))
+        {
+            failures += "invalid CPU list \"" + cpus + "\"; ";
+        }
+        else
+        {
+            int error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+
+            if (error != 0)
+            {
+                failures += "pthread_setaffinity_np failed: " + std::string(strerror(error)) + "; ";
+            }
+        }
+    }
+
+    int schedulingPolicy = SCHED_OTHER;
+    struct sched_param parameters;
+
+    parameters.sched_priority = 0;
+
+    if (policy == "fifo" or policy == "rr")
+    {
+        schedulingPolicy = (policy == "fifo") ? SCHED_FIFO : SCHED_RR;
+
+        int minimum = sched_get_priority_min(schedulingPolicy);
+        int maximum = sched_get_priority_max(schedulingPolicy);
+
+        if (priority < minimum or priority > maximum)
+        {
+            failures += "priority " + boost::lexical_cast<std::string>(priority) + " is outside of " + boost::lexical_cast<std::string>(minimum) + " to " + boost::lexical_cast<std::string>(maximum) + ", clamping; ";
+
+            priority = std::min(std::max(priority, minimum), maximum);
+        }
+
+        parameters.sched_priority = priority;
+    }
+    else if (policy != "other")
+    {
+        failures += "unknown policy \"" + policy + "\"; ";
+    }
+
+    int error = pthread_setschedparam(pthread_self(), schedulingPolicy, &parameters);
+
+    if (error != 0)
+    {
+        failures += "pthread_setschedparam failed: " + std::string(strerror(error)) + "; ";
+    }
+
+    // Drop the trailing separator
+    if (not failures.empty())
+    {
+        failures.resize(failures.size() - 2);
+    }
+
+    return failures;
+}
+
+std::string applyMemoryLock(bool lock)
+{
+    int result = (lock) ? mlockall(MCL_CURRENT | MCL_FUTURE) : munlockall();
+
+    if (result != 0)
+    {
+        return std::string((lock) ? "mlockall" : "munlockall") + " failed: " + strerror(errno);
+    }
+
+    return "";
+}
@@ -0,0 +1,59 @@
+#ifndef THREADPOLICY_H
+#define THREADPOLICY_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+// Standard Include(s)
+#include <string>
+
+/*
+ * Helpers for controlling how the streaming threads are scheduled. Each
+ * returns an empty string on success, or a description of what failed so
+ * that it can be reported without throwing from a service function.
+ */
+
+// Pin the calling thread to a list of CPUs such as "0,2-3", and set its
+// scheduling policy to one of "other", "fifo" or "rr". An empty CPU list
+// leaves the affinity unchanged, and the priority is only used by the
+// real-time policies.
+std::string applyThreadPolicy(const std::string &cpus, const std::string &policy, int priority);
+
+// Lock or unlock all of the process's current and future memory
+std::string applyMemoryLock(bool lock);
+
+/*
+ * The policy requested for one streaming thread. The policy is configured
+ * from any thread, but can only be applied by the thread itself, so it is
+ * held here until that thread next checks in. Checking costs a single atomic
+ * load when nothing has changed.
+ */
+class ThreadPolicy
+{
+    public:
+        ThreadPolicy();
+
+    // Public Method(s)
+    public:
+        // Methods for any thread
+        void configure(const std::string &cpus, const std::string &policy, int priority);
+
+        void reapply();
+
+        std::string status() const;
+
+        // Methods for the thread being controlled
+        bool applyIfPending();
+
+    // Private Member(s)
+    private:
+        std::string cpus;
+        mutable boost::mutex policyLock;
+        boost::atomic<bool> pending;
+        std::string policy;
+        int priority;
+        std::string result;
+};
+
+#endif
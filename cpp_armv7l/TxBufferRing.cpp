@@ -0,0 +1,276 @@
+// Class Include
+#include "TxBufferRing.h"
+
+// Boost Include(s)
+#include <boost/thread.hpp>
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+
+// Standard Include(s)
+#include <algorithm>
+
+// How long a blocked buffer waits for room before it's dropped instead
+const double TxBufferRing::BLOCK_TIMEOUT = 1.0;
+const unsigned int TxBufferRing::BLOCK_BACKOFF_MAX_US;
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+// Preallocate every buffer up front so that steady state streaming never
+// touches the heap. One buffer more than the depth is needed for the buffer
+// being sent.
+TxBufferRing::TxBufferRing(SampleBufferPool &pool, size_t depth, size_t bufferSize) :
+    blockedNanoseconds(0),
+    buffers(std::max(depth, size_t(1)) + 1),
+    bufferSamples(bufferSize),
+    cancelled(false),
+    droppedNewestBuffers(0),
+    droppedOldestBuffers(0),
+    head(0),
+    held(NONE),
+    maxDepth(std::max(depth, size_t(1))),
+    policy(BLOCK),
+    pool(pool),
+    tail(0)
+{
+    for (size_t i = 0; i < this->buffers.size(); ++i)
+    {
+        this->buffers[i].data = pool.acquire<std::complex<short> >(bufferSize);
+        this->buffers[i].size = 0;
+        this->buffers[i].startOfBurst = false;
+        this->buffers[i].endOfBurst = false;
+        this->buffers[i].queuedAt = 0;
+        this->buffers[i].port = 0;
+    }
+}
+
+// Return the buffers to the pool
+TxBufferRing::~TxBufferRing()
+{
+    for (size_t i = 0; i < this->buffers.size(); ++i)
+    {
+        this->pool.release(this->buffers[i].data);
+    }
+}
+
+/*
+ * Public Method(s)
+ */
+
+// Make a blocked acquireFree give up at once, and every later one fail until
+// the ring is cleared
+void TxBufferRing::cancel()
+{
+    this->cancelled.store(true);
+}
+
+// Select the overflow policy by name, returning false if it isn't recognized
+bool TxBufferRing::configure(const std::string &policy)
+{
+    if (policy == "block")
+    {
+        this->policy = BLOCK;
+    }
+    else if (policy == "dropOldest")
+    {
+        this->policy = DROP_OLDEST;
+    }
+    else if (policy == "dropNewest")
+    {
+        this->policy = DROP_NEWEST;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// Get the next buffer to fill, applying the overflow policy if the ring is
+// full. Returns NULL if the new buffer is to be dropped, which includes a
+// blocked buffer that still finds no room after the timeout.
+TxBuffer *TxBufferRing::acquireFree()
+{
+    uint64_t index = this->head.load(boost::memory_order_relaxed);
+    uint64_t blockStart = 0;
+    unsigned int backoffMicroseconds = 1;
+
+    while (not isFree(index))
+    {
+        if (this->cancelled.load(boost::memory_order_relaxed))
+        {
+            if (blockStart != 0)
+            {
+                this->blockedNanoseconds.fetch_add(monotonicNanoseconds() - blockStart, boost::memory_order_relaxed);
+            }
+
+            return NULL;
+        }
+
+        switch (OverflowPolicy(this->policy.load(boost::memory_order_relaxed)))
+        {
+            case BLOCK:
+            {
+                uint64_t now = monotonicNanoseconds();
+
+                if (blockStart == 0)
+                {
+                    blockStart = now;
+                }
+                else if (now - blockStart >= BLOCK_TIMEOUT * 1e9)
+                {
+                    this->blockedNanoseconds.fetch_add(now - blockStart, boost::memory_order_relaxed);
+                    this->droppedNewestBuffers.fetch_add(1, boost::memory_order_relaxed);
+
+                    return NULL;
+                }
+
+                boost::this_thread::sleep(boost::posix_time::microseconds(backoffMicroseconds));
+
+                backoffMicroseconds = std::min(2 * backoffMicroseconds, BLOCK_BACKOFF_MAX_US);
+
+                break;
+            }
+
+            case DROP_OLDEST:
+            {
+                // Race the sending thread for the oldest buffer, which it may
+                // take first. With nothing left queued, the only buffer in
+                // the way is the one being sent, so drop the new one.
+                uint64_t oldest = this->tail.load();
+
+                if (oldest == index)
+                {
+                    this->droppedNewestBuffers.fetch_add(1, boost::memory_order_relaxed);
+
+                    return NULL;
+                }
+
+                if (this->tail.compare_exchange_strong(oldest, oldest + 1))
+                {
+                    this->droppedOldestBuffers.fetch_add(1, boost::memory_order_relaxed);
+                }
+
+                break;
+            }
+
+            case DROP_NEWEST:
+                this->droppedNewestBuffers.fetch_add(1, boost::memory_order_relaxed);
+
+                return NULL;
+        }
+    }
+
+    if (blockStart != 0)
+    {
+        this->blockedNanoseconds.fetch_add(monotonicNanoseconds() - blockStart, boost::memory_order_relaxed);
+    }
+
+    TxBuffer *buffer = &this->buffers[index % this->buffers.size()];
+
+    buffer->size = 0;
+    buffer->startOfBurst = false;
+    buffer->endOfBurst = false;
+    buffer->queuedAt = 0;
+
+    return buffer;
+}
+
+// Queue the buffer returned by the last acquireFree. Returns true if the ring
+// was empty, meaning the sending thread may need waking.
+bool TxBufferRing::commit()
+{
+    uint64_t index = this->head.load(boost::memory_order_relaxed);
+
+    this->head.store(index + 1, boost::memory_order_release);
+
+    return (this->tail.load() == index);
+}
+
+// Take the oldest queued buffer, or NULL if there are none. The buffer stays
+// valid until the next call, which hands it back to the filling thread.
+TxBuffer *TxBufferRing::acquireFull()
+{
+    while (true)
+    {
+        uint64_t index = this->tail.load();
+
+        // Claim the buffer before taking it, so the filling thread never
+        // reuses it while it's being sent
+        this->held.store(index);
+
+        if (index == this->head.load(boost::memory_order_acquire))
+        {
+            this->held.store(NONE);
+
+            return NULL;
+        }
+
+        if (this->tail.compare_exchange_strong(index, index + 1))
+        {
+            return &this->buffers[index % this->buffers.size()];
+        }
+    }
+}
+
+// The total time the filling thread has spent blocked on a full ring
+double TxBufferRing::blockedTime() const
+{
+    return this->blockedNanoseconds.load(boost::memory_order_relaxed) / 1e9;
+}
+
+size_t TxBufferRing::bufferSize() const
+{
+    return this->bufferSamples;
+}
+
+size_t TxBufferRing::capacity() const
+{
+    return this->maxDepth;
+}
+
+// Discard everything queued
+void TxBufferRing::clear()
+{
+    this->tail.store(this->head.load());
+    this->held.store(NONE);
+    this->cancelled.store(false);
+}
+
+// The number of buffers currently queued
+size_t TxBufferRing::depth() const
+{
+    uint64_t tail = this->tail.load();
+    uint64_t head = this->head.load();
+
+    return (head > tail) ? head - tail : 0;
+}
+
+uint64_t TxBufferRing::droppedNewest() const
+{
+    return this->droppedNewestBuffers.load(boost::memory_order_relaxed);
+}
+
+uint64_t TxBufferRing::droppedOldest() const
+{
+    return this->droppedOldestBuffers.load(boost::memory_order_relaxed);
+}
+
+/*
+ * Private Method(s)
+ */
+
+// Whether the buffer for a new index may be filled: the ring must be below
+// its depth, and the buffer must not be the one being sent
+bool TxBufferRing::isFree(uint64_t index) const
+{
+    if (index - this->tail.load() >= this->maxDepth)
+    {
+        return false;
+    }
+
+    return (index < this->buffers.size() or this->held.load() != index - this->buffers.size());
+}
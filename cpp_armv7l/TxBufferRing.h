@@ -0,0 +1,120 @@
+#ifndef TXBUFFERRING_H
+#define TXBUFFERRING_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+
+// Local Include(s)
+#include "SampleBufferPool.h"
+
+// UHD Include(s)
+#include <uhd/types/time_spec.hpp>
+
+// Standard Include(s)
+#include <complex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * A single preallocated TX buffer along with the burst metadata to send it
+ * with. The time is only meaningful on the start of a burst. The monotonic
+ * time it was queued at is kept for the latency trace, or zero if not tracing,
+ * and the port is the block port the samples are sent to.
+ */
+struct TxBuffer
+{
+    std::complex<short> *data;
+    size_t size;
+    bool startOfBurst;
+    uhd::time_spec_t time;
+    bool endOfBurst;
+    uint64_t queuedAt;
+    size_t port;
+};
+
+/*
+ * A bounded lock-free ring of preallocated TX buffers used to hand samples
+ * from the thread reading the input ports to the thread calling send. There
+ * is exactly one thread on each side, and neither takes a lock. When the ring
+ * is full, the overflow policy either blocks the filling thread, reclaims the
+ * oldest queued buffer, or drops the new one, and each outcome is counted.
+ *
+ * The buffer last taken by the sending thread is not refilled until it asks
+ * for the next one, so samples can be sent straight out of the ring. The
+ * buffers are taken from a sample buffer pool for the life of the ring.
+ *
+ * The ring sits behind the input ports' own queue, so it only pays off when
+ * reading and converting the input holds up sending, which the benchmark's
+ * --tx-queue option measures.
+ */
+class TxBufferRing
+{
+    public:
+        enum OverflowPolicy
+        {
+            BLOCK,
+            DROP_OLDEST,
+            DROP_NEWEST
+        };
+
+        TxBufferRing(SampleBufferPool &pool, size_t depth, size_t bufferSize);
+
+        ~TxBufferRing();
+
+    // Public Method(s)
+    public:
+        // Methods for any thread
+        void cancel();
+
+        bool configure(const std::string &policy);
+
+        // Methods for the thread filling buffers
+        TxBuffer *acquireFree();
+
+        bool commit();
+
+        // Methods for the thread draining buffers
+        TxBuffer *acquireFull();
+
+        // Bookkeeping, clear is only safe with both threads stopped, and
+        // also lifts a cancel
+        double blockedTime() const;
+
+        size_t bufferSize() const;
+
+        size_t capacity() const;
+
+        void clear();
+
+        size_t depth() const;
+
+        uint64_t droppedNewest() const;
+
+        uint64_t droppedOldest() const;
+
+    // Private Method(s)
+    private:
+        bool isFree(uint64_t index) const;
+
+    // Private Member(s)
+    private:
+        static const double BLOCK_TIMEOUT;
+        static const unsigned int BLOCK_BACKOFF_MAX_US = 1000;
+        static const uint64_t NONE = ~uint64_t(0);
+
+        boost::atomic<uint64_t> blockedNanoseconds;
+        std::vector<TxBuffer> buffers;
+        size_t bufferSamples;
+        boost::atomic<bool> cancelled;
+        boost::atomic<uint64_t> droppedNewestBuffers;
+        boost::atomic<uint64_t> droppedOldestBuffers;
+        boost::atomic<uint64_t> head;
+        boost::atomic<uint64_t> held;
+        size_t maxDepth;
+        boost::atomic<int> policy;
+        SampleBufferPool &pool;
+        boost::atomic<uint64_t> tail;
+};
+
+#endif
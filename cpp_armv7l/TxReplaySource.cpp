@@ -0,0 +1,451 @@
+// Class Include
+#include "TxReplaySource.h"
+
+// Boost Include(s)
+#include <boost/lexical_cast.hpp>
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+
+// Standard Include(s)
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    const std::string DATA_EXTENSION = ".sigmf-data";
+    const std::string META_EXTENSION = ".sigmf-meta";
+
+    // Find the number following a key in a piece of JSON. Only the flat
+    // objects written by the RX capture need to be understood.
+    bool jsonNumber(const std::string &json, const std::string &key, double &value)
+    {
+        std::string quotedKey = "\"" + key + "\"";
+        size_t position = json.find(quotedKey);
+
+        if (position == std::string::npos)
+        {
+            return false;
+        }
+
+        // The keys have colons of their own
+        position = json.find(':', position + quotedKey.size());
+
+        if (position == std::string::npos)
+        {
+            return false;
+        }
+
+        const char *start = json.c_str() + position + 1;
+        char *end = NULL;
+
+        value = strtod(start, &end);
+
+        return (end != start);
+    }
+
+    // Find the string following a key in a piece of JSON
+    bool jsonString(const std::string &json, const std::string &key, std::string &value)
+    {
+        std::string quotedKey = "\"" + key + "\"";
+        size_t position = json.find(quotedKey);
+
+        if (position == std::string::npos)
+        {
+            return false;
+        }
+
+        size_t start = json.find('"', position + quotedKey.size());
+
+        if (start == std::string::npos)
+        {
+            return false;
+        }
+
+        size_t end = json.find('"', start + 1);
+
+        if (end == std::string::npos)
+        {
+            return false;
+        }
+
+        value = json.substr(start + 1, end - start - 1);
+
+        return true;
+    }
+}
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+TxReplaySource::TxReplaySource() :
+    burstOpen(false),
+    data(NULL),
+    done(false),
+    fileBytes(0),
+    fileSampleRate(0),
+    fileSamples(0),
+    lateCount(0),
+    loop(false),
+    loopCount(0),
+    offsetValid(false),
+    position(0),
+    rate(0),
+    segment(0),
+    sent(0),
+    startNanoseconds(0),
+    statusText("idle"),
+    timestamps(NONE)
+{
+}
+
+TxReplaySource::~TxReplaySource()
+{
+    if (this->data)
+    {
+        munmap((void *) this->data, this->fileBytes);
+    }
+}
+
+/*
+ * Public Method(s)
+ */
+
+// Map the file for replay at the given rate, with zero for as fast as the
+// samples are taken. Returns false, with the reason in the status, if the
+// file or its sidecar can't be used.
+bool TxReplaySource::open(const std::string &path, double rate, bool loop, const std::string &timestamps)
+{
+    if (timestamps == "none")
+    {
+        this->timestamps = NONE;
+    }
+    else if (timestamps == "regenerate")
+    {
+        this->timestamps = REGENERATE;
+    }
+    else if (timestamps == "preserve")
+    {
+        this->timestamps = PRESERVE;
+    }
+    else
+    {
+        setStatus("error: unknown time stamp mode " + timestamps);
+        return false;
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        setStatus("error: unable to open " + path + ": " + strerror(errno));
+        return false;
+    }
+
+    struct stat fileStatus;
+
+    if (fstat(fd, &fileStatus) != 0 or fileStatus.st_size < off_t(sizeof(std::complex<short>)))
+    {
+        setStatus("error: " + path + " holds no samples");
+        ::close(fd);
+        return false;
+    }
+
+    // A trailing partial sample is ignored
+    this->fileSamples = fileStatus.st_size / sizeof(std::complex<short>);
+    this->fileBytes = this->fileSamples * sizeof(std::complex<short>);
+
+    // Take the runs and the sample rate from the sidecar, if there is one
+    if (path.size() > DATA_EXTENSION.size() and path.compare(path.size() - DATA_EXTENSION.size(), DATA_EXTENSION.size(), DATA_EXTENSION) == 0)
+    {
+        if (not readMetadata(path.substr(0, path.size() - DATA_EXTENSION.size()) + META_EXTENSION))
+        {
+            ::close(fd);
+            return false;
+        }
+    }
+
+    void *address = mmap(NULL, this->fileBytes, PROT_READ, MAP_SHARED, fd, 0);
+
+    // The mapping outlives the descriptor
+    ::close(fd);
+
+    if (address == MAP_FAILED)
+    {
+        setStatus("error: unable to map " + path + ": " + strerror(errno));
+        return false;
+    }
+
+    madvise(address, this->fileBytes, MADV_SEQUENTIAL);
+
+    this->data = (const std::complex<short> *) address;
+    this->loop = loop;
+    this->path = path;
+    this->rate = std::max(rate, 0.0);
+
+    // The whole file is one run unless the sidecar says otherwise
+    if (this->segments.empty() or this->segments.front().start != 0)
+    {
+        Segment first;
+
+        first.start = 0;
+        first.hasTime = false;
+
+        this->segments.insert(this->segments.begin(), first);
+    }
+
+    // Each pass through the file continues from where the last one ended,
+    // which is only known when every run has a time and the rate is known
+    const Segment &last = this->segments.back();
+
+    if (this->fileSampleRate > 0 and this->segments.front().hasTime and last.hasTime)
+    {
+        this->passDuration = last.time + uhd::time_spec_t((this->fileSamples - last.start) / this->fileSampleRate) - this->segments.front().time;
+    }
+
+    setStatus("");
+
+    return true;
+}
+
+// The time in seconds until the next run is due at the replay rate, which is
+// zero or less once it's due
+double TxReplaySource::delay() const
+{
+    if (this->rate <= 0 or this->startNanoseconds == 0)
+    {
+        return 0;
+    }
+
+    double due = this->startNanoseconds + this->sent.load(boost::memory_order_relaxed) / this->rate * 1e9;
+
+    return (due - monotonicNanoseconds()) / 1e9;
+}
+
+// Take the next run of at most the given number of samples, never crossing
+// a run from the sidecar. A new burst starts no earlier than the given time.
+// Returns false once the replay has finished.
+bool TxReplaySource::next(size_t maxSamples, const uhd::time_spec_t &earliest, TxReplayRun &run)
+{
+    if (this->done.load(boost::memory_order_relaxed) or not this->data or maxSamples == 0)
+    {
+        return false;
+    }
+
+    uint64_t now = monotonicNanoseconds();
+
+    if (this->startNanoseconds == 0)
+    {
+        this->startNanoseconds = now;
+    }
+
+    // Start the next pass, carrying the preserved times on past the last one
+    if (this->position == this->fileSamples)
+    {
+        this->position = 0;
+        this->segment = 0;
+        this->offset += this->passDuration;
+
+        this->loopCount.fetch_add(1, boost::memory_order_relaxed);
+    }
+
+    uint64_t segmentEnd = (this->segment + 1 < this->segments.size()) ? this->segments[this->segment + 1].start : this->fileSamples;
+    size_t count = size_t(std::min(uint64_t(maxSamples), segmentEnd - this->position));
+
+    run.data = this->data + this->position;
+    run.size = count;
+    run.startOfBurst = not this->burstOpen;
+    run.hasTime = (run.startOfBurst and this->timestamps != NONE);
+
+    if (run.hasTime)
+    {
+        const Segment &current = this->segments[this->segment];
+
+        if (this->timestamps == PRESERVE and current.hasTime)
+        {
+            // Shift the captured times on rather than send a burst late
+            if (not this->offsetValid or current.time + this->offset < earliest)
+            {
+                this->offset = earliest - current.time;
+                this->offsetValid = true;
+            }
+
+            run.time = current.time + this->offset;
+        }
+        else
+        {
+            run.time = earliest;
+        }
+    }
+
+    // Count a run taken more than its own length behind the replay rate
+    if (this->rate > 0)
+    {
+        double due = this->startNanoseconds + this->sent.load(boost::memory_order_relaxed) / this->rate * 1e9;
+
+        if (now > due + count / this->rate * 1e9)
+        {
+            this->lateCount.fetch_add(1, boost::memory_order_relaxed);
+        }
+    }
+
+    this->position += count;
+    this->sent.fetch_add(count, boost::memory_order_relaxed);
+
+    bool segmentDone = (this->position == segmentEnd);
+
+    if (this->position == this->fileSamples)
+    {
+        if (not this->loop)
+        {
+            this->done = true;
+        }
+    }
+    else if (segmentDone)
+    {
+        ++this->segment;
+    }
+
+    // Preserved time stamps end the burst with each run from the sidecar,
+    // otherwise the replay is one burst
+    run.endOfBurst = (this->done or (this->timestamps == PRESERVE and segmentDone));
+
+    this->burstOpen = not run.endOfBurst;
+
+    return true;
+}
+
+// Whether there's nothing left to replay, which includes a failed open
+bool TxReplaySource::finished() const
+{
+    return (this->done.load(boost::memory_order_relaxed) or not this->data);
+}
+
+// The number of runs taken more than their own length behind the replay rate
+uint64_t TxReplaySource::lateRuns() const
+{
+    return this->lateCount.load(boost::memory_order_relaxed);
+}
+
+// The number of times the replay has wrapped to the start of the file
+uint64_t TxReplaySource::loops() const
+{
+    return this->loopCount.load(boost::memory_order_relaxed);
+}
+
+uint64_t TxReplaySource::samplesSent() const
+{
+    return this->sent.load(boost::memory_order_relaxed);
+}
+
+// The state of the replay, or the error which prevented it
+std::string TxReplaySource::status() const
+{
+    {
+        boost::mutex::scoped_lock lock(this->statusLock);
+
+        if (not this->statusText.empty())
+        {
+            return this->statusText;
+        }
+    }
+
+    std::string state = (this->done.load(boost::memory_order_relaxed)) ? "complete" : "replaying " + this->path;
+
+    return state + ", " + boost::lexical_cast<std::string>(samplesSent()) + " samples sent, " + boost::lexical_cast<std::string>(loops()) + " loop(s), " + boost::lexical_cast<std::string>(lateRuns()) + " late run(s)";
+}
+
+/*
+ * Private Method(s)
+ */
+
+// Read the sample rate and runs from a SigMF sidecar. A missing sidecar is
+// fine, but one for anything other than sc16 samples is not.
+bool TxReplaySource::readMetadata(const std::string &metaPath)
+{
+    std::ifstream meta(metaPath.c_str());
+
+    if (not meta)
+    {
+        return true;
+    }
+
+    std::stringstream contents;
+
+    contents << meta.rdbuf();
+
+    std::string json = contents.str();
+    std::string datatype;
+
+    if (jsonString(json, "core:datatype", datatype) and datatype != "ci16_le")
+    {
+        setStatus("error: " + metaPath + " describes " + datatype + " samples, not ci16_le");
+        return false;
+    }
+
+    jsonNumber(json, "core:sample_rate", this->fileSampleRate);
+
+    // Each capture is a flat object within the captures array
+    size_t position = json.find("\"captures\"");
+    size_t end = (position == std::string::npos) ? position : json.find(']', position);
+
+    while (position < end)
+    {
+        position = json.find('{', position);
+
+        if (position >= end)
+        {
+            break;
+        }
+
+        size_t close = json.find('}', position);
+
+        if (close == std::string::npos)
+        {
+            break;
+        }
+
+        std::string capture = json.substr(position, close - position);
+        double start = 0;
+        double fullSecs = 0;
+        double fracSecs = 0;
+
+        jsonNumber(capture, "core:sample_start", start);
+
+        Segment segment;
+
+        segment.start = uint64_t(start);
+        segment.hasTime = (jsonNumber(capture, "rfnoc:full_secs", fullSecs) and jsonNumber(capture, "rfnoc:frac_secs", fracSecs));
+
+        if (segment.hasTime)
+        {
+            segment.time = uhd::time_spec_t(time_t(fullSecs), fracSecs);
+        }
+
+        // Ignore anything out of order or past the end of the file
+        if (segment.start < this->fileSamples and (this->segments.empty() or segment.start > this->segments.back().start))
+        {
+            this->segments.push_back(segment);
+        }
+
+        position = close + 1;
+    }
+
+    return true;
+}
+
+void TxReplaySource::setStatus(const std::string &status)
+{
+    boost::mutex::scoped_lock lock(this->statusLock);
+
+    this->statusText = status;
+}
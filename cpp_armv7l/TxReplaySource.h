@@ -0,0 +1,126 @@
+#ifndef TXREPLAYSOURCE_H
+#define TXREPLAYSOURCE_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+// UHD Include(s)
+#include <uhd/types/time_spec.hpp>
+
+// Standard Include(s)
+#include <complex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * A run of replayed samples along with the burst metadata to send it with.
+ * The samples point straight into the mapped file, and the time is only
+ * meaningful when hasTime is set.
+ */
+struct TxReplayRun
+{
+    const std::complex<short> *data;
+    size_t size;
+    bool startOfBurst;
+    bool hasTime;
+    uhd::time_spec_t time;
+    bool endOfBurst;
+};
+
+/*
+ * A source of TX samples replayed from a file of sc16 samples, for loading
+ * the TX path at a known rate without a BulkIO producer. The file is mapped
+ * into memory and handed out in runs without copying, optionally paced to a
+ * sample rate and looped. When the file is a .sigmf-data file with a sidecar,
+ * such as one written by the RX capture, the sidecar supplies its sample rate
+ * and the time stamp of each contiguous run.
+ *
+ * Time stamps are either left off, regenerated so that the whole replay is
+ * one burst starting at the earliest time allowed, or preserved, in which
+ * case each run from the sidecar is its own burst, spaced as it was captured.
+ * Captured times are in the past, so they're shifted by a constant which puts
+ * the first run at the earliest time allowed.
+ */
+class TxReplaySource
+{
+    public:
+        enum TimestampMode
+        {
+            NONE,
+            REGENERATE,
+            PRESERVE
+        };
+
+        TxReplaySource();
+
+        ~TxReplaySource();
+
+    // Public Method(s)
+    public:
+        // Methods for the controlling thread
+        bool open(const std::string &path, double rate, bool loop, const std::string &timestamps);
+
+        // Methods for the TX thread
+        double delay() const;
+
+        bool next(size_t maxSamples, const uhd::time_spec_t &earliest, TxReplayRun &run);
+
+        // Bookkeeping
+        bool finished() const;
+
+        uint64_t lateRuns() const;
+
+        uint64_t loops() const;
+
+        uint64_t samplesSent() const;
+
+        std::string status() const;
+
+    // Private Method(s)
+    private:
+        bool readMetadata(const std::string &metaPath);
+
+        void setStatus(const std::string &status);
+
+        // Not copyable
+        TxReplaySource(const TxReplaySource &);
+
+        TxReplaySource &operator=(const TxReplaySource &);
+
+    // Private Member(s)
+    private:
+        // The start of a contiguous run in the file
+        struct Segment
+        {
+            uint64_t start;
+            bool hasTime;
+            uhd::time_spec_t time;
+        };
+
+        bool burstOpen;
+        const std::complex<short> *data;
+        boost::atomic<bool> done;
+        size_t fileBytes;
+        double fileSampleRate;
+        uint64_t fileSamples;
+        boost::atomic<uint64_t> lateCount;
+        bool loop;
+        boost::atomic<uint64_t> loopCount;
+        uhd::time_spec_t offset;
+        bool offsetValid;
+        uhd::time_spec_t passDuration;
+        std::string path;
+        uint64_t position;
+        double rate;
+        size_t segment;
+        std::vector<Segment> segments;
+        boost::atomic<uint64_t> sent;
+        uint64_t startNanoseconds;
+        std::string statusText;
+        mutable boost::mutex statusLock;
+        TimestampMode timestamps;
+};
+
+#endif
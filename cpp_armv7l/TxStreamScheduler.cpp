@@ -0,0 +1,181 @@
+// Class Include
+#include "TxStreamScheduler.h"
+
+// Boost Include(s)
+#include <boost/next_prior.hpp>
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+TxStreamState::TxStreamState(const bulkio::InShortStream &inputStream) :
+    burstOpen(false),
+    floatInput(false),
+    nextTimeValid(false),
+    port(0),
+    samplesSent(0),
+    sri(inputStream.sri()),
+    stream(inputStream)
+{
+}
+
+TxStreamState::TxStreamState(const bulkio::InFloatStream &inputStream) :
+    burstOpen(false),
+    floatInput(true),
+    floatStream(inputStream),
+    nextTimeValid(false),
+    port(0),
+    samplesSent(0),
+    sri(inputStream.sri())
+{
+}
+
+TxStreamScheduler::TxStreamScheduler() :
+    pendingCount(0)
+{
+    this->cursor = this->streams.end();
+}
+
+/*
+ * Public Method(s)
+ */
+
+bool TxStreamState::operator==(const TxStreamState &other) const
+{
+    if (this->floatInput != other.floatInput)
+    {
+        return false;
+    }
+
+    return (this->floatInput) ? this->floatStream == other.floatStream : this->stream == other.stream;
+}
+
+std::string TxStreamState::streamID() const
+{
+    return (this->floatInput) ? this->floatStream.streamID() : this->stream.streamID();
+}
+
+// Queue a stream to be adopted by the TX thread. Streams already in the
+// schedule are ignored when adopted.
+void TxStreamScheduler::add(const bulkio::InShortStream &stream)
+{
+    boost::mutex::scoped_lock lock(this->pendingLock);
+
+    this->pendingStreams.push_back(TxStreamState(stream));
+    this->pendingCount.store(this->pendingStreams.size(), boost::memory_order_release);
+}
+
+void TxStreamScheduler::add(const bulkio::InFloatStream &stream)
+{
+    boost::mutex::scoped_lock lock(this->pendingLock);
+
+    this->pendingStreams.push_back(TxStreamState(stream));
+    this->pendingCount.store(this->pendingStreams.size(), boost::memory_order_release);
+}
+
+// Get the number of scheduled streams read from the float input port
+size_t TxStreamScheduler::floatStreams() const
+{
+    size_t count = 0;
+
+    for (std::list<TxStreamState>::const_iterator it = this->streams.begin(); it != this->streams.end(); ++it)
+    {
+        if (it->floatInput)
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+// Get the stream whose turn it is, or NULL if there are no streams. Each call
+// moves on to the next stream, so calling this size() times visits every
+// stream once.
+TxStreamState *TxStreamScheduler::next()
+{
+    adoptPendingStreams();
+
+    if (this->streams.empty())
+    {
+        return NULL;
+    }
+
+    if (this->cursor == this->streams.end() or ++this->cursor == this->streams.end())
+    {
+        this->cursor = this->streams.begin();
+    }
+
+    return &*this->cursor;
+}
+
+// Remove a stream after its EOS, leaving the cursor such that the following
+// stream is next
+void TxStreamScheduler::remove(TxStreamState *state)
+{
+    for (std::list<TxStreamState>::iterator it = this->streams.begin(); it != this->streams.end(); ++it)
+    {
+        if (&*it == state)
+        {
+            if (it == this->cursor)
+            {
+                this->cursor = (it == this->streams.begin()) ? this->streams.end() : boost::prior(it);
+            }
+
+            this->streams.erase(it);
+
+            return;
+        }
+    }
+}
+
+size_t TxStreamScheduler::size() const
+{
+    return this->streams.size();
+}
+
+/*
+ * Private Method(s)
+ */
+
+// Move any newly added streams onto the end of the schedule. The pending
+// count is checked first, so the lock is only tried when there is something to
+// adopt, and a stream being added meanwhile is adopted on a later call.
+void TxStreamScheduler::adoptPendingStreams()
+{
+    if (this->pendingCount.load(boost::memory_order_acquire) == 0)
+    {
+        return;
+    }
+
+    boost::mutex::scoped_lock lock(this->pendingLock, boost::try_to_lock);
+
+    if (not lock.owns_lock() or this->pendingStreams.empty())
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < this->pendingStreams.size(); ++i)
+    {
+        if (not contains(this->pendingStreams[i]))
+        {
+            this->streams.push_back(this->pendingStreams[i]);
+        }
+    }
+
+    this->pendingStreams.clear();
+    this->pendingCount.store(0, boost::memory_order_relaxed);
+}
+
+bool TxStreamScheduler::contains(const TxStreamState &state) const
+{
+    for (std::list<TxStreamState>::const_iterator it = this->streams.begin(); it != this->streams.end(); ++it)
+    {
+        if (*it == state)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
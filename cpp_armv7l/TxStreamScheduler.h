@@ -0,0 +1,92 @@
+#ifndef TXSTREAMSCHEDULER_H
+#define TXSTREAMSCHEDULER_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+// BULKIO Include(s)
+#include <bulkio/bulkio.h>
+
+// Standard Include(s)
+#include <list>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * The state kept for each input stream being transmitted. Every stream has
+ * its own SRI and time base, so interleaved streams never borrow each other's
+ * timestamps or sample rate. A stream is read from either the short or the
+ * float input port, and only the matching stream member is set.
+ */
+struct TxStreamState
+{
+    TxStreamState(const bulkio::InShortStream &inputStream);
+
+    TxStreamState(const bulkio::InFloatStream &inputStream);
+
+    bool operator==(const TxStreamState &other) const;
+
+    std::string streamID() const;
+
+    // Whether a burst from this stream has been started but not ended
+    bool burstOpen;
+
+    bool floatInput;
+    bulkio::InFloatStream floatStream;
+
+    // The time of the sample following the last one sent
+    BULKIO::PrecisionUTCTime nextTime;
+    bool nextTimeValid;
+
+    // The block port the stream is sent to
+    size_t port;
+
+    uint64_t samplesSent;
+    BULKIO::StreamSRI sri;
+    bulkio::InShortStream stream;
+};
+
+/*
+ * A round-robin schedule of the active input streams. New streams may be
+ * added from any thread, but are only adopted by the TX thread, which is the
+ * only thread that touches the schedule itself.
+ */
+class TxStreamScheduler
+{
+    public:
+        TxStreamScheduler();
+
+    // Public Method(s)
+    public:
+        // Methods for any thread
+        void add(const bulkio::InShortStream &stream);
+
+        void add(const bulkio::InFloatStream &stream);
+
+        // Methods for the TX thread
+        size_t floatStreams() const;
+
+        TxStreamState *next();
+
+        void remove(TxStreamState *state);
+
+        size_t size() const;
+
+    // Private Method(s)
+    private:
+        void adoptPendingStreams();
+
+        bool contains(const TxStreamState &state) const;
+
+    // Private Member(s)
+    private:
+        std::list<TxStreamState>::iterator cursor;
+        boost::atomic<size_t> pendingCount;
+        boost::mutex pendingLock;
+        std::vector<TxStreamState> pendingStreams;
+        std::list<TxStreamState> streams;
+};
+
+#endif
@@ -0,0 +1,136 @@
+// Class Include
+#include "WaitStrategy.h"
+
+// Standard Include(s)
+#include <algorithm>
+
+// Definitions for the constants passed by reference
+const unsigned int WaitStrategy::BACKOFF_MAX_US;
+
+/*
+ * Constructor(s) and/or Destructor
+ */
+
+WaitStrategy::WaitStrategy() :
+    backoffMicroseconds(1),
+    currentMode(EVENT),
+    eventPending(false),
+    notifyTime(0),
+    spins(0)
+{
+}
+
+/*
+ * Public Method(s)
+ */
+
+// Select the strategy by name, returning false if it isn't recognized
+bool WaitStrategy::configure(const std::string &mode)
+{
+    if (mode == "busy")
+    {
+        this->currentMode = BUSY;
+    }
+    else if (mode == "spin")
+    {
+        this->currentMode = SPIN;
+    }
+    else if (mode == "backoff")
+    {
+        this->currentMode = BACKOFF;
+    }
+    else if (mode == "event")
+    {
+        this->currentMode = EVENT;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+WaitStrategy::Mode WaitStrategy::mode() const
+{
+    return Mode(this->currentMode.load(boost::memory_order_relaxed));
+}
+
+// Signal that there may be work for the waiting thread. Only the first
+// notification before the thread resumes is timed.
+void WaitStrategy::notify()
+{
+    uint64_t unset = 0;
+
+    this->notifyTime.compare_exchange_strong(unset, monotonicNanoseconds());
+
+    boost::mutex::scoped_lock lock(this->eventLock);
+
+    this->eventPending = true;
+    this->eventCondition.notify_all();
+}
+
+// Wait once after polling and finding nothing. Only the event driven wait
+// blocks for up to the timeout; the others return quickly so the thread can
+// poll again.
+void WaitStrategy::idle(double timeout)
+{
+    switch (mode())
+    {
+        case BUSY:
+            break;
+
+        case SPIN:
+            if (this->spins < SPIN_LIMIT)
+            {
+                ++this->spins;
+            }
+            else
+            {
+                boost::this_thread::yield();
+            }
+
+            break;
+
+        case BACKOFF:
+            boost::this_thread::sleep(boost::posix_time::microseconds(this->backoffMicroseconds));
+
+            this->backoffMicroseconds = std::min(2 * this->backoffMicroseconds, BACKOFF_MAX_US);
+
+            break;
+
+        case EVENT:
+        {
+            boost::mutex::scoped_lock lock(this->eventLock);
+
+            if (not this->eventPending)
+            {
+                this->eventCondition.timed_wait(lock, boost::posix_time::microseconds(long(timeout * 1e6)));
+            }
+
+            this->eventPending = false;
+
+            break;
+        }
+    }
+}
+
+// Note that the thread has found work, resetting the spin and backoff state
+// and recording how long it took to notice any notification
+void WaitStrategy::resume(LatencyHistogram &wakeLatency)
+{
+    this->spins = 0;
+    this->backoffMicroseconds = 1;
+
+    if (this->notifyTime.load(boost::memory_order_relaxed) == 0)
+    {
+        return;
+    }
+
+    uint64_t notified = this->notifyTime.exchange(0);
+
+    if (notified != 0)
+    {
+        wakeLatency.record(monotonicNanoseconds() - notified);
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef WAITSTRATEGY_H
+#define WAITSTRATEGY_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+
+// Standard Include(s)
+#include <string>
+
+/*
+ * How a streaming thread waits when it has nothing to do. The thread calls
+ * idle() each time it polls and finds nothing, and resume() once it finds
+ * work. Whatever the thread is waiting on calls notify(), which wakes an
+ * event driven wait and stamps the time so that resume() can record how
+ * long the thread took to notice.
+ */
+class WaitStrategy
+{
+    public:
+        enum Mode
+        {
+            BUSY,
+            SPIN,
+            BACKOFF,
+            EVENT
+        };
+
+        WaitStrategy();
+
+    // Public Method(s)
+    public:
+        // Methods for any thread
+        bool configure(const std::string &mode);
+
+        Mode mode() const;
+
+        void notify();
+
+        // Methods for the waiting thread
+        void idle(double timeout);
+
+        void resume(LatencyHistogram &wakeLatency);
+
+    // Private Member(s)
+    private:
+        static const unsigned int BACKOFF_MAX_US = 10000;
+        static const unsigned int SPIN_LIMIT = 1000;
+
+        unsigned int backoffMicroseconds;
+        boost::atomic<int> currentMode;
+        boost::condition_variable eventCondition;
+        boost::mutex eventLock;
+        bool eventPending;
+        boost::atomic<uint64_t> notifyTime;
+        unsigned int spins;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef FAKEPERSONA_H
+#define FAKEPERSONA_H
+
+// RF-NoC RH Include(s)
+#include <RFNoC_Persona.h>
+
+/*
+ * A persona with no hardware behind it. It has no blocks to hand out, and
+ * ignores connection notifications and stream descriptors.
+ */
+class FakePersona : public RFNoC_RH::RFNoC_Persona
+{
+    public:
+        uhd::rfnoc::block_ctrl_base::sptr getBlock(const RFNoC_RH::BlockDescriptor &blockDescriptor)
+        {
+            return uhd::rfnoc::block_ctrl_base::sptr();
+        }
+
+        void incomingConnectionAdded(const std::string &resourceId, const std::string &streamId, size_t portHash) {}
+
+        void incomingConnectionRemoved(const std::string &resourceId, const std::string &streamId, size_t portHash) {}
+
+        void outgoingConnectionAdded(const std::string &resourceId, const std::string &connectionId, size_t portHash) {}
+
+        void outgoingConnectionRemoved(const std::string &resourceId, const std::string &connectionId, size_t portHash) {}
+
+        void setRxStreamDescriptor(const std::string &resourceId, const RFNoC_RH::StreamDescriptor &streamDescriptor) {}
+
+        void setTxStreamDescriptor(const std::string &resourceId, const RFNoC_RH::StreamDescriptor &streamDescriptor) {}
+};
+
+#endif
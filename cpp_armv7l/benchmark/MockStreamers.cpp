@@ -0,0 +1,319 @@
+// Class Include
+#include "MockStreamers.h"
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+
+// Standard Include(s)
+#include <algorithm>
+#include <complex>
+
+// Sleep until the given monotonic time, in nanoseconds
+static void sleepUntil(uint64_t deadline)
+{
+    struct timespec until;
+
+    until.tv_sec = deadline / 1000000000ULL;
+    until.tv_nsec = deadline % 1000000000ULL;
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) != 0)
+    {
+    }
+}
+
+/*
+ * MockLoopback
+ */
+
+MockLoopback::MockLoopback(size_t capacity) :
+    fifo(capacity)
+{
+}
+
+// Lose the oldest samples, as a dropped packet would
+void MockLoopback::discard(size_t count)
+{
+    boost::mutex::scoped_lock lock(this->fifoLock);
+
+    this->fifo.erase_begin(std::min(count, this->fifo.size()));
+    this->writable.notify_all();
+}
+
+// Take up to the given number of samples, waiting up to the timeout for any
+// to arrive
+size_t MockLoopback::read(std::complex<short> *samples, size_t count, double timeout)
+{
+    boost::mutex::scoped_lock lock(this->fifoLock);
+
+    if (this->fifo.empty())
+    {
+        this->readable.timed_wait(lock, boost::posix_time::microseconds(long(timeout * 1e6)));
+    }
+
+    size_t numSamples = std::min(count, this->fifo.size());
+
+    std::copy(this->fifo.begin(), this->fifo.begin() + numSamples, samples);
+
+    this->fifo.erase_begin(numSamples);
+    this->writable.notify_all();
+
+    return numSamples;
+}
+
+// Add as many of the samples as there is room for, waiting up to the timeout
+// for some room if there is none
+size_t MockLoopback::write(const std::complex<short> *samples, size_t count, double timeout)
+{
+    boost::mutex::scoped_lock lock(this->fifoLock);
+
+    if (this->fifo.full())
+    {
+        this->writable.timed_wait(lock, boost::posix_time::microseconds(long(timeout * 1e6)));
+    }
+
+    size_t numSamples = std::min(count, this->fifo.capacity() - this->fifo.size());
+
+    this->fifo.insert(this->fifo.end(), samples, samples + numSamples);
+    this->readable.notify_all();
+
+    return numSamples;
+}
+
+/*
+ * MockRxStreamer
+ */
+
+MockRxStreamer::MockRxStreamer(double rate, size_t spp) :
+    calls(0),
+    finiteDone(false),
+    finiteRemaining(0),
+    overflowInterval(0),
+    produced(0),
+    producedTotal(0),
+    rate(rate),
+    spp(spp),
+    startTime(0),
+    streaming(false),
+    timeoutInterval(0)
+{
+}
+
+size_t MockRxStreamer::get_num_channels() const
+{
+    return 1;
+}
+
+size_t MockRxStreamer::get_max_num_samps() const
+{
+    return this->spp;
+}
+
+// Fill the buffer with a ramp, pacing the output to the configured rate
+size_t MockRxStreamer::recv(const buffs_type &buffs, const size_t nsamps_per_buff, uhd::rx_metadata_t &metadata, const double timeout, const bool one_packet)
+{
+    metadata.reset();
+
+    // Nothing is produced until a stream command has been issued
+    if (not this->streaming)
+    {
+        sleepUntil(monotonicNanoseconds() + uint64_t(timeout * 1e9));
+
+        metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_TIMEOUT;
+        return 0;
+    }
+
+    ++this->calls;
+
+    if (this->timeoutInterval and this->calls % this->timeoutInterval == 0)
+    {
+        metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_TIMEOUT;
+        return 0;
+    }
+
+    if (this->overflowInterval and this->calls % this->overflowInterval == 0)
+    {
+        if (this->loopback)
+        {
+            this->loopback->discard(this->spp);
+        }
+
+        metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_OVERFLOW;
+        return 0;
+    }
+
+    size_t numSamples = (one_packet) ? std::min(nsamps_per_buff, this->spp) : nsamps_per_buff;
+
+    // Finite captures end with a short, end of burst recv
+    if (this->finiteRemaining > 0)
+    {
+        numSamples = std::min<size_t>(numSamples, this->finiteRemaining);
+    }
+
+    std::complex<short> *samples = (std::complex<short> *) buffs[0];
+
+    if (this->loopback)
+    {
+        // Take whatever has come back so far
+        numSamples = this->loopback->read(samples, numSamples, timeout);
+
+        if (numSamples == 0)
+        {
+            metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_TIMEOUT;
+            return 0;
+        }
+    }
+    else
+    {
+        // Wait until the samples would have arrived at the configured rate
+        if (this->rate > 0)
+        {
+            sleepUntil(this->startTime + uint64_t((this->produced + numSamples) * 1e9 / this->rate));
+        }
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            short value = short(this->produced + i);
+            samples[i] = std::complex<short>(value, -value);
+        }
+    }
+
+    metadata.has_time_spec = true;
+    metadata.time_spec = uhd::time_spec_t(this->produced / ((this->rate > 0) ? this->rate : 1e6));
+    metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_NONE;
+
+    this->produced += numSamples;
+    this->producedTotal.store(this->produced, boost::memory_order_relaxed);
+
+    if (this->finiteRemaining > 0)
+    {
+        this->finiteRemaining -= numSamples;
+
+        if (this->finiteRemaining == 0)
+        {
+            metadata.end_of_burst = true;
+            this->streaming = not this->finiteDone;
+        }
+    }
+
+    return numSamples;
+}
+
+void MockRxStreamer::issue_stream_cmd(const uhd::stream_cmd_t &stream_cmd)
+{
+    if (stream_cmd.stream_mode == uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS)
+    {
+        this->streaming = false;
+    }
+    else
+    {
+        // Continuous streaming is modelled as a capture with no end
+        this->finiteDone = (stream_cmd.stream_mode == uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_DONE);
+        this->finiteRemaining = (stream_cmd.stream_mode == uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS) ? 0 : stream_cmd.num_samps;
+
+        // Restart the sample clock so pacing doesn't try to catch up
+        this->startTime = monotonicNanoseconds() - uint64_t(this->produced * 1e9 / ((this->rate > 0) ? this->rate : 1e6));
+        this->streaming = true;
+    }
+}
+
+uint64_t MockRxStreamer::samplesProduced() const
+{
+    return this->producedTotal.load(boost::memory_order_relaxed);
+}
+
+void MockRxStreamer::setLoopback(boost::shared_ptr<MockLoopback> loopback)
+{
+    this->loopback = loopback;
+}
+
+void MockRxStreamer::setOverflowInterval(size_t calls)
+{
+    this->overflowInterval = calls;
+}
+
+void MockRxStreamer::setTimeoutInterval(size_t calls)
+{
+    this->timeoutInterval = calls;
+}
+
+/*
+ * MockTxStreamer
+ */
+
+MockTxStreamer::MockTxStreamer(double rate, size_t spp) :
+    burstsTotal(0),
+    consumed(0),
+    consumedTotal(0),
+    rate(rate),
+    spp(spp),
+    startTime(monotonicNanoseconds())
+{
+}
+
+size_t MockTxStreamer::get_num_channels() const
+{
+    return 1;
+}
+
+size_t MockTxStreamer::get_max_num_samps() const
+{
+    return this->spp;
+}
+
+// Accept the samples, pacing the input to the configured rate
+size_t MockTxStreamer::send(const buffs_type &buffs, const size_t nsamps_per_buff, const uhd::tx_metadata_t &metadata, const double timeout)
+{
+    if (this->rate > 0)
+    {
+        // Don't let an idle period build up credit
+        uint64_t now = monotonicNanoseconds();
+        uint64_t due = this->startTime + uint64_t(this->consumed * 1e9 / this->rate);
+
+        if (due < now)
+        {
+            this->startTime += now - due;
+        }
+
+        sleepUntil(this->startTime + uint64_t((this->consumed + nsamps_per_buff) * 1e9 / this->rate));
+    }
+
+    size_t numSamples = nsamps_per_buff;
+
+    if (this->loopback)
+    {
+        numSamples = this->loopback->write((const std::complex<short> *) buffs[0], nsamps_per_buff, timeout);
+    }
+
+    if (metadata.end_of_burst and numSamples == nsamps_per_buff)
+    {
+        this->burstsTotal.fetch_add(1, boost::memory_order_relaxed);
+    }
+
+    this->consumed += numSamples;
+    this->consumedTotal.store(this->consumed, boost::memory_order_relaxed);
+
+    return numSamples;
+}
+
+// No asynchronous messages are ever generated
+bool MockTxStreamer::recv_async_msg(uhd::async_metadata_t &async_metadata, double timeout)
+{
+    sleepUntil(monotonicNanoseconds() + uint64_t(timeout * 1e9));
+
+    return false;
+}
+
+uint64_t MockTxStreamer::bursts() const
+{
+    return this->burstsTotal.load(boost::memory_order_relaxed);
+}
+
+uint64_t MockTxStreamer::samplesConsumed() const
+{
+    return this->consumedTotal.load(boost::memory_order_relaxed);
+}
+
+void MockTxStreamer::setLoopback(boost::shared_ptr<MockLoopback> loopback)
+{
+    this->loopback = loopback;
+}
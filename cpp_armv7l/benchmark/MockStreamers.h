@@ -0,0 +1,132 @@
+#ifndef MOCKSTREAMERS_H
+#define MOCKSTREAMERS_H
+
+// Boost Include(s)
+#include <boost/atomic.hpp>
+#include <boost/circular_buffer.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+// UHD Include(s)
+#include <uhd/stream.hpp>
+
+// Standard Include(s)
+#include <complex>
+#include <stdint.h>
+
+/*
+ * A bounded FIFO of sc16 samples standing in for an RF-NoC block which passes
+ * its input straight through. A mock TX streamer writes into it, waiting for
+ * room, and a mock RX streamer reads out of it.
+ */
+class MockLoopback
+{
+    public:
+        MockLoopback(size_t capacity);
+
+    // Public Method(s)
+    public:
+        void discard(size_t count);
+
+        size_t read(std::complex<short> *samples, size_t count, double timeout);
+
+        size_t write(const std::complex<short> *samples, size_t count, double timeout);
+
+    // Private Member(s)
+    private:
+        boost::circular_buffer<std::complex<short> > fifo;
+        boost::mutex fifoLock;
+        boost::condition_variable readable;
+        boost::condition_variable writable;
+};
+
+/*
+ * A stand-in for an RF-NoC RX streamer which produces synthetic sc16 samples
+ * at a fixed rate, or as fast as possible if the rate is zero. Overflows and
+ * timeouts can be injected every N calls to recv. Stream commands take effect
+ * immediately, ignoring any time spec.
+ *
+ * Given a loopback, it receives whatever the TX streamer sent instead, as
+ * soon as it arrives, and an injected overflow loses a packet of it.
+ */
+class MockRxStreamer : public uhd::rx_streamer
+{
+    public:
+        MockRxStreamer(double rate, size_t spp);
+
+    // Public uhd::rx_streamer Method(s)
+    public:
+        size_t get_num_channels() const;
+
+        size_t get_max_num_samps() const;
+
+        size_t recv(const buffs_type &buffs, const size_t nsamps_per_buff, uhd::rx_metadata_t &metadata, const double timeout = 0.1, const bool one_packet = false);
+
+        void issue_stream_cmd(const uhd::stream_cmd_t &stream_cmd);
+
+    // Public Method(s)
+    public:
+        uint64_t samplesProduced() const;
+
+        void setLoopback(boost::shared_ptr<MockLoopback> loopback);
+
+        void setOverflowInterval(size_t calls);
+
+        void setTimeoutInterval(size_t calls);
+
+    // Private Member(s)
+    private:
+        size_t calls;
+        bool finiteDone;
+        uint64_t finiteRemaining;
+        boost::shared_ptr<MockLoopback> loopback;
+        size_t overflowInterval;
+        uint64_t produced;
+        boost::atomic<uint64_t> producedTotal;
+        double rate;
+        size_t spp;
+        uint64_t startTime;
+        boost::atomic<bool> streaming;
+        size_t timeoutInterval;
+};
+
+/*
+ * A stand-in for an RF-NoC TX streamer which consumes sc16 samples at a fixed
+ * rate, or as fast as possible if the rate is zero. Given a loopback, the
+ * samples are written into it.
+ */
+class MockTxStreamer : public uhd::tx_streamer
+{
+    public:
+        MockTxStreamer(double rate, size_t spp);
+
+    // Public uhd::tx_streamer Method(s)
+    public:
+        size_t get_num_channels() const;
+
+        size_t get_max_num_samps() const;
+
+        size_t send(const buffs_type &buffs, const size_t nsamps_per_buff, const uhd::tx_metadata_t &metadata, const double timeout = 0.1);
+
+        bool recv_async_msg(uhd::async_metadata_t &async_metadata, double timeout = 0.1);
+
+    // Public Method(s)
+    public:
+        uint64_t bursts() const;
+
+        uint64_t samplesConsumed() const;
+
+        void setLoopback(boost::shared_ptr<MockLoopback> loopback);
+
+    // Private Member(s)
+    private:
+        boost::atomic<uint64_t> burstsTotal;
+        uint64_t consumed;
+        boost::atomic<uint64_t> consumedTotal;
+        boost::shared_ptr<MockLoopback> loopback;
+        double rate;
+        size_t spp;
+        uint64_t startTime;
+};
+
+#endif
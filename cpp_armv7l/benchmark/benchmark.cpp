@@ -0,0 +1,464 @@
+/*
+ * A hardware-free throughput benchmark for RFNoC_TestComponent_i. The
+ * component is driven through setRxStreamer/setTxStreamer with mock streamers
+ * standing in for the RF-NoC block, so throughput regressions can be caught on
+ * any Linux host.
+ *
+ * Usage: rfnoc_benchmark [--mode rx|tx|both|loopback] [--rate sps] [--duration s]
+ *                        [--spp n] [--packet n] [--overflow-every n]
+ *                        [--timeout-every n] [--wait busy|spin|backoff|event]
+ *                        [--tx-queue n] [--tx-queue-policy block|dropOldest|dropNewest]
+ *                        [--capture path] [--replay path] [--trace path]
+ *                        [--emulate passthrough|gain|fir] [--taps n]
+ *
+ * A rate of zero runs the mock streamers as fast as possible. A replay file
+ * feeds the TX path in place of the BulkIO producer, looping without pacing,
+ * so only the block ingest is measured. A trace path gets a Chrome trace of
+ * the end of the run, including the end-to-end ages.
+ *
+ * The loopback mode joins the mock streamers into a pass-through block and
+ * runs the component's self test over it for the duration instead, with any
+ * injected overflows losing packets of the pattern.
+ *
+ * The TX queue is off unless a depth is given. Running with --tx-queue 0 and
+ * then with a depth shows whether the extra hand-off behind the input ports'
+ * own queue pays off at a given rate and packet size.
+ *
+ * Emulating the block replaces the mock streamers with the component's own
+ * CPU emulation, running the given function, with the given number of taps
+ * for a FIR. The TX input then loops back out of the RX output, giving a CPU
+ * baseline for the block.
+ */
+
+// Component Include
+#include "RFNoC_TestComponent.h"
+
+// Local Include(s)
+#include "FakePersona.h"
+#include "MockStreamers.h"
+
+// Standard Include(s)
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <sys/resource.h>
+
+struct BenchmarkOptions
+{
+    BenchmarkOptions() :
+        capturePath(""),
+        duration(10),
+        emulate(""),
+        loopback(false),
+        overflowEvery(0),
+        packetSize(8192),
+        rate(0),
+        replayPath(""),
+        rx(true),
+        spp(512),
+        taps(32),
+        timeoutEvery(0),
+        tracePath(""),
+        tx(true),
+        txQueueDepth(0),
+        txQueuePolicy("block"),
+        waitStrategy("event")
+    {
+    }
+
+    std::string capturePath;
+    double duration;
+    std::string emulate;
+    bool loopback;
+    size_t overflowEvery;
+    size_t packetSize;
+    double rate;
+    std::string replayPath;
+    bool rx;
+    size_t spp;
+    size_t taps;
+    size_t timeoutEvery;
+    std::string tracePath;
+    bool tx;
+    size_t txQueueDepth;
+    std::string txQueuePolicy;
+    std::string waitStrategy;
+};
+
+/*
+ * Runs the component against the mock streamers and reports the results
+ */
+class ComponentBenchmark
+{
+    public:
+        ComponentBenchmark(const BenchmarkOptions &options);
+        ~ComponentBenchmark();
+
+    // Public Method(s)
+    public:
+        void run();
+
+    // Private Method(s)
+    private:
+        static double cpuSeconds();
+
+        void produce();
+
+        void runSelfTest();
+
+    // Private Member(s)
+    private:
+        RFNoC_TestComponent_i *component;
+        BenchmarkOptions options;
+        FakePersona persona;
+        boost::shared_ptr<MockRxStreamer> rxStreamer;
+        boost::shared_ptr<MockTxStreamer> txStreamer;
+        boost::atomic<bool> producing;
+};
+
+ComponentBenchmark::ComponentBenchmark(const BenchmarkOptions &options) :
+    options(options),
+    producing(false)
+{
+    this->component = new RFNoC_TestComponent_i("RFNoC_TestComponent_benchmark", "RFNoC_TestComponent_benchmark");
+    this->component->setPersona(&this->persona);
+
+    this->component->blockID = "benchmark";
+    this->component->rxCapture.path = options.capturePath;
+    this->component->spp = options.spp;
+    this->component->txReplay.path = options.replayPath;
+    this->component->latencyTrace.enabled = not options.tracePath.empty();
+    this->component->latencyTrace.endToEnd = true;
+    this->component->latencyTrace.path = options.tracePath;
+    this->component->txQueueDepth = options.txQueueDepth;
+    this->component->txQueuePolicy = options.txQueuePolicy;
+    this->component->waitStrategy = options.waitStrategy;
+
+    if (options.emulate.empty())
+    {
+        // Skip the block lookup in constructor(), there is no block to find
+        this->component->initializeStreaming();
+        return;
+    }
+
+    // A moving average stands in for a real filter
+    std::ostringstream taps;
+
+    for (size_t i = 0; i < options.taps; ++i)
+    {
+        taps << ((i > 0) ? "," : "") << 1.0 / options.taps;
+    }
+
+    this->component->args.resize(3);
+    this->component->args[0].id = "function";
+    this->component->args[0].value = options.emulate;
+    this->component->args[1].id = "gain";
+    this->component->args[1].value = "0.5";
+    this->component->args[2].id = "taps";
+    this->component->args[2].value = taps.str();
+    this->component->blockEmulation = "always";
+    this->component->constructor();
+}
+
+ComponentBenchmark::~ComponentBenchmark()
+{
+    delete this->component;
+}
+
+// Stream for the configured duration and report the sustained rates
+void ComponentBenchmark::run()
+{
+    if (this->options.loopback)
+    {
+        runSelfTest();
+        return;
+    }
+
+    // The RX path waits for SRI from the input port before streaming
+    BULKIO::StreamSRI sri = bulkio::sri::create("benchmark", (this->options.rate > 0) ? this->options.rate : 1e6);
+    sri.mode = 1;
+    sri.blocking = true;
+
+    this->component->dataShort_in->pushSRI(sri);
+
+    if (this->options.rx and this->options.emulate.empty())
+    {
+        this->rxStreamer = boost::make_shared<MockRxStreamer>(this->options.rate, this->options.spp);
+        this->rxStreamer->setOverflowInterval(this->options.overflowEvery);
+        this->rxStreamer->setTimeoutInterval(this->options.timeoutEvery);
+
+        this->component->setRxStreamer(this->rxStreamer);
+    }
+
+    if (this->options.tx and this->options.emulate.empty())
+    {
+        this->txStreamer = boost::make_shared<MockTxStreamer>(this->options.rate, this->options.spp);
+
+        this->component->setTxStreamer(this->txStreamer);
+    }
+
+    this->component->start();
+
+    boost::thread producer;
+
+    if (this->options.tx and this->options.replayPath.empty())
+    {
+        this->producing = true;
+        producer = boost::thread(&ComponentBenchmark::produce, this);
+    }
+
+    // Let the pipeline fill before measuring
+    boost::this_thread::sleep(boost::posix_time::seconds(1));
+    this->component->getPerformance();
+
+    uint64_t rxStart = (this->rxStreamer) ? this->rxStreamer->samplesProduced() : 0;
+    uint64_t txStart = (this->txStreamer) ? this->txStreamer->samplesConsumed() : 0;
+    double cpuStart = cpuSeconds();
+    uint64_t wallStart = monotonicNanoseconds();
+
+    boost::this_thread::sleep(boost::posix_time::microseconds(long(this->options.duration * 1e6)));
+
+    uint64_t rxEnd = (this->rxStreamer) ? this->rxStreamer->samplesProduced() : 0;
+    uint64_t txEnd = (this->txStreamer) ? this->txStreamer->samplesConsumed() : 0;
+    double cpuEnd = cpuSeconds();
+    double wall = (monotonicNanoseconds() - wallStart) / 1e9;
+
+    performance_struct performance = this->component->getPerformance();
+
+    if (not this->options.tracePath.empty())
+    {
+        this->component->trace.exportTrace(this->options.tracePath, "chrome");
+    }
+
+    this->producing = false;
+
+    if (producer.joinable())
+    {
+        producer.join();
+    }
+
+    this->component->stop();
+
+    // Only the stop itself is timed, the teardown below is not
+    double stopLatency = this->component->getPerformance().stopLatency;
+
+    this->component->setRxStreamer(uhd::rx_streamer::sptr());
+    this->component->setTxStreamer(uhd::tx_streamer::sptr());
+
+    // Report the results. An emulated block is measured at the ports instead.
+    double rxMsps = (this->options.emulate.empty()) ? (rxEnd - rxStart) / wall / 1e6 : performance.outputRate / 1e6;
+    double txMsps = (this->options.emulate.empty()) ? (txEnd - txStart) / wall / 1e6 : performance.inputRate / 1e6;
+    double cpu = (cpuEnd - cpuStart) / wall;
+
+    std::cout << "duration:          " << wall << " s" << std::endl;
+    std::cout << "rx rate:           " << rxMsps << " Msps" << std::endl;
+    std::cout << "tx rate:           " << txMsps << " Msps" << std::endl;
+    std::cout << "cpu:               " << cpu * 100 << " %" << std::endl;
+
+    if (rxMsps + txMsps > 0)
+    {
+        std::cout << "cpu per Msps:      " << cpu * 100 / (rxMsps + txMsps) << " %" << std::endl;
+    }
+
+    std::cout << "recv latency:      " << performance.recvLatencyP50 << " us p50, " << performance.recvLatencyP99 << " us p99" << std::endl;
+    std::cout << "push latency:      " << performance.pushLatencyP50 << " us p50, " << performance.pushLatencyP99 << " us p99" << std::endl;
+    std::cout << "RX wake latency:   " << performance.rxWakeLatencyP50 << " us p50, " << performance.rxWakeLatencyP99 << " us p99" << std::endl;
+    std::cout << "TX wake latency:   " << performance.txWakeLatencyP50 << " us p50, " << performance.txWakeLatencyP99 << " us p99" << std::endl;
+    std::cout << "send latency:      " << performance.sendLatencyP50 << " us p50, " << performance.sendLatencyP99 << " us p99" << std::endl;
+    std::cout << "overflows:         " << performance.overflows << std::endl;
+    std::cout << "gaps:              " << performance.gaps << std::endl;
+    std::cout << "timeouts:          " << performance.timeouts << std::endl;
+    std::cout << "underflows:        " << performance.underflows << std::endl;
+    std::cout << "late packets:      " << performance.latePackets << std::endl;
+    std::cout << "TX path:           " << ((this->options.txQueueDepth > 0) ? "queued" : "direct") << std::endl;
+    std::cout << "TX queue drops:    " << performance.txQueueDroppedOldest << " oldest, " << performance.txQueueDroppedNewest << " newest" << std::endl;
+    std::cout << "TX queue blocked:  " << performance.txQueueBlockedTime << " s" << std::endl;
+    std::cout << "dropped buffers:   " << this->component->getRxDroppedBuffers() << std::endl;
+    std::cout << "buffer pool:       " << performance.bufferPoolHighWater / 1048576.0 << " MiB high water, " << performance.bufferPoolExhaustions << " exhaustions" << std::endl;
+    std::cout << "capture dropped:   " << performance.captureDroppedSamples << " samples" << std::endl;
+    std::cout << "replay:            " << performance.replayLoops << " loops, " << performance.replayLateRuns << " late runs" << std::endl;
+    std::cout << "latency trace:     " << this->component->trace.status() << std::endl;
+    std::cout << "block:             " << this->component->getBlockEmulationStatus() << std::endl;
+    std::cout << "start latency:     " << performance.startLatency * 1e3 << " ms" << std::endl;
+    std::cout << "stop latency:      " << stopLatency * 1e3 << " ms" << std::endl;
+}
+
+// Run the self test over the mock streamers, joined by a loopback, and report
+// its results
+void ComponentBenchmark::runSelfTest()
+{
+    // An emulated block already loops back
+    if (this->options.emulate.empty())
+    {
+        boost::shared_ptr<MockLoopback> loopback = boost::make_shared<MockLoopback>(16 * this->options.spp);
+
+        this->rxStreamer = boost::make_shared<MockRxStreamer>(this->options.rate, this->options.spp);
+        this->rxStreamer->setLoopback(loopback);
+        this->rxStreamer->setOverflowInterval(this->options.overflowEvery);
+        this->rxStreamer->setTimeoutInterval(this->options.timeoutEvery);
+
+        this->txStreamer = boost::make_shared<MockTxStreamer>(0, this->options.spp);
+        this->txStreamer->setLoopback(loopback);
+
+        this->component->setRxStreamer(this->rxStreamer);
+        this->component->setTxStreamer(this->txStreamer);
+    }
+
+    this->component->start();
+
+    this->component->selfTest.duration = this->options.duration;
+    this->component->selfTest.rate = this->options.rate;
+    this->component->selfTestRun = true;
+    this->component->selfTestRunChanged(false, true);
+
+    std::string status = this->component->getSelfTestStatus();
+
+    while (status.compare(0, 8, "complete") != 0 and status != "aborted" and status != "idle")
+    {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+        status = this->component->getSelfTestStatus();
+    }
+
+    selfTestResults_struct results = this->component->getSelfTestResults();
+    performance_struct performance = this->component->getPerformance();
+
+    this->component->stop();
+    this->component->setRxStreamer(uhd::rx_streamer::sptr());
+    this->component->setTxStreamer(uhd::tx_streamer::sptr());
+
+    std::cout << "self test:         " << status << std::endl;
+    std::cout << "duration:          " << results.duration << " s" << std::endl;
+    std::cout << "throughput:        " << results.throughput << " Msps" << std::endl;
+    std::cout << "samples:           " << results.samplesSent << " sent, " << results.samplesReceived << " received" << std::endl;
+    std::cout << "dropped samples:   " << results.droppedSamples << std::endl;
+    std::cout << "reordered samples: " << results.reorderedSamples << std::endl;
+    std::cout << "round trip:        " << results.roundTripP50 << " us p50, " << results.roundTripP99 << " us p99" << std::endl;
+    std::cout << "overflows:         " << performance.overflows << std::endl;
+    std::cout << "timeouts:          " << performance.timeouts << std::endl;
+}
+
+// The user and system CPU time used by this process
+double ComponentBenchmark::cpuSeconds()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+// Feed the input port as fast as it will accept packets. The SRI is blocking,
+// so the port applies back pressure once its queue is full.
+void ComponentBenchmark::produce()
+{
+    PortTypes::ShortSequence data;
+    data.length(this->options.packetSize * 2);
+
+    for (size_t i = 0; i < data.length(); ++i)
+    {
+        data[i] = short(i);
+    }
+
+    BULKIO::PrecisionUTCTime time = bulkio::time::utils::now();
+    double packetDuration = this->options.packetSize / ((this->options.rate > 0) ? this->options.rate : 1e6);
+
+    while (this->producing)
+    {
+        this->component->dataShort_in->pushPacket(data, time, false, "benchmark");
+
+        time.tfsec += packetDuration;
+
+        if (time.tfsec >= 1.0)
+        {
+            time.twsec += 1.0;
+            time.tfsec -= 1.0;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    BenchmarkOptions options;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (strcmp(argv[i], "--mode") == 0)
+        {
+            options.loopback = (strcmp(argv[i + 1], "loopback") == 0);
+            options.rx = (strcmp(argv[i + 1], "tx") != 0);
+            options.tx = (strcmp(argv[i + 1], "rx") != 0);
+        }
+        else if (strcmp(argv[i], "--rate") == 0)
+        {
+            options.rate = atof(argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--duration") == 0)
+        {
+            options.duration = atof(argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--spp") == 0)
+        {
+            options.spp = atol(argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--packet") == 0)
+        {
+            options.packetSize = atol(argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--overflow-every") == 0)
+        {
+            options.overflowEvery = atol(argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--timeout-every") == 0)
+        {
+            options.timeoutEvery = atol(argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--wait") == 0)
+        {
+            options.waitStrategy = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--tx-queue") == 0)
+        {
+            options.txQueueDepth = atol(argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--tx-queue-policy") == 0)
+        {
+            options.txQueuePolicy = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--capture") == 0)
+        {
+            options.capturePath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--replay") == 0)
+        {
+            options.replayPath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--trace") == 0)
+        {
+            options.tracePath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--emulate") == 0)
+        {
+            options.emulate = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--taps") == 0)
+        {
+            options.taps = atol(argv[i + 1]);
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    ossie::corba::CorbaInit(argc, argv);
+
+    {
+        ComponentBenchmark benchmark(options);
+        benchmark.run();
+    }
+
+    ossie::corba::OrbShutdown(true);
+
+    return 0;
+}
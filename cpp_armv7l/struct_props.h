@@ -60,4 +60,1096 @@ inline bool operator!= (const arg_struct& s1, const arg_struct& s2) {
     return !(s1==s2);
 }
 
+struct performance_struct {
+    performance_struct ()
+    {
+        inputRate = 0.0;
+        outputRate = 0.0;
+        overflows = 0;
+        timeouts = 0;
+        restarts = 0;
+        emptyPackets = 0;
+        gaps = 0;
+        underflows = 0;
+        latePackets = 0;
+        sequenceErrors = 0;
+        recvLatencyP50 = 0.0;
+        recvLatencyP99 = 0.0;
+        sendLatencyP50 = 0.0;
+        sendLatencyP99 = 0.0;
+        pushLatencyP50 = 0.0;
+        pushLatencyP99 = 0.0;
+        pushBlockedTime = 0.0;
+        rxWakeLatencyP50 = 0.0;
+        rxWakeLatencyP99 = 0.0;
+        txWakeLatencyP50 = 0.0;
+        txWakeLatencyP99 = 0.0;
+        txLeadTime = 0.0;
+        txQueueDroppedOldest = 0;
+        txQueueDroppedNewest = 0;
+        txQueueBlockedTime = 0.0;
+        stopLatency = 0.0;
+        startLatency = 0.0;
+        bufferPoolInUse = 0;
+        bufferPoolHighWater = 0;
+        bufferPoolReserved = 0;
+        bufferPoolExhaustions = 0;
+        captureDroppedSamples = 0;
+        replayLoops = 0;
+        replayLateRuns = 0;
+        rxBlockTimeouts = 0;
+    };
+
+    static std::string getId() {
+        return std::string("performance");
+    };
+
+    double inputRate;
+    double outputRate;
+    CORBA::ULong overflows;
+    CORBA::ULong timeouts;
+    CORBA::ULong restarts;
+    CORBA::ULong emptyPackets;
+    CORBA::ULong gaps;
+    CORBA::ULong underflows;
+    CORBA::ULong latePackets;
+    CORBA::ULong sequenceErrors;
+    double recvLatencyP50;
+    double recvLatencyP99;
+    double sendLatencyP50;
+    double sendLatencyP99;
+    double pushLatencyP50;
+    double pushLatencyP99;
+    double pushBlockedTime;
+    double rxWakeLatencyP50;
+    double rxWakeLatencyP99;
+    double txWakeLatencyP50;
+    double txWakeLatencyP99;
+    double txLeadTime;
+    CORBA::ULong txQueueDroppedOldest;
+    CORBA::ULong txQueueDroppedNewest;
+    double txQueueBlockedTime;
+    double stopLatency;
+    double startLatency;
+    CORBA::ULongLong bufferPoolInUse;
+    CORBA::ULongLong bufferPoolHighWater;
+    CORBA::ULongLong bufferPoolReserved;
+    CORBA::ULong bufferPoolExhaustions;
+    CORBA::ULongLong captureDroppedSamples;
+    CORBA::ULongLong replayLoops;
+    CORBA::ULongLong replayLateRuns;
+    CORBA::ULongLong rxBlockTimeouts;
+};
+
+inline bool operator>>= (const CORBA::Any& a, performance_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("performance::inputRate")) {
+        if (!(props["performance::inputRate"] >>= s.inputRate)) return false;
+    }
+    if (props.contains("performance::outputRate")) {
+        if (!(props["performance::outputRate"] >>= s.outputRate)) return false;
+    }
+    if (props.contains("performance::overflows")) {
+        if (!(props["performance::overflows"] >>= s.overflows)) return false;
+    }
+    if (props.contains("performance::timeouts")) {
+        if (!(props["performance::timeouts"] >>= s.timeouts)) return false;
+    }
+    if (props.contains("performance::restarts")) {
+        if (!(props["performance::restarts"] >>= s.restarts)) return false;
+    }
+    if (props.contains("performance::emptyPackets")) {
+        if (!(props["performance::emptyPackets"] >>= s.emptyPackets)) return false;
+    }
+    if (props.contains("performance::gaps")) {
+        if (!(props["performance::gaps"] >>= s.gaps)) return false;
+    }
+    if (props.contains("performance::underflows")) {
+        if (!(props["performance::underflows"] >>= s.underflows)) return false;
+    }
+    if (props.contains("performance::latePackets")) {
+        if (!(props["performance::latePackets"] >>= s.latePackets)) return false;
+    }
+    if (props.contains("performance::sequenceErrors")) {
+        if (!(props["performance::sequenceErrors"] >>= s.sequenceErrors)) return false;
+    }
+    if (props.contains("performance::recvLatencyP50")) {
+        if (!(props["performance::recvLatencyP50"] >>= s.recvLatencyP50)) return false;
+    }
+    if (props.contains("performance::recvLatencyP99")) {
+        if (!(props["performance::recvLatencyP99"] >>= s.recvLatencyP99)) return false;
+    }
+    if (props.contains("performance::sendLatencyP50")) {
+        if (!(props["performance::sendLatencyP50"] >>= s.sendLatencyP50)) return false;
+    }
+    if (props.contains("performance::sendLatencyP99")) {
+        if (!(props["performance::sendLatencyP99"] >>= s.sendLatencyP99)) return false;
+    }
+    if (props.contains("performance::pushLatencyP50")) {
+        if (!(props["performance::pushLatencyP50"] >>= s.pushLatencyP50)) return false;
+    }
+    if (props.contains("performance::pushLatencyP99")) {
+        if (!(props["performance::pushLatencyP99"] >>= s.pushLatencyP99)) return false;
+    }
+    if (props.contains("performance::pushBlockedTime")) {
+        if (!(props["performance::pushBlockedTime"] >>= s.pushBlockedTime)) return false;
+    }
+    if (props.contains("performance::rxWakeLatencyP50")) {
+        if (!(props["performance::rxWakeLatencyP50"] >>= s.rxWakeLatencyP50)) return false;
+    }
+    if (props.contains("performance::rxWakeLatencyP99")) {
+        if (!(props["performance::rxWakeLatencyP99"] >>= s.rxWakeLatencyP99)) return false;
+    }
+    if (props.contains("performance::txWakeLatencyP50")) {
+        if (!(props["performance::txWakeLatencyP50"] >>= s.txWakeLatencyP50)) return false;
+    }
+    if (props.contains("performance::txWakeLatencyP99")) {
+        if (!(props["performance::txWakeLatencyP99"] >>= s.txWakeLatencyP99)) return false;
+    }
+    if (props.contains("performance::txLeadTime")) {
+        if (!(props["performance::txLeadTime"] >>= s.txLeadTime)) return false;
+    }
+    if (props.contains("performance::txQueueDroppedOldest")) {
+        if (!(props["performance::txQueueDroppedOldest"] >>= s.txQueueDroppedOldest)) return false;
+    }
+    if (props.contains("performance::txQueueDroppedNewest")) {
+        if (!(props["performance::txQueueDroppedNewest"] >>= s.txQueueDroppedNewest)) return false;
+    }
+    if (props.contains("performance::txQueueBlockedTime")) {
+        if (!(props["performance::txQueueBlockedTime"] >>= s.txQueueBlockedTime)) return false;
+    }
+    if (props.contains("performance::stopLatency")) {
+        if (!(props["performance::stopLatency"] >>= s.stopLatency)) return false;
+    }
+    if (props.contains("performance::startLatency")) {
+        if (!(props["performance::startLatency"] >>= s.startLatency)) return false;
+    }
+    if (props.contains("performance::bufferPoolInUse")) {
+        if (!(props["performance::bufferPoolInUse"] >>= s.bufferPoolInUse)) return false;
+    }
+    if (props.contains("performance::bufferPoolHighWater")) {
+        if (!(props["performance::bufferPoolHighWater"] >>= s.bufferPoolHighWater)) return false;
+    }
+    if (props.contains("performance::bufferPoolReserved")) {
+        if (!(props["performance::bufferPoolReserved"] >>= s.bufferPoolReserved)) return false;
+    }
+    if (props.contains("performance::bufferPoolExhaustions")) {
+        if (!(props["performance::bufferPoolExhaustions"] >>= s.bufferPoolExhaustions)) return false;
+    }
+    if (props.contains("performance::captureDroppedSamples")) {
+        if (!(props["performance::captureDroppedSamples"] >>= s.captureDroppedSamples)) return false;
+    }
+    if (props.contains("performance::replayLoops")) {
+        if (!(props["performance::replayLoops"] >>= s.replayLoops)) return false;
+    }
+    if (props.contains("performance::replayLateRuns")) {
+        if (!(props["performance::replayLateRuns"] >>= s.replayLateRuns)) return false;
+    }
+    if (props.contains("performance::rxBlockTimeouts")) {
+        if (!(props["performance::rxBlockTimeouts"] >>= s.rxBlockTimeouts)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const performance_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["performance::inputRate"] = s.inputRate;
+ 
+    props["performance::outputRate"] = s.outputRate;
+ 
+    props["performance::overflows"] = s.overflows;
+ 
+    props["performance::timeouts"] = s.timeouts;
+ 
+    props["performance::restarts"] = s.restarts;
+ 
+    props["performance::emptyPackets"] = s.emptyPackets;
+ 
+    props["performance::gaps"] = s.gaps;
+ 
+    props["performance::underflows"] = s.underflows;
+ 
+    props["performance::latePackets"] = s.latePackets;
+ 
+    props["performance::sequenceErrors"] = s.sequenceErrors;
+ 
+    props["performance::recvLatencyP50"] = s.recvLatencyP50;
+ 
+    props["performance::recvLatencyP99"] = s.recvLatencyP99;
+ 
+    props["performance::sendLatencyP50"] = s.sendLatencyP50;
+ 
+    props["performance::sendLatencyP99"] = s.sendLatencyP99;
+ 
+    props["performance::pushLatencyP50"] = s.pushLatencyP50;
+ 
+    props["performance::pushLatencyP99"] = s.pushLatencyP99;
+ 
+    props["performance::pushBlockedTime"] = s.pushBlockedTime;
+ 
+    props["performance::rxWakeLatencyP50"] = s.rxWakeLatencyP50;
+ 
+    props["performance::rxWakeLatencyP99"] = s.rxWakeLatencyP99;
+ 
+    props["performance::txWakeLatencyP50"] = s.txWakeLatencyP50;
+ 
+    props["performance::txWakeLatencyP99"] = s.txWakeLatencyP99;
+ 
+    props["performance::txLeadTime"] = s.txLeadTime;
+ 
+    props["performance::txQueueDroppedOldest"] = s.txQueueDroppedOldest;
+ 
+    props["performance::txQueueDroppedNewest"] = s.txQueueDroppedNewest;
+ 
+    props["performance::txQueueBlockedTime"] = s.txQueueBlockedTime;
+ 
+    props["performance::stopLatency"] = s.stopLatency;
+ 
+    props["performance::startLatency"] = s.startLatency;
+ 
+    props["performance::bufferPoolInUse"] = s.bufferPoolInUse;
+ 
+    props["performance::bufferPoolHighWater"] = s.bufferPoolHighWater;
+ 
+    props["performance::bufferPoolReserved"] = s.bufferPoolReserved;
+ 
+    props["performance::bufferPoolExhaustions"] = s.bufferPoolExhaustions;
+ 
+    props["performance::captureDroppedSamples"] = s.captureDroppedSamples;
+ 
+    props["performance::replayLoops"] = s.replayLoops;
+ 
+    props["performance::replayLateRuns"] = s.replayLateRuns;
+ 
+    props["performance::rxBlockTimeouts"] = s.rxBlockTimeouts;
+    a <<= props;
+}
+
+inline bool operator== (const performance_struct& s1, const performance_struct& s2) {
+    if (s1.inputRate!=s2.inputRate)
+        return false;
+    if (s1.outputRate!=s2.outputRate)
+        return false;
+    if (s1.overflows!=s2.overflows)
+        return false;
+    if (s1.timeouts!=s2.timeouts)
+        return false;
+    if (s1.restarts!=s2.restarts)
+        return false;
+    if (s1.emptyPackets!=s2.emptyPackets)
+        return false;
+    if (s1.gaps!=s2.gaps)
+        return false;
+    if (s1.underflows!=s2.underflows)
+        return false;
+    if (s1.latePackets!=s2.latePackets)
+        return false;
+    if (s1.sequenceErrors!=s2.sequenceErrors)
+        return false;
+    if (s1.recvLatencyP50!=s2.recvLatencyP50)
+        return false;
+    if (s1.recvLatencyP99!=s2.recvLatencyP99)
+        return false;
+    if (s1.sendLatencyP50!=s2.sendLatencyP50)
+        return false;
+    if (s1.sendLatencyP99!=s2.sendLatencyP99)
+        return false;
+    if (s1.pushLatencyP50!=s2.pushLatencyP50)
+        return false;
+    if (s1.pushLatencyP99!=s2.pushLatencyP99)
+        return false;
+    if (s1.pushBlockedTime!=s2.pushBlockedTime)
+        return false;
+    if (s1.rxWakeLatencyP50!=s2.rxWakeLatencyP50)
+        return false;
+    if (s1.rxWakeLatencyP99!=s2.rxWakeLatencyP99)
+        return false;
+    if (s1.txWakeLatencyP50!=s2.txWakeLatencyP50)
+        return false;
+    if (s1.txWakeLatencyP99!=s2.txWakeLatencyP99)
+        return false;
+    if (s1.txLeadTime!=s2.txLeadTime)
+        return false;
+    if (s1.txQueueDroppedOldest!=s2.txQueueDroppedOldest)
+        return false;
+    if (s1.txQueueDroppedNewest!=s2.txQueueDroppedNewest)
+        return false;
+    if (s1.txQueueBlockedTime!=s2.txQueueBlockedTime)
+        return false;
+    if (s1.stopLatency!=s2.stopLatency)
+        return false;
+    if (s1.startLatency!=s2.startLatency)
+        return false;
+    if (s1.bufferPoolInUse!=s2.bufferPoolInUse)
+        return false;
+    if (s1.bufferPoolHighWater!=s2.bufferPoolHighWater)
+        return false;
+    if (s1.bufferPoolReserved!=s2.bufferPoolReserved)
+        return false;
+    if (s1.bufferPoolExhaustions!=s2.bufferPoolExhaustions)
+        return false;
+    if (s1.captureDroppedSamples!=s2.captureDroppedSamples)
+        return false;
+    if (s1.replayLoops!=s2.replayLoops)
+        return false;
+    if (s1.replayLateRuns!=s2.replayLateRuns)
+        return false;
+    if (s1.rxBlockTimeouts!=s2.rxBlockTimeouts)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const performance_struct& s1, const performance_struct& s2) {
+    return !(s1==s2);
+}
+
+struct rxStreamControl_struct {
+    rxStreamControl_struct ()
+    {
+        mode = "continuous";
+        startTime = 0.0;
+        numSamples = 1000000;
+        period = 1.0;
+    };
+
+    static std::string getId() {
+        return std::string("rxStreamControl");
+    };
+
+    std::string mode;
+    double startTime;
+    CORBA::ULong numSamples;
+    double period;
+};
+
+inline bool operator>>= (const CORBA::Any& a, rxStreamControl_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("rxStreamControl::mode")) {
+        if (!(props["rxStreamControl::mode"] >>= s.mode)) return false;
+    }
+    if (props.contains("rxStreamControl::startTime")) {
+        if (!(props["rxStreamControl::startTime"] >>= s.startTime)) return false;
+    }
+    if (props.contains("rxStreamControl::numSamples")) {
+        if (!(props["rxStreamControl::numSamples"] >>= s.numSamples)) return false;
+    }
+    if (props.contains("rxStreamControl::period")) {
+        if (!(props["rxStreamControl::period"] >>= s.period)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const rxStreamControl_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["rxStreamControl::mode"] = s.mode;
+ 
+    props["rxStreamControl::startTime"] = s.startTime;
+ 
+    props["rxStreamControl::numSamples"] = s.numSamples;
+ 
+    props["rxStreamControl::period"] = s.period;
+    a <<= props;
+}
+
+inline bool operator== (const rxStreamControl_struct& s1, const rxStreamControl_struct& s2) {
+    if (s1.mode!=s2.mode)
+        return false;
+    if (s1.startTime!=s2.startTime)
+        return false;
+    if (s1.numSamples!=s2.numSamples)
+        return false;
+    if (s1.period!=s2.period)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const rxStreamControl_struct& s1, const rxStreamControl_struct& s2) {
+    return !(s1==s2);
+}
+
+struct rxThreadPolicy_struct {
+    rxThreadPolicy_struct ()
+    {
+        cpus = "";
+        policy = "other";
+        priority = 50;
+    };
+
+    static std::string getId() {
+        return std::string("rxThreadPolicy");
+    };
+
+    std::string cpus;
+    std::string policy;
+    CORBA::Long priority;
+};
+
+inline bool operator>>= (const CORBA::Any& a, rxThreadPolicy_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("rxThreadPolicy::cpus")) {
+        if (!(props["rxThreadPolicy::cpus"] >>= s.cpus)) return false;
+    }
+    if (props.contains("rxThreadPolicy::policy")) {
+        if (!(props["rxThreadPolicy::policy"] >>= s.policy)) return false;
+    }
+    if (props.contains("rxThreadPolicy::priority")) {
+        if (!(props["rxThreadPolicy::priority"] >>= s.priority)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const rxThreadPolicy_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["rxThreadPolicy::cpus"] = s.cpus;
+ 
+    props["rxThreadPolicy::policy"] = s.policy;
+ 
+    props["rxThreadPolicy::priority"] = s.priority;
+    a <<= props;
+}
+
+inline bool operator== (const rxThreadPolicy_struct& s1, const rxThreadPolicy_struct& s2) {
+    if (s1.cpus!=s2.cpus)
+        return false;
+    if (s1.policy!=s2.policy)
+        return false;
+    if (s1.priority!=s2.priority)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const rxThreadPolicy_struct& s1, const rxThreadPolicy_struct& s2) {
+    return !(s1==s2);
+}
+
+struct txThreadPolicy_struct {
+    txThreadPolicy_struct ()
+    {
+        cpus = "";
+        policy = "other";
+        priority = 50;
+    };
+
+    static std::string getId() {
+        return std::string("txThreadPolicy");
+    };
+
+    std::string cpus;
+    std::string policy;
+    CORBA::Long priority;
+};
+
+inline bool operator>>= (const CORBA::Any& a, txThreadPolicy_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("txThreadPolicy::cpus")) {
+        if (!(props["txThreadPolicy::cpus"] >>= s.cpus)) return false;
+    }
+    if (props.contains("txThreadPolicy::policy")) {
+        if (!(props["txThreadPolicy::policy"] >>= s.policy)) return false;
+    }
+    if (props.contains("txThreadPolicy::priority")) {
+        if (!(props["txThreadPolicy::priority"] >>= s.priority)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const txThreadPolicy_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["txThreadPolicy::cpus"] = s.cpus;
+ 
+    props["txThreadPolicy::policy"] = s.policy;
+ 
+    props["txThreadPolicy::priority"] = s.priority;
+    a <<= props;
+}
+
+inline bool operator== (const txThreadPolicy_struct& s1, const txThreadPolicy_struct& s2) {
+    if (s1.cpus!=s2.cpus)
+        return false;
+    if (s1.policy!=s2.policy)
+        return false;
+    if (s1.priority!=s2.priority)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const txThreadPolicy_struct& s1, const txThreadPolicy_struct& s2) {
+    return !(s1==s2);
+}
+
+struct txBurstControl_struct {
+    txBurstControl_struct ()
+    {
+        leadTime = 0.0;
+        adaptiveLeadTime = false;
+        maxLeadTime = 0.1;
+    };
+
+    static std::string getId() {
+        return std::string("txBurstControl");
+    };
+
+    double leadTime;
+    bool adaptiveLeadTime;
+    double maxLeadTime;
+};
+
+inline bool operator>>= (const CORBA::Any& a, txBurstControl_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("txBurstControl::leadTime")) {
+        if (!(props["txBurstControl::leadTime"] >>= s.leadTime)) return false;
+    }
+    if (props.contains("txBurstControl::adaptiveLeadTime")) {
+        if (!(props["txBurstControl::adaptiveLeadTime"] >>= s.adaptiveLeadTime)) return false;
+    }
+    if (props.contains("txBurstControl::maxLeadTime")) {
+        if (!(props["txBurstControl::maxLeadTime"] >>= s.maxLeadTime)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const txBurstControl_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["txBurstControl::leadTime"] = s.leadTime;
+ 
+    props["txBurstControl::adaptiveLeadTime"] = s.adaptiveLeadTime;
+ 
+    props["txBurstControl::maxLeadTime"] = s.maxLeadTime;
+    a <<= props;
+}
+
+inline bool operator== (const txBurstControl_struct& s1, const txBurstControl_struct& s2) {
+    if (s1.leadTime!=s2.leadTime)
+        return false;
+    if (s1.adaptiveLeadTime!=s2.adaptiveLeadTime)
+        return false;
+    if (s1.maxLeadTime!=s2.maxLeadTime)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const txBurstControl_struct& s1, const txBurstControl_struct& s2) {
+    return !(s1==s2);
+}
+
+struct bufferPool_struct {
+    bufferPool_struct ()
+    {
+        hugePages = false;
+        lockPages = false;
+        limit = 0.0;
+    };
+
+    static std::string getId() {
+        return std::string("bufferPool");
+    };
+
+    bool hugePages;
+    bool lockPages;
+    double limit;
+};
+
+inline bool operator>>= (const CORBA::Any& a, bufferPool_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("bufferPool::hugePages")) {
+        if (!(props["bufferPool::hugePages"] >>= s.hugePages)) return false;
+    }
+    if (props.contains("bufferPool::lockPages")) {
+        if (!(props["bufferPool::lockPages"] >>= s.lockPages)) return false;
+    }
+    if (props.contains("bufferPool::limit")) {
+        if (!(props["bufferPool::limit"] >>= s.limit)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const bufferPool_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["bufferPool::hugePages"] = s.hugePages;
+ 
+    props["bufferPool::lockPages"] = s.lockPages;
+ 
+    props["bufferPool::limit"] = s.limit;
+    a <<= props;
+}
+
+inline bool operator== (const bufferPool_struct& s1, const bufferPool_struct& s2) {
+    if (s1.hugePages!=s2.hugePages)
+        return false;
+    if (s1.lockPages!=s2.lockPages)
+        return false;
+    if (s1.limit!=s2.limit)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const bufferPool_struct& s1, const bufferPool_struct& s2) {
+    return !(s1==s2);
+}
+
+struct rxCapture_struct {
+    rxCapture_struct ()
+    {
+        path = "";
+        fileSize = 64.0;
+        trigger = "immediate";
+        preTrigger = 0;
+        postTrigger = 0;
+    };
+
+    static std::string getId() {
+        return std::string("rxCapture");
+    };
+
+    std::string path;
+    double fileSize;
+    std::string trigger;
+    CORBA::ULong preTrigger;
+    CORBA::ULong postTrigger;
+};
+
+inline bool operator>>= (const CORBA::Any& a, rxCapture_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("rxCapture::path")) {
+        if (!(props["rxCapture::path"] >>= s.path)) return false;
+    }
+    if (props.contains("rxCapture::fileSize")) {
+        if (!(props["rxCapture::fileSize"] >>= s.fileSize)) return false;
+    }
+    if (props.contains("rxCapture::trigger")) {
+        if (!(props["rxCapture::trigger"] >>= s.trigger)) return false;
+    }
+    if (props.contains("rxCapture::preTrigger")) {
+        if (!(props["rxCapture::preTrigger"] >>= s.preTrigger)) return false;
+    }
+    if (props.contains("rxCapture::postTrigger")) {
+        if (!(props["rxCapture::postTrigger"] >>= s.postTrigger)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const rxCapture_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["rxCapture::path"] = s.path;
+ 
+    props["rxCapture::fileSize"] = s.fileSize;
+ 
+    props["rxCapture::trigger"] = s.trigger;
+ 
+    props["rxCapture::preTrigger"] = s.preTrigger;
+ 
+    props["rxCapture::postTrigger"] = s.postTrigger;
+    a <<= props;
+}
+
+inline bool operator== (const rxCapture_struct& s1, const rxCapture_struct& s2) {
+    if (s1.path!=s2.path)
+        return false;
+    if (s1.fileSize!=s2.fileSize)
+        return false;
+    if (s1.trigger!=s2.trigger)
+        return false;
+    if (s1.preTrigger!=s2.preTrigger)
+        return false;
+    if (s1.postTrigger!=s2.postTrigger)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const rxCapture_struct& s1, const rxCapture_struct& s2) {
+    return !(s1==s2);
+}
+
+struct txReplay_struct {
+    txReplay_struct ()
+    {
+        path = "";
+        rate = 0.0;
+        loop = true;
+        timestamps = "regenerate";
+        samplesPerSend = 0;
+    };
+
+    static std::string getId() {
+        return std::string("txReplay");
+    };
+
+    std::string path;
+    double rate;
+    bool loop;
+    std::string timestamps;
+    CORBA::ULong samplesPerSend;
+};
+
+inline bool operator>>= (const CORBA::Any& a, txReplay_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("txReplay::path")) {
+        if (!(props["txReplay::path"] >>= s.path)) return false;
+    }
+    if (props.contains("txReplay::rate")) {
+        if (!(props["txReplay::rate"] >>= s.rate)) return false;
+    }
+    if (props.contains("txReplay::loop")) {
+        if (!(props["txReplay::loop"] >>= s.loop)) return false;
+    }
+    if (props.contains("txReplay::timestamps")) {
+        if (!(props["txReplay::timestamps"] >>= s.timestamps)) return false;
+    }
+    if (props.contains("txReplay::samplesPerSend")) {
+        if (!(props["txReplay::samplesPerSend"] >>= s.samplesPerSend)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const txReplay_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["txReplay::path"] = s.path;
+ 
+    props["txReplay::rate"] = s.rate;
+ 
+    props["txReplay::loop"] = s.loop;
+ 
+    props["txReplay::timestamps"] = s.timestamps;
+ 
+    props["txReplay::samplesPerSend"] = s.samplesPerSend;
+    a <<= props;
+}
+
+inline bool operator== (const txReplay_struct& s1, const txReplay_struct& s2) {
+    if (s1.path!=s2.path)
+        return false;
+    if (s1.rate!=s2.rate)
+        return false;
+    if (s1.loop!=s2.loop)
+        return false;
+    if (s1.timestamps!=s2.timestamps)
+        return false;
+    if (s1.samplesPerSend!=s2.samplesPerSend)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const txReplay_struct& s1, const txReplay_struct& s2) {
+    return !(s1==s2);
+}
+
+struct latencyTrace_struct {
+    latencyTrace_struct ()
+    {
+        enabled = false;
+        endToEnd = false;
+        events = 65536;
+        path = "";
+        format = "chrome";
+    };
+
+    static std::string getId() {
+        return std::string("latencyTrace");
+    };
+
+    bool enabled;
+    bool endToEnd;
+    CORBA::ULong events;
+    std::string path;
+    std::string format;
+};
+
+inline bool operator>>= (const CORBA::Any& a, latencyTrace_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("latencyTrace::enabled")) {
+        if (!(props["latencyTrace::enabled"] >>= s.enabled)) return false;
+    }
+    if (props.contains("latencyTrace::endToEnd")) {
+        if (!(props["latencyTrace::endToEnd"] >>= s.endToEnd)) return false;
+    }
+    if (props.contains("latencyTrace::events")) {
+        if (!(props["latencyTrace::events"] >>= s.events)) return false;
+    }
+    if (props.contains("latencyTrace::path")) {
+        if (!(props["latencyTrace::path"] >>= s.path)) return false;
+    }
+    if (props.contains("latencyTrace::format")) {
+        if (!(props["latencyTrace::format"] >>= s.format)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const latencyTrace_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["latencyTrace::enabled"] = s.enabled;
+ 
+    props["latencyTrace::endToEnd"] = s.endToEnd;
+ 
+    props["latencyTrace::events"] = s.events;
+ 
+    props["latencyTrace::path"] = s.path;
+ 
+    props["latencyTrace::format"] = s.format;
+    a <<= props;
+}
+
+inline bool operator== (const latencyTrace_struct& s1, const latencyTrace_struct& s2) {
+    if (s1.enabled!=s2.enabled)
+        return false;
+    if (s1.endToEnd!=s2.endToEnd)
+        return false;
+    if (s1.events!=s2.events)
+        return false;
+    if (s1.path!=s2.path)
+        return false;
+    if (s1.format!=s2.format)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const latencyTrace_struct& s1, const latencyTrace_struct& s2) {
+    return !(s1==s2);
+}
+
+struct selfTest_struct {
+    selfTest_struct ()
+    {
+        duration = 10.0;
+        rate = 0.0;
+        samplesPerSend = 0;
+    };
+
+    static std::string getId() {
+        return std::string("selfTest");
+    };
+
+    double duration;
+    double rate;
+    CORBA::ULong samplesPerSend;
+};
+
+inline bool operator>>= (const CORBA::Any& a, selfTest_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("selfTest::duration")) {
+        if (!(props["selfTest::duration"] >>= s.duration)) return false;
+    }
+    if (props.contains("selfTest::rate")) {
+        if (!(props["selfTest::rate"] >>= s.rate)) return false;
+    }
+    if (props.contains("selfTest::samplesPerSend")) {
+        if (!(props["selfTest::samplesPerSend"] >>= s.samplesPerSend)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const selfTest_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["selfTest::duration"] = s.duration;
+ 
+    props["selfTest::rate"] = s.rate;
+ 
+    props["selfTest::samplesPerSend"] = s.samplesPerSend;
+    a <<= props;
+}
+
+inline bool operator== (const selfTest_struct& s1, const selfTest_struct& s2) {
+    if (s1.duration!=s2.duration)
+        return false;
+    if (s1.rate!=s2.rate)
+        return false;
+    if (s1.samplesPerSend!=s2.samplesPerSend)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const selfTest_struct& s1, const selfTest_struct& s2) {
+    return !(s1==s2);
+}
+
+struct selfTestResults_struct {
+    selfTestResults_struct ()
+    {
+        duration = 0.0;
+        throughput = 0.0;
+        samplesSent = 0;
+        samplesReceived = 0;
+        droppedSamples = 0;
+        reorderedSamples = 0;
+        roundTripP50 = 0.0;
+        roundTripP99 = 0.0;
+    };
+
+    static std::string getId() {
+        return std::string("selfTestResults");
+    };
+
+    double duration;
+    double throughput;
+    CORBA::ULongLong samplesSent;
+    CORBA::ULongLong samplesReceived;
+    CORBA::ULongLong droppedSamples;
+    CORBA::ULongLong reorderedSamples;
+    double roundTripP50;
+    double roundTripP99;
+};
+
+inline bool operator>>= (const CORBA::Any& a, selfTestResults_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("selfTestResults::duration")) {
+        if (!(props["selfTestResults::duration"] >>= s.duration)) return false;
+    }
+    if (props.contains("selfTestResults::throughput")) {
+        if (!(props["selfTestResults::throughput"] >>= s.throughput)) return false;
+    }
+    if (props.contains("selfTestResults::samplesSent")) {
+        if (!(props["selfTestResults::samplesSent"] >>= s.samplesSent)) return false;
+    }
+    if (props.contains("selfTestResults::samplesReceived")) {
+        if (!(props["selfTestResults::samplesReceived"] >>= s.samplesReceived)) return false;
+    }
+    if (props.contains("selfTestResults::droppedSamples")) {
+        if (!(props["selfTestResults::droppedSamples"] >>= s.droppedSamples)) return false;
+    }
+    if (props.contains("selfTestResults::reorderedSamples")) {
+        if (!(props["selfTestResults::reorderedSamples"] >>= s.reorderedSamples)) return false;
+    }
+    if (props.contains("selfTestResults::roundTripP50")) {
+        if (!(props["selfTestResults::roundTripP50"] >>= s.roundTripP50)) return false;
+    }
+    if (props.contains("selfTestResults::roundTripP99")) {
+        if (!(props["selfTestResults::roundTripP99"] >>= s.roundTripP99)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const selfTestResults_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["selfTestResults::duration"] = s.duration;
+ 
+    props["selfTestResults::throughput"] = s.throughput;
+ 
+    props["selfTestResults::samplesSent"] = s.samplesSent;
+ 
+    props["selfTestResults::samplesReceived"] = s.samplesReceived;
+ 
+    props["selfTestResults::droppedSamples"] = s.droppedSamples;
+ 
+    props["selfTestResults::reorderedSamples"] = s.reorderedSamples;
+ 
+    props["selfTestResults::roundTripP50"] = s.roundTripP50;
+ 
+    props["selfTestResults::roundTripP99"] = s.roundTripP99;
+    a <<= props;
+}
+
+inline bool operator== (const selfTestResults_struct& s1, const selfTestResults_struct& s2) {
+    if (s1.duration!=s2.duration)
+        return false;
+    if (s1.throughput!=s2.throughput)
+        return false;
+    if (s1.samplesSent!=s2.samplesSent)
+        return false;
+    if (s1.samplesReceived!=s2.samplesReceived)
+        return false;
+    if (s1.droppedSamples!=s2.droppedSamples)
+        return false;
+    if (s1.reorderedSamples!=s2.reorderedSamples)
+        return false;
+    if (s1.roundTripP50!=s2.roundTripP50)
+        return false;
+    if (s1.roundTripP99!=s2.roundTripP99)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const selfTestResults_struct& s1, const selfTestResults_struct& s2) {
+    return !(s1==s2);
+}
+
+struct rxBackpressure_struct {
+    rxBackpressure_struct ()
+    {
+        policy = "dropOldest";
+        lowWatermark = 0.25;
+        highWatermark = 0.75;
+    };
+
+    static std::string getId() {
+        return std::string("rxBackpressure");
+    };
+
+    std::string policy;
+    double lowWatermark;
+    double highWatermark;
+};
+
+inline bool operator>>= (const CORBA::Any& a, rxBackpressure_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("rxBackpressure::policy")) {
+        if (!(props["rxBackpressure::policy"] >>= s.policy)) return false;
+    }
+    if (props.contains("rxBackpressure::lowWatermark")) {
+        if (!(props["rxBackpressure::lowWatermark"] >>= s.lowWatermark)) return false;
+    }
+    if (props.contains("rxBackpressure::highWatermark")) {
+        if (!(props["rxBackpressure::highWatermark"] >>= s.highWatermark)) return false;
+    }
+    return true;
+}
+
+inline void operator<<= (CORBA::Any& a, const rxBackpressure_struct& s) {
+    redhawk::PropertyMap props;
+ 
+    props["rxBackpressure::policy"] = s.policy;
+ 
+    props["rxBackpressure::lowWatermark"] = s.lowWatermark;
+ 
+    props["rxBackpressure::highWatermark"] = s.highWatermark;
+    a <<= props;
+}
+
+inline bool operator== (const rxBackpressure_struct& s1, const rxBackpressure_struct& s2) {
+    if (s1.policy!=s2.policy)
+        return false;
+    if (s1.lowWatermark!=s2.lowWatermark)
+        return false;
+    if (s1.highWatermark!=s2.highWatermark)
+        return false;
+    return true;
+}
+
+inline bool operator!= (const rxBackpressure_struct& s1, const rxBackpressure_struct& s2) {
+    return !(s1==s2);
+}
+
 #endif // STRUCTPROPS_H
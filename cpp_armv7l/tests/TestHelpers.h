@@ -0,0 +1,113 @@
+#ifndef TESTHELPERS_H
+#define TESTHELPERS_H
+
+// Local Include(s)
+#include "RxBufferRing.h"
+#include "TxBufferRing.h"
+
+// Boost Include(s)
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+// Standard Include(s)
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/*
+ * A scratch directory named after the test module, removed along with
+ * whatever the test left in it
+ */
+struct ScratchDirectory
+{
+    ScratchDirectory()
+    {
+        std::string pattern = "/tmp/test_" + boost::unit_test::framework::master_test_suite().p_name.get() + ".XXXXXX";
+        std::vector<char> name(pattern.begin(), pattern.end());
+
+        name.push_back('\0');
+
+        BOOST_REQUIRE(mkdtemp(&name[0]));
+
+        this->path = &name[0];
+    }
+
+    ~ScratchDirectory()
+    {
+        DIR *directory = opendir(this->path.c_str());
+
+        if (directory)
+        {
+            while (struct dirent *entry = readdir(directory))
+            {
+                std::string name = entry->d_name;
+
+                if (name != "." and name != "..")
+                {
+                    remove((this->path + "/" + name).c_str());
+                }
+            }
+
+            closedir(directory);
+        }
+
+        rmdir(this->path.c_str());
+    }
+
+    std::string file(const std::string &name) const
+    {
+        return this->path + "/" + name;
+    }
+
+    std::string path;
+};
+
+// Hand a filled buffer to a ring. The RX ring returns whether it queued the
+// buffer, and the TX ring always does.
+inline bool commitBuffer(RxBufferRing &ring, RxBuffer *buffer)
+{
+    return ring.commit(buffer);
+}
+
+inline bool commitBuffer(TxBufferRing &ring, TxBuffer *)
+{
+    ring.commit();
+
+    return true;
+}
+
+template <class Ring, class Buffer>
+bool commitNumberedBuffer(Ring &ring, Buffer *buffer, short number)
+{
+    if (not buffer)
+    {
+        return false;
+    }
+
+    buffer->data[0] = std::complex<short>(number, -number);
+    buffer->size = 1;
+
+    return commitBuffer(ring, buffer);
+}
+
+// Fill a buffer with a number identifying it, and queue it. Returns false if
+// there was no buffer to fill, or the overflow policy dropped it.
+template <class Ring>
+bool commitNumbered(Ring &ring, short number)
+{
+    return commitNumberedBuffer(ring, ring.acquireFree(), number);
+}
+
+template <class Ring>
+void cancelAfter(Ring *ring, unsigned int milliseconds)
+{
+    boost::this_thread::sleep(boost::posix_time::milliseconds(milliseconds));
+
+    ring->cancel();
+}
+
+#endif
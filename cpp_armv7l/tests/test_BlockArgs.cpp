@@ -0,0 +1,211 @@
+/*
+ * Unit tests for BlockArgs: sending only the changed args in one batch,
+ * verifying them by reading them back, rolling a rejected batch back, and
+ * reading the block again once what it holds is unknown. The args are applied
+ * to an emulated block, and to a mock which rejects or ignores chosen keys.
+ */
+
+#define BOOST_TEST_MODULE BlockArgs
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "BlockArgs.h"
+#include "EmulatedBlock.h"
+
+// Boost Include(s)
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+
+// Standard Include(s)
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+ * A block which records each batch it's sent. It leaves out the ignored key,
+ * and throws once it sees the rejected key, keeping whatever it set first.
+ */
+struct MockBlock
+{
+    MockBlock() :
+        reads(0)
+    {
+        this->args["gain"] = "1";
+        this->args["spp"] = "512";
+    }
+
+    uhd::device_addr_t read()
+    {
+        ++this->reads;
+
+        return this->args;
+    }
+
+    void write(const uhd::device_addr_t &batch)
+    {
+        this->batches.push_back(batch);
+
+        std::vector<std::string> ids = batch.keys();
+
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            if (ids[i] != this->ignored)
+            {
+                this->args[ids[i]] = batch.get(ids[i]);
+            }
+        }
+
+        if (batch.has_key(this->rejected))
+        {
+            throw std::runtime_error("rejected " + this->rejected);
+        }
+    }
+
+    uhd::device_addr_t args;
+    std::vector<uhd::device_addr_t> batches;
+    std::string ignored;
+    size_t reads;
+    std::string rejected;
+};
+
+static BlockArgs blockArgsFor(MockBlock &block)
+{
+    return BlockArgs(boost::bind(&MockBlock::read, &block), boost::bind(&MockBlock::write, &block, _1));
+}
+
+static uhd::device_addr_t makeArgs(const std::string &firstID, const std::string &firstValue, const std::string &secondID = "", const std::string &secondValue = "")
+{
+    uhd::device_addr_t args;
+
+    args[firstID] = firstValue;
+
+    if (not secondID.empty())
+    {
+        args[secondID] = secondValue;
+    }
+
+    return args;
+}
+
+static bool mentions(const std::vector<std::string> &warnings, const std::string &text)
+{
+    for (size_t i = 0; i < warnings.size(); ++i)
+    {
+        if (warnings[i].find(text) != std::string::npos)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+BOOST_AUTO_TEST_CASE(sends_only_the_changed_args_in_one_batch)
+{
+    MockBlock block;
+    BlockArgs args = blockArgsFor(block);
+    std::vector<std::string> warnings;
+
+    BOOST_CHECK(args.apply(makeArgs("gain", "1", "spp", "256"), false, warnings));
+
+    BOOST_REQUIRE_EQUAL(block.batches.size(), 1u);
+    BOOST_CHECK_EQUAL(block.batches[0].size(), 1u);
+    BOOST_CHECK_EQUAL(block.batches[0].get("spp"), "256");
+
+    // Nothing has changed, so nothing is sent, and the block isn't read again
+    BOOST_CHECK(args.apply(makeArgs("spp", "256"), false, warnings));
+
+    BOOST_CHECK_EQUAL(block.batches.size(), 1u);
+    BOOST_CHECK_EQUAL(block.reads, 1u);
+    BOOST_CHECK_EQUAL(args.applied().get("spp"), "256");
+    BOOST_CHECK(warnings.empty());
+}
+
+BOOST_AUTO_TEST_CASE(verifying_catches_an_arg_the_block_didnt_keep)
+{
+    MockBlock block;
+    BlockArgs args = blockArgsFor(block);
+    std::vector<std::string> warnings;
+
+    block.ignored = "spp";
+
+    // Without verifying, the block is taken at its word
+    BOOST_CHECK(args.apply(makeArgs("spp", "256"), false, warnings));
+
+    BOOST_CHECK(not args.apply(makeArgs("gain", "2", "spp", "128"), true, warnings));
+    BOOST_CHECK(mentions(warnings, "Failed to set spp to 128"));
+
+    // The whole batch is rolled back
+    BOOST_REQUIRE_EQUAL(block.batches.size(), 3u);
+    BOOST_CHECK_EQUAL(block.batches[2].get("gain"), "1");
+    BOOST_CHECK_EQUAL(block.batches[2].get("spp"), "256");
+    BOOST_CHECK_EQUAL(block.args.get("gain"), "1");
+}
+
+BOOST_AUTO_TEST_CASE(rolls_a_rejected_batch_back_on_an_emulated_block)
+{
+    boost::shared_ptr<EmulatedBlock> block = boost::make_shared<EmulatedBlock>(64);
+    BlockArgs args(boost::bind(&EmulatedBlock::getArgs, block), boost::bind(&EmulatedBlock::setArgs, block, _1));
+    std::vector<std::string> warnings;
+
+    BOOST_REQUIRE(args.apply(makeArgs("function", "gain", "gain", "0.5"), true, warnings));
+    BOOST_CHECK_EQUAL(block->describe().compare(0, 8, "gain 0.5"), 0);
+
+    // The emulated block rejects a batch which doesn't describe a kernel
+    BOOST_CHECK(not args.apply(makeArgs("function", "decimate", "gain", "2"), true, warnings));
+    BOOST_CHECK(mentions(warnings, "Failed to set arguments: unknown function decimate"));
+
+    BOOST_CHECK_EQUAL(block->getArgs().get("function"), "gain");
+    BOOST_CHECK_EQUAL(block->getArgs().get("gain"), "0.5");
+    BOOST_CHECK_EQUAL(block->describe().compare(0, 8, "gain 0.5"), 0);
+    BOOST_CHECK_EQUAL(args.applied().get("gain"), "0.5");
+}
+
+BOOST_AUTO_TEST_CASE(rereads_the_block_after_a_rejected_new_arg)
+{
+    MockBlock block;
+    BlockArgs args = blockArgsFor(block);
+    std::vector<std::string> warnings;
+
+    block.rejected = "taps";
+
+    BOOST_CHECK(not args.apply(makeArgs("gain", "2", "taps", "1 2 3"), false, warnings));
+    BOOST_CHECK(mentions(warnings, "Unable to roll back taps, it had no previous value"));
+
+    // The gain is restored, but what the block kept of the taps is unknown,
+    // so the next use reads the block again
+    BOOST_CHECK_EQUAL(block.args.get("gain"), "1");
+    BOOST_CHECK_EQUAL(block.reads, 1u);
+
+    uhd::device_addr_t applied = args.applied();
+
+    BOOST_CHECK_EQUAL(block.reads, 2u);
+    BOOST_CHECK_EQUAL(applied.get("spp"), "512");
+    BOOST_CHECK(applied.has_key("taps"));
+}
+
+BOOST_AUTO_TEST_CASE(rereads_the_block_after_a_failed_rollback)
+{
+    MockBlock block;
+    BlockArgs args = blockArgsFor(block);
+    std::vector<std::string> warnings;
+
+    // The block rejects the gain even when rolling it back
+    block.rejected = "gain";
+
+    BOOST_CHECK(not args.apply(makeArgs("gain", "2"), false, warnings));
+    BOOST_CHECK(mentions(warnings, "Failed to roll back arguments: rejected gain"));
+
+    BOOST_CHECK_EQUAL(args.applied().get("gain"), "1");
+    BOOST_CHECK_EQUAL(block.reads, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(applies_no_args_without_touching_the_block)
+{
+    MockBlock block;
+    BlockArgs args = blockArgsFor(block);
+    std::vector<std::string> warnings;
+
+    BOOST_CHECK(args.apply(uhd::device_addr_t(), true, warnings));
+    BOOST_CHECK(block.batches.empty());
+}
@@ -0,0 +1,221 @@
+/*
+ * Unit tests for the block kernels: creating them from a block's args, the
+ * gain's rounding and saturation, and the FIR filter carrying its state from
+ * one call to the next. Buffers of every length up to a few vectors make sure
+ * the vectorized loops and the scalar remainder agree.
+ */
+
+#define BOOST_TEST_MODULE BlockKernels
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "BlockKernels.h"
+
+// Standard Include(s)
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <stdint.h>
+#include <vector>
+
+// The same pseudo-random samples on every run
+static std::vector<std::complex<short> > noise(size_t count)
+{
+    std::vector<std::complex<short> > samples;
+    uint32_t state = 12345;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        state = state * 1103515245 + 12345;
+        short i16 = short(state >> 16);
+
+        state = state * 1103515245 + 12345;
+        short q16 = short(state >> 16);
+
+        samples.push_back(std::complex<short>(i16, q16));
+    }
+
+    return samples;
+}
+
+static boost::shared_ptr<BlockKernel> createKernel(const std::string &function, const std::string &key = "", const std::string &value = "")
+{
+    uhd::device_addr_t args;
+
+    args["function"] = function;
+
+    if (not key.empty())
+    {
+        args[key] = value;
+    }
+
+    return BlockKernel::create(args);
+}
+
+// The expected gain of a single sample, rounding halves up as the fixed
+// point shift does
+static short expectedGain(short value, double gain)
+{
+    return short(std::min(std::max(std::floor(value * gain + 0.5), -32768.0), 32767.0));
+}
+
+static void checkGain(double gain)
+{
+    GainKernel kernel(gain);
+    std::vector<std::complex<short> > input = noise(33);
+
+    input[0] = std::complex<short>(-32768, 32767);
+    input[1] = std::complex<short>(1, -1);
+    input[2] = std::complex<short>(3, -3);
+
+    for (size_t count = 1; count <= input.size(); ++count)
+    {
+        std::vector<std::complex<short> > output(count);
+
+        kernel.process(&input[0], &output[0], count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            BOOST_CHECK_EQUAL(output[i].real(), expectedGain(input[i].real(), gain));
+            BOOST_CHECK_EQUAL(output[i].imag(), expectedGain(input[i].imag(), gain));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(creates_the_kernel_named_by_the_args)
+{
+    BOOST_CHECK_EQUAL(BlockKernel::create(uhd::device_addr_t())->describe(), "passthrough");
+    BOOST_CHECK_EQUAL(createKernel("gain", "gain", " 0.5 ")->describe(), "gain 0.5");
+    BOOST_CHECK_EQUAL(createKernel("fir", "taps", "0.25, 0.5,0.25")->describe(), "fir, 3 taps");
+
+    std::string name = blockKernelName();
+
+    BOOST_CHECK(name == "NEON" or name == "SSE2" or name == "scalar");
+}
+
+BOOST_AUTO_TEST_CASE(rejects_args_which_describe_no_kernel)
+{
+    BOOST_CHECK_THROW(createKernel("decimate"), std::invalid_argument);
+    BOOST_CHECK_THROW(createKernel("gain", "gain", "loud"), std::invalid_argument);
+    BOOST_CHECK_THROW(createKernel("fir"), std::invalid_argument);
+    BOOST_CHECK_THROW(createKernel("fir", "taps", " , "), std::invalid_argument);
+    BOOST_CHECK_THROW(createKernel("fir", "taps", "0.5 half"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(passthrough_copies_its_input)
+{
+    PassThroughKernel kernel;
+    std::vector<std::complex<short> > input = noise(17);
+    std::vector<std::complex<short> > output(input.size());
+
+    kernel.process(&input[0], &output[0], input.size());
+
+    BOOST_CHECK(output == input);
+
+    // In place is fine too
+    kernel.process(&output[0], &output[0], output.size());
+
+    BOOST_CHECK(output == input);
+}
+
+BOOST_AUTO_TEST_CASE(gain_rounds_and_saturates)
+{
+    checkGain(1.0);
+    checkGain(0.5);
+    checkGain(0.25);
+    checkGain(2.0);
+    checkGain(-1.0);
+    checkGain(-4.0);
+}
+
+BOOST_AUTO_TEST_CASE(fir_filters_an_impulse)
+{
+    FirKernel kernel(std::vector<double>(3, 0.25));
+    std::vector<std::complex<short> > input(6, std::complex<short>(0, 0));
+    std::vector<std::complex<short> > output(input.size());
+
+    input[1] = std::complex<short>(1000, -2000);
+
+    kernel.process(&input[0], &output[0], input.size());
+
+    short expectedI[] = {0, 250, 250, 250, 0, 0};
+    short expectedQ[] = {0, -500, -500, -500, 0, 0};
+
+    for (size_t i = 0; i < output.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(output[i].real(), expectedI[i]);
+        BOOST_CHECK_EQUAL(output[i].imag(), expectedQ[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fir_carries_its_state_across_calls)
+{
+    // Enough taps for the vectorized loop and a remainder
+    double taps[] = {0.05, -0.1, 0.15, 0.2, 0.3, 0.2, 0.15, -0.1, 0.05};
+    std::vector<double> tapList(taps, taps + sizeof(taps) / sizeof(taps[0]));
+    std::vector<std::complex<short> > input = noise(200);
+
+    FirKernel whole(tapList);
+    std::vector<std::complex<short> > expected(input.size());
+
+    whole.process(&input[0], &expected[0], input.size());
+
+    // The same input split into pieces of every length gives the same output
+    for (size_t piece = 1; piece <= 33; ++piece)
+    {
+        FirKernel split(tapList);
+        std::vector<std::complex<short> > output(input.size());
+
+        for (size_t offset = 0; offset < input.size(); offset += piece)
+        {
+            size_t count = std::min(piece, input.size() - offset);
+
+            split.process(&input[offset], &output[offset], count);
+        }
+
+        BOOST_CHECK_MESSAGE(output == expected, "pieces of " << piece << " differ");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fir_matches_the_direct_form)
+{
+    double taps[] = {0.05, -0.1, 0.15, 0.2, 0.3, 0.2, 0.15, -0.1, 0.05};
+    size_t tapCount = sizeof(taps) / sizeof(taps[0]);
+    std::vector<std::complex<short> > input = noise(64);
+    std::vector<std::complex<short> > output(input.size());
+
+    FirKernel kernel(std::vector<double>(taps, taps + tapCount));
+
+    kernel.process(&input[0], &output[0], input.size());
+
+    // Within a count or two of the filter in floating point, as the taps are
+    // rounded to fixed point
+    for (size_t n = 0; n < input.size(); ++n)
+    {
+        double sumI = 0;
+        double sumQ = 0;
+
+        for (size_t k = 0; k < tapCount and k <= n; ++k)
+        {
+            sumI += taps[k] * input[n - k].real();
+            sumQ += taps[k] * input[n - k].imag();
+        }
+
+        BOOST_CHECK_LE(std::fabs(output[n].real() - sumI), 2.0);
+        BOOST_CHECK_LE(std::fabs(output[n].imag() - sumQ), 2.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fir_reset_forgets_the_previous_input)
+{
+    FirKernel kernel(std::vector<double>(5, 0.2));
+    std::vector<std::complex<short> > input = noise(20);
+    std::vector<std::complex<short> > first(input.size());
+    std::vector<std::complex<short> > second(input.size());
+
+    kernel.process(&input[0], &first[0], input.size());
+    kernel.reset();
+    kernel.process(&input[0], &second[0], input.size());
+
+    BOOST_CHECK(first == second);
+}
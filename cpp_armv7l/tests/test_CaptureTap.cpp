@@ -0,0 +1,251 @@
+/*
+ * Unit tests for CaptureTap: unrolling the data file in finalize() so that it
+ * starts at the oldest kept sample, the pre- and post-trigger lengths, and
+ * the runs and drops recorded in the sidecar.
+ */
+
+#define BOOST_TEST_MODULE CaptureTap
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "CaptureTap.h"
+#include "SampleBufferPool.h"
+#include "TestHelpers.h"
+
+// Boost Include(s)
+#include <boost/thread.hpp>
+
+// Standard Include(s)
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Stage samples numbered from first, one buffer at a time
+static void writeNumbered(CaptureTap &tap, short first, size_t count, const uhd::time_spec_t &time = uhd::time_spec_t(0.0))
+{
+    std::vector<std::complex<short> > samples;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        samples.push_back(std::complex<short>(first + i, 0));
+    }
+
+    tap.write(&samples[0], count, time);
+}
+
+// The numbers of the samples in the data file
+static std::vector<short> readNumbers(const std::string &path)
+{
+    std::ifstream file((path + ".sigmf-data").c_str(), std::ios::binary);
+    std::vector<short> numbers;
+    std::complex<short> sample;
+
+    while (file.read((char *) &sample, sizeof(sample)))
+    {
+        numbers.push_back(sample.real());
+    }
+
+    return numbers;
+}
+
+static std::string readMetadata(const std::string &path)
+{
+    std::ifstream file((path + ".sigmf-meta").c_str());
+
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static size_t occurrences(const std::string &text, const std::string &pattern)
+{
+    size_t count = 0;
+
+    for (size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+static std::vector<short> range(short first, short last)
+{
+    std::vector<short> numbers;
+
+    for (short number = first; number <= last; ++number)
+    {
+        numbers.push_back(number);
+    }
+
+    return numbers;
+}
+
+// Wait for the writer to finish the capture, which it does on its own once
+// the post-trigger length is reached
+static bool waitForCompletion(const CaptureTap &tap)
+{
+    for (size_t i = 0; i < 500; ++i)
+    {
+        if (tap.status().compare(0, 8, "complete") == 0)
+        {
+            return true;
+        }
+
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    }
+
+    return false;
+}
+
+BOOST_AUTO_TEST_CASE(unrolls_a_wrapped_file_to_start_at_the_oldest_sample)
+{
+    ScratchDirectory scratch;
+    SampleBufferPool pool;
+
+    CaptureTap tap(pool);
+
+    BOOST_REQUIRE(tap.open(scratch.file("capture"), 8, 64, 0, 0, 0, false, "wrapped"));
+
+    writeNumbered(tap, 0, 5);
+    writeNumbered(tap, 5, 5);
+    writeNumbered(tap, 10, 3);
+
+    // Closing an untriggered capture keeps the last file's worth of samples
+    tap.close();
+
+    BOOST_REQUIRE(waitForCompletion(tap));
+    BOOST_CHECK_EQUAL(tap.status(), "complete: " + scratch.file("capture") + ", 8 samples, never triggered");
+
+    std::vector<short> numbers = readNumbers(scratch.file("capture"));
+    std::vector<short> expected = range(5, 12);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(numbers.begin(), numbers.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(keeps_a_short_file_as_written)
+{
+    ScratchDirectory scratch;
+    SampleBufferPool pool;
+
+    {
+        CaptureTap tap(pool);
+
+        BOOST_REQUIRE(tap.open(scratch.file("capture"), 16, 64, 0, 0, 0, false, ""));
+
+        writeNumbered(tap, 0, 6);
+        tap.close();
+    }
+
+    std::vector<short> numbers = readNumbers(scratch.file("capture"));
+    std::vector<short> expected = range(0, 5);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(numbers.begin(), numbers.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(keeps_the_pre_and_post_trigger_lengths)
+{
+    ScratchDirectory scratch;
+    SampleBufferPool pool;
+    CaptureTap tap(pool);
+
+    BOOST_REQUIRE(tap.open(scratch.file("capture"), 16, 64, 0, 4, 6, false, ""));
+
+    writeNumbered(tap, 0, 10);
+    tap.trigger();
+    writeNumbered(tap, 10, 10);
+
+    BOOST_REQUIRE(waitForCompletion(tap));
+
+    // Four samples before the trigger and six from it, moved to the start of
+    // the file
+    std::vector<short> numbers = readNumbers(scratch.file("capture"));
+    std::vector<short> expected = range(6, 15);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(numbers.begin(), numbers.end(), expected.begin(), expected.end());
+
+    std::string metadata = readMetadata(scratch.file("capture"));
+
+    BOOST_CHECK(metadata.find("{\"core:sample_start\": 4, \"core:label\": \"trigger\"}") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(completes_once_the_file_is_full)
+{
+    ScratchDirectory scratch;
+    SampleBufferPool pool;
+    CaptureTap tap(pool);
+
+    BOOST_REQUIRE(tap.open(scratch.file("capture"), 8, 64, 0, 0, 0, true, ""));
+
+    writeNumbered(tap, 0, 5);
+    writeNumbered(tap, 5, 7);
+
+    BOOST_REQUIRE(waitForCompletion(tap));
+
+    std::vector<short> numbers = readNumbers(scratch.file("capture"));
+    std::vector<short> expected = range(0, 7);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(numbers.begin(), numbers.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(records_a_run_for_each_discontinuity)
+{
+    ScratchDirectory scratch;
+    SampleBufferPool pool;
+
+    {
+        CaptureTap tap(pool);
+
+        BOOST_REQUIRE(tap.open(scratch.file("capture"), 64, 64, 1e6, 0, 0, true, "a \"quoted\" description"));
+
+        // The second buffer follows on from the first, and the third doesn't
+        writeNumbered(tap, 0, 5, uhd::time_spec_t(10, 0.0));
+        writeNumbered(tap, 5, 5, uhd::time_spec_t(10, 5e-6));
+        writeNumbered(tap, 10, 5, uhd::time_spec_t(11, 0.0));
+        tap.close();
+    }
+
+    std::string metadata = readMetadata(scratch.file("capture"));
+
+    BOOST_CHECK_EQUAL(occurrences(metadata, "rfnoc:full_secs"), 2u);
+    BOOST_CHECK(metadata.find("{\"core:sample_start\": 0, \"rfnoc:full_secs\": 10,") != std::string::npos);
+    BOOST_CHECK(metadata.find("{\"core:sample_start\": 10, \"rfnoc:full_secs\": 11,") != std::string::npos);
+    BOOST_CHECK(metadata.find("\"core:sample_rate\": 1000000") != std::string::npos);
+    BOOST_CHECK(metadata.find("a \\\"quoted\\\" description") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(drops_buffers_which_dont_fit)
+{
+    ScratchDirectory scratch;
+    SampleBufferPool pool;
+    CaptureTap tap(pool);
+
+    BOOST_REQUIRE(tap.open(scratch.file("capture"), 64, 8, 0, 0, 0, true, ""));
+
+    // A buffer larger than the staging ring can never fit
+    writeNumbered(tap, 0, 16);
+    writeNumbered(tap, 16, 4);
+    tap.close();
+
+    BOOST_REQUIRE(waitForCompletion(tap));
+    BOOST_CHECK_EQUAL(tap.droppedSamples(), 16u);
+    BOOST_CHECK_EQUAL(tap.status(), "complete: " + scratch.file("capture") + ", 4 samples, 16 dropped");
+
+    std::vector<short> numbers = readNumbers(scratch.file("capture"));
+    std::vector<short> expected = range(16, 19);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(numbers.begin(), numbers.end(), expected.begin(), expected.end());
+
+    std::string metadata = readMetadata(scratch.file("capture"));
+
+    BOOST_CHECK(metadata.find("\"rfnoc:dropped_samples\": 16") != std::string::npos);
+    BOOST_CHECK(metadata.find("\"core:label\": \"16 samples dropped\"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(reports_a_file_which_cant_be_opened)
+{
+    SampleBufferPool pool;
+    CaptureTap tap(pool);
+
+    BOOST_CHECK(not tap.open("/nonexistent/directory/capture", 8, 8, 0, 0, 0, true, ""));
+    BOOST_CHECK_EQUAL(tap.status().compare(0, 6, "error:"), 0);
+}
@@ -0,0 +1,234 @@
+/*
+ * Unit tests for EmulatedBlock and its streamers: each stream mode, from
+ * streaming continuously to finite captures which stop once they have their
+ * samples, discarding the output while not streaming, and a TX streamer
+ * waiting for room in the queue.
+ */
+
+#define BOOST_TEST_MODULE EmulatedBlock
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "EmulatedBlock.h"
+#include "PerformanceCounters.h"
+
+// Boost Include(s)
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread.hpp>
+
+// Standard Include(s)
+#include <complex>
+#include <vector>
+
+/*
+ * An emulated block with its RX and TX streamers, passing samples through
+ * unchanged
+ */
+struct EmulatedStreams
+{
+    EmulatedStreams(size_t queueSamples, size_t spp = 1024) :
+        block(boost::make_shared<EmulatedBlock>(queueSamples)),
+        nextReceived(0),
+        nextSent(0)
+    {
+        this->rxStreamer = this->block->getRxStreamer(spp);
+        this->txStreamer = this->block->getTxStreamer(spp);
+    }
+
+    void command(uhd::stream_cmd_t::stream_mode_t mode, uint64_t numSamples = 0)
+    {
+        uhd::stream_cmd_t stream_cmd(mode);
+
+        stream_cmd.num_samps = numSamples;
+
+        this->rxStreamer->issue_stream_cmd(stream_cmd);
+    }
+
+    // Receive up to the given number of samples, checking they follow on
+    // from the last ones received
+    size_t recv(size_t count, uhd::rx_metadata_t &metadata, bool onePacket = false)
+    {
+        std::vector<std::complex<short> > samples(count);
+        uhd::rx_streamer::buffs_type buffs(1, &samples[0]);
+
+        size_t numSamples = this->rxStreamer->recv(buffs, count, metadata, 0.05, onePacket);
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            BOOST_REQUIRE_EQUAL(samples[i], std::complex<short>(this->nextReceived, -this->nextReceived));
+            ++this->nextReceived;
+        }
+
+        return numSamples;
+    }
+
+    // Send the given number of samples numbered on from the last ones sent,
+    // returning how many were accepted
+    size_t send(size_t count, double timeout = 0.05)
+    {
+        std::vector<std::complex<short> > samples;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            samples.push_back(std::complex<short>(this->nextSent + i, -short(this->nextSent + i)));
+        }
+
+        uhd::tx_streamer::buffs_type buffs(1, &samples[0]);
+        uhd::tx_metadata_t metadata;
+
+        size_t numSamples = this->txStreamer->send(buffs, count, metadata, timeout);
+
+        this->nextSent += numSamples;
+
+        return numSamples;
+    }
+
+    // Skip numbers sent while the samples were discarded
+    void skipTo(short number)
+    {
+        this->nextReceived = number;
+    }
+
+    boost::shared_ptr<EmulatedBlock> block;
+    short nextReceived;
+    short nextSent;
+    uhd::rx_streamer::sptr rxStreamer;
+    uhd::tx_streamer::sptr txStreamer;
+};
+
+static void recvAfter(EmulatedStreams *streams, size_t count, unsigned int milliseconds)
+{
+    boost::this_thread::sleep(boost::posix_time::milliseconds(milliseconds));
+
+    uhd::rx_metadata_t metadata;
+
+    streams->recv(count, metadata);
+}
+
+BOOST_AUTO_TEST_CASE(discards_output_until_streaming)
+{
+    EmulatedStreams streams(64);
+    uhd::rx_metadata_t metadata;
+
+    // Every sample is accepted, and goes nowhere
+    BOOST_CHECK_EQUAL(streams.send(100), 100u);
+    BOOST_CHECK_EQUAL(streams.recv(16, metadata), 0u);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
+BOOST_AUTO_TEST_CASE(streams_continuously_until_stopped)
+{
+    EmulatedStreams streams(64);
+    uhd::rx_metadata_t metadata;
+
+    streams.command(uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
+
+    // The queue wraps around its end several times
+    for (size_t i = 0; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(streams.send(40), 40u);
+        BOOST_CHECK_EQUAL(streams.recv(40, metadata), 40u);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK(not metadata.end_of_burst);
+    }
+
+    // Once stopped, what was already queued is still received, but nothing
+    // sent afterwards is
+    BOOST_CHECK_EQUAL(streams.send(10), 10u);
+
+    streams.command(uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS);
+
+    BOOST_CHECK_EQUAL(streams.send(20), 20u);
+    BOOST_CHECK_EQUAL(streams.recv(64, metadata), 10u);
+    BOOST_CHECK_EQUAL(streams.recv(64, metadata), 0u);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
+BOOST_AUTO_TEST_CASE(one_packet_recvs_are_limited_to_the_spp)
+{
+    EmulatedStreams streams(64, 16);
+    uhd::rx_metadata_t metadata;
+
+    streams.command(uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
+    streams.send(40);
+
+    BOOST_CHECK_EQUAL(streams.recv(40, metadata, true), 16u);
+    BOOST_CHECK_EQUAL(streams.recv(40, metadata), 24u);
+}
+
+BOOST_AUTO_TEST_CASE(num_samps_and_done_ends_with_end_of_burst)
+{
+    EmulatedStreams streams(64);
+    uhd::rx_metadata_t metadata;
+
+    streams.command(uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_DONE, 50);
+    streams.send(30);
+
+    BOOST_CHECK_EQUAL(streams.recv(64, metadata), 30u);
+    BOOST_CHECK(not metadata.end_of_burst);
+
+    // The capture ends with a short recv, however much more was sent
+    streams.send(30);
+
+    BOOST_CHECK_EQUAL(streams.recv(64, metadata), 20u);
+    BOOST_CHECK(metadata.end_of_burst);
+
+    // It has stopped streaming, so nothing sent now is received
+    streams.recv(64, metadata);
+    streams.send(10);
+    metadata.reset();
+
+    BOOST_CHECK_EQUAL(streams.recv(64, metadata), 0u);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
+BOOST_AUTO_TEST_CASE(num_samps_and_more_stops_without_ending_the_burst)
+{
+    EmulatedStreams streams(64);
+    uhd::rx_metadata_t metadata;
+
+    streams.command(uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_MORE, 20);
+    streams.send(20);
+
+    BOOST_CHECK_EQUAL(streams.recv(64, metadata), 20u);
+    BOOST_CHECK(not metadata.end_of_burst);
+
+    // Rather than carrying on as if streaming continuously, it waits for the
+    // next command
+    BOOST_CHECK_EQUAL(streams.send(10), 10u);
+    BOOST_CHECK_EQUAL(streams.recv(64, metadata), 0u);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+
+    streams.command(uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_MORE, 20);
+    streams.skipTo(30);
+    streams.send(30);
+
+    BOOST_CHECK_EQUAL(streams.recv(64, metadata), 20u);
+    BOOST_CHECK(not metadata.end_of_burst);
+}
+
+BOOST_AUTO_TEST_CASE(tx_waits_for_room_in_the_queue)
+{
+    EmulatedStreams streams(32);
+
+    streams.command(uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
+
+    BOOST_CHECK_EQUAL(streams.send(48), 32u);
+
+    // With nothing received, the send times out without taking any samples
+    uint64_t start = monotonicNanoseconds();
+
+    BOOST_CHECK_EQUAL(streams.send(16, 0.05), 0u);
+    BOOST_CHECK_GE(monotonicNanoseconds() - start, 40000000u);
+
+    // Receiving makes room, which the waiting send fills
+    boost::thread receiver(boost::bind(&recvAfter, &streams, 8, 20));
+
+    start = monotonicNanoseconds();
+
+    BOOST_CHECK_EQUAL(streams.send(16, 1.0), 8u);
+    BOOST_CHECK_LT(monotonicNanoseconds() - start, 500000000u);
+
+    receiver.join();
+}
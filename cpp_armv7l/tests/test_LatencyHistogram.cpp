@@ -0,0 +1,123 @@
+/*
+ * Unit tests for LatencyHistogram: the bucket each duration lands in, and the
+ * percentiles read back from the counts.
+ */
+
+#define BOOST_TEST_MODULE LatencyHistogram
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+
+// Standard Include(s)
+#include <algorithm>
+#include <vector>
+
+// The upper bound, in nanoseconds, of the bucket a single duration lands in
+static double bucketBound(uint64_t nanoseconds)
+{
+    LatencyHistogram histogram;
+    std::vector<uint32_t> counts;
+
+    histogram.record(nanoseconds);
+    histogram.snapshot(counts);
+
+    return LatencyHistogram::percentile(counts, 0.5) * 1e3;
+}
+
+BOOST_AUTO_TEST_CASE(starts_empty)
+{
+    LatencyHistogram histogram;
+    std::vector<uint32_t> counts;
+
+    histogram.snapshot(counts);
+
+    BOOST_CHECK_EQUAL(counts.size(), size_t(LatencyHistogram::NUM_BUCKETS));
+    BOOST_CHECK_EQUAL(std::count(counts.begin(), counts.end(), 0u), long(LatencyHistogram::NUM_BUCKETS));
+    BOOST_CHECK_EQUAL(LatencyHistogram::percentile(counts, 0.99), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(small_durations_get_a_bucket_each)
+{
+    for (uint64_t nanoseconds = 0; nanoseconds < 4; ++nanoseconds)
+    {
+        BOOST_CHECK_CLOSE(bucketBound(nanoseconds), double(nanoseconds + 1), 1e-9);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(buckets_are_within_a_quarter)
+{
+    // Each duration's bucket ends above it, by no more than a quarter
+    uint64_t durations[] = {4, 5, 7, 8, 9, 15, 16, 100, 1000, 12345, 999999, 1000000, 123456789, 5000000000ULL};
+
+    for (size_t i = 0; i < sizeof(durations) / sizeof(durations[0]); ++i)
+    {
+        double bound = bucketBound(durations[i]);
+
+        BOOST_CHECK_GT(bound, double(durations[i]));
+        BOOST_CHECK_LE(bound, 1.25 * durations[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bucket_bounds_increase)
+{
+    std::vector<uint32_t> counts(LatencyHistogram::NUM_BUCKETS, 0);
+    double previous = 0;
+
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        counts[i] = 1;
+
+        double bound = LatencyHistogram::percentile(counts, 0.5);
+
+        BOOST_CHECK_GT(bound, previous);
+
+        counts[i] = 0;
+        previous = bound;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(huge_durations_land_in_the_last_bucket)
+{
+    std::vector<uint32_t> last(LatencyHistogram::NUM_BUCKETS, 0);
+
+    last.back() = 1;
+
+    BOOST_CHECK_EQUAL(bucketBound(~uint64_t(0)), LatencyHistogram::percentile(last, 0.5) * 1e3);
+}
+
+BOOST_AUTO_TEST_CASE(percentiles_split_the_counts)
+{
+    LatencyHistogram histogram;
+    std::vector<uint32_t> counts;
+
+    // 99 fast durations and one slow one
+    for (size_t i = 0; i < 99; ++i)
+    {
+        histogram.record(1000);
+    }
+
+    histogram.record(1000000);
+    histogram.snapshot(counts);
+
+    double p50 = LatencyHistogram::percentile(counts, 0.50);
+    double p99 = LatencyHistogram::percentile(counts, 0.99);
+
+    BOOST_CHECK_GT(p50, 1.0);
+    BOOST_CHECK_LE(p50, 1.25);
+    BOOST_CHECK_GT(p99, 1000.0);
+    BOOST_CHECK_LE(p99, 1250.0);
+}
+
+BOOST_AUTO_TEST_CASE(clear_empties_every_bucket)
+{
+    LatencyHistogram histogram;
+    std::vector<uint32_t> counts;
+
+    histogram.record(3);
+    histogram.record(123456);
+    histogram.clear();
+    histogram.snapshot(counts);
+
+    BOOST_CHECK_EQUAL(LatencyHistogram::percentile(counts, 0.5), 0.0);
+}
@@ -0,0 +1,263 @@
+/*
+ * Unit tests for LatencyTrace: rounding the ring up to a power of two,
+ * exporting the events oldest first once it has wrapped, leaving out events
+ * being overwritten while they're copied, and the Chrome and perf formats.
+ */
+
+#define BOOST_TEST_MODULE LatencyTrace
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "LatencyTrace.h"
+#include "TestHelpers.h"
+
+// Boost Include(s)
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+// Standard Include(s)
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * An event read back from the perf export
+ */
+struct PerfLine
+{
+    uint64_t start;
+    std::string stage;
+    double microseconds;
+    uint32_t samples;
+};
+
+// Export the trace in the given format, returning the file's contents
+static std::string exportText(LatencyTrace &trace, const std::string &format)
+{
+    ScratchDirectory scratch;
+    std::string path = scratch.file("trace");
+
+    BOOST_CHECK(trace.exportTrace(path, format));
+
+    std::ifstream file(path.c_str());
+
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+// Export the trace as perf text, and parse each event back out of it
+static std::vector<PerfLine> exportPerf(LatencyTrace &trace)
+{
+    std::istringstream text(exportText(trace, "perf"));
+    std::vector<PerfLine> lines;
+    std::string line;
+
+    std::getline(text, line);
+
+    BOOST_CHECK_EQUAL(line, "# time stage microseconds samples");
+
+    while (std::getline(text, line))
+    {
+        std::istringstream fields(line);
+        uint64_t seconds = 0;
+        uint64_t nanoseconds = 0;
+        char point = 0;
+        PerfLine parsed;
+
+        fields >> seconds >> point >> nanoseconds >> parsed.stage >> parsed.microseconds >> parsed.samples;
+
+        BOOST_REQUIRE(fields and point == '.');
+
+        parsed.start = seconds * 1000000000ULL + nanoseconds;
+        lines.push_back(parsed);
+    }
+
+    return lines;
+}
+
+static bool contains(const std::string &text, const std::string &pattern)
+{
+    return (text.find(pattern) != std::string::npos);
+}
+
+// Record events whose every field follows from their start, until stopped
+static void recordConsistently(LatencyTrace *trace, boost::atomic<bool> *stop)
+{
+    for (uint64_t start = 1; not stop->load(); ++start)
+    {
+        trace->record(LatencyTrace::RX_RECV, start, start * 2, uint32_t(start));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(rounds_the_ring_up_to_a_power_of_two)
+{
+    LatencyTrace trace;
+
+    trace.configure(true, false, 5);
+
+    for (uint64_t start = 0; start < 10; ++start)
+    {
+        trace.record(LatencyTrace::RX_RECV, start, start + 1, 1);
+    }
+
+    BOOST_CHECK_EQUAL(exportPerf(trace).size(), 8u);
+
+    // An empty ring still holds one event
+    trace.configure(true, false, 0);
+    trace.record(LatencyTrace::RX_RECV, 1, 2, 1);
+    trace.record(LatencyTrace::RX_RECV, 3, 4, 1);
+
+    std::vector<PerfLine> lines = exportPerf(trace);
+
+    BOOST_REQUIRE_EQUAL(lines.size(), 1u);
+    BOOST_CHECK_EQUAL(lines[0].start, 3u);
+}
+
+BOOST_AUTO_TEST_CASE(exports_oldest_first_once_the_ring_wraps)
+{
+    LatencyTrace trace;
+
+    trace.configure(true, false, 4);
+
+    for (uint64_t start = 100; start < 106; ++start)
+    {
+        trace.record(LatencyTrace::RX_RECV, start, start + 1, uint32_t(start));
+    }
+
+    std::vector<PerfLine> lines = exportPerf(trace);
+
+    BOOST_REQUIRE_EQUAL(lines.size(), 4u);
+
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(lines[i].start, 102u + i);
+        BOOST_CHECK_EQUAL(lines[i].samples, 102u + i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(orders_events_by_their_start)
+{
+    LatencyTrace trace;
+
+    trace.configure(true, false, 16);
+
+    // A queue wait is recorded as it ends, after the recv which started later
+    trace.record(LatencyTrace::RX_RECV, 2000, 3000, 1);
+    trace.record(LatencyTrace::RX_QUEUE, 1000, 4000, 1);
+
+    std::vector<PerfLine> lines = exportPerf(trace);
+
+    BOOST_REQUIRE_EQUAL(lines.size(), 2u);
+    BOOST_CHECK_EQUAL(lines[0].stage, "rx_queue");
+    BOOST_CHECK_EQUAL(lines[1].stage, "rx_recv");
+}
+
+BOOST_AUTO_TEST_CASE(leaves_out_events_overwritten_while_copied)
+{
+    LatencyTrace trace;
+    boost::atomic<bool> stop(false);
+
+    trace.configure(true, false, 64);
+
+    boost::thread recorder(boost::bind(&recordConsistently, &trace, &stop));
+
+    // Every event copied out while the small ring is overwritten has to be
+    // whole, rather than torn between two events
+    size_t exported = 0;
+
+    for (size_t i = 0; i < 200; ++i)
+    {
+        std::vector<PerfLine> lines = exportPerf(trace);
+
+        for (size_t j = 0; j < lines.size(); ++j)
+        {
+            BOOST_REQUIRE_EQUAL(lines[j].samples, uint32_t(lines[j].start));
+            BOOST_REQUIRE_EQUAL(uint64_t(lines[j].microseconds * 1e3 + 0.5), lines[j].start);
+            BOOST_REQUIRE(j == 0 or lines[j - 1].start < lines[j].start);
+        }
+
+        exported += lines.size();
+    }
+
+    stop = true;
+    recorder.join();
+
+    BOOST_CHECK_GT(exported, 0u);
+    BOOST_CHECK_LE(exported, 200u * 64);
+}
+
+BOOST_AUTO_TEST_CASE(records_nothing_while_disabled)
+{
+    LatencyTrace trace;
+
+    trace.configure(true, false, 4);
+    trace.configure(false, false, 4);
+    trace.record(LatencyTrace::RX_RECV, 1, 2, 1);
+
+    BOOST_CHECK(exportPerf(trace).empty());
+    BOOST_CHECK(contains(trace.status(), "disabled, exported 0 events"));
+
+    // Ages are only recorded end to end
+    trace.configure(true, false, 4);
+    trace.recordAge(LatencyTrace::RX_PUSH_AGE, 1, LatencyTrace::hostTime(), 1);
+
+    BOOST_CHECK(exportPerf(trace).empty());
+
+    trace.configure(true, true, 4);
+    trace.recordAge(LatencyTrace::RX_PUSH_AGE, 1, LatencyTrace::hostTime() + uhd::time_spec_t(1.0), 1);
+
+    std::vector<PerfLine> lines = exportPerf(trace);
+
+    BOOST_REQUIRE_EQUAL(lines.size(), 1u);
+    BOOST_CHECK_EQUAL(lines[0].stage, "rx_push_age");
+    BOOST_CHECK_LT(lines[0].microseconds, 0);
+}
+
+BOOST_AUTO_TEST_CASE(writes_the_perf_format)
+{
+    LatencyTrace trace;
+
+    trace.configure(true, false, 4);
+    trace.record(LatencyTrace::TX_SEND, 12000000123ULL, 12000001623ULL, 256);
+
+    std::string text = exportText(trace, "perf");
+
+    BOOST_CHECK_EQUAL(text, "# time stage microseconds samples\n12.000000123 tx_send 1.500 256\n");
+    BOOST_CHECK(contains(trace.status(), "tracing, exported 1 events to /tmp/test_LatencyTrace."));
+}
+
+BOOST_AUTO_TEST_CASE(writes_the_chrome_format)
+{
+    LatencyTrace trace;
+
+    trace.configure(true, true, 8);
+    trace.record(LatencyTrace::RX_RECV, 1000, 3000, 64);
+    trace.record(LatencyTrace::RX_QUEUE, 3000, 7000, 64);
+    trace.recordAge(LatencyTrace::RX_PUSH_AGE, 8000, LatencyTrace::hostTime(), 64);
+
+    std::string text = exportText(trace, "chrome");
+
+    BOOST_CHECK_EQUAL(text.find("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n"), 0u);
+    BOOST_CHECK(contains(text, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": \"RX recv\"}},\n"));
+
+    // Spans on the thread they ran on, queue waits as async pairs, and ages as
+    // counters
+    BOOST_CHECK(contains(text, "{\"name\": \"rx_recv\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": 1.000, \"dur\": 2.000, \"args\": {\"samples\": 64}},\n"));
+    BOOST_CHECK(contains(text, "{\"name\": \"rx_queue\", \"cat\": \"queue\", \"ph\": \"b\", \"id\": 1, \"pid\": 1, \"tid\": 2, \"ts\": 3.000, \"args\": {\"samples\": 64}},\n"));
+    BOOST_CHECK(contains(text, "{\"name\": \"rx_queue\", \"cat\": \"queue\", \"ph\": \"e\", \"id\": 1, \"pid\": 1, \"tid\": 2, \"ts\": 7.000},\n"));
+    BOOST_CHECK(contains(text, "{\"name\": \"rx_push_age\", \"ph\": \"C\", \"pid\": 1, \"tid\": 2, \"ts\": 8.000, \"args\": {\"us\": "));
+
+    // The last event has no trailing comma
+    BOOST_CHECK(contains(text, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"RFNoC_TestComponent\"}}\n]}\n"));
+}
+
+BOOST_AUTO_TEST_CASE(reports_a_file_it_cant_open)
+{
+    LatencyTrace trace;
+
+    trace.configure(true, false, 4);
+
+    BOOST_CHECK(not trace.exportTrace("/nonexistent/trace.json", "chrome"));
+    BOOST_CHECK_EQUAL(trace.status(), "error: unable to open /nonexistent/trace.json");
+}
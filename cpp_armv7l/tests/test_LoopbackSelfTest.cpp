@@ -0,0 +1,280 @@
+/*
+ * Unit tests for LoopbackSelfTest: the sequence-numbered pattern it sends,
+ * and how gaps, late samples and duplicates in what comes back are counted.
+ */
+
+#define BOOST_TEST_MODULE LoopbackSelfTest
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "LoopbackSelfTest.h"
+
+// Standard Include(s)
+#include <string>
+#include <vector>
+
+// Long enough that a test never stops sending by itself
+static const double NEVER_DONE = 60.0;
+
+// The pattern's samples numbered from first up to and including last
+static std::vector<std::complex<short> > numbered(uint32_t first, uint32_t last)
+{
+    std::vector<std::complex<short> > samples;
+
+    for (uint32_t number = first; number <= last; ++number)
+    {
+        samples.push_back(std::complex<short>(short(number & 0xffff), short(number >> 16)));
+    }
+
+    return samples;
+}
+
+static void check(LoopbackSelfTest &test, const std::vector<std::complex<short> > &samples)
+{
+    test.check(&samples[0], samples.size(), monotonicNanoseconds());
+}
+
+// Send the given number of runs of the pattern
+static void send(LoopbackSelfTest &test, size_t runs)
+{
+    const std::complex<short> *samples = NULL;
+    size_t count = 0;
+    bool startOfBurst = false;
+    bool endOfBurst = false;
+
+    for (size_t i = 0; i < runs; ++i)
+    {
+        BOOST_REQUIRE(test.next(samples, count, startOfBurst, endOfBurst));
+        BOOST_REQUIRE(count > 0);
+    }
+}
+
+// Send the pattern until the test's duration has passed, returning every
+// sample sent
+static std::vector<std::complex<short> > sendAll(LoopbackSelfTest &test)
+{
+    std::vector<std::complex<short> > sent;
+    const std::complex<short> *samples = NULL;
+    size_t count = 0;
+    bool startOfBurst = false;
+    bool endOfBurst = false;
+
+    while (test.next(samples, count, startOfBurst, endOfBurst))
+    {
+        sent.insert(sent.end(), samples, samples + count);
+
+        if (endOfBurst)
+        {
+            break;
+        }
+    }
+
+    return sent;
+}
+
+static selfTestResults_struct results(LoopbackSelfTest &test)
+{
+    selfTestResults_struct results;
+
+    test.report(results);
+
+    return results;
+}
+
+BOOST_AUTO_TEST_CASE(sends_a_numbered_pattern_in_one_burst)
+{
+    SampleBufferPool pool;
+    LoopbackSelfTest test(pool);
+    const std::complex<short> *samples = NULL;
+    size_t count = 0;
+    bool startOfBurst = false;
+    bool endOfBurst = false;
+
+    BOOST_CHECK_EQUAL(test.status(), "idle");
+    BOOST_CHECK(not test.next(samples, count, startOfBurst, endOfBurst));
+
+    test.start(NEVER_DONE, 0, 8);
+
+    BOOST_REQUIRE(test.next(samples, count, startOfBurst, endOfBurst));
+    BOOST_CHECK_EQUAL(count, 8u);
+    BOOST_CHECK(startOfBurst);
+    BOOST_CHECK(not endOfBurst);
+    BOOST_CHECK_EQUAL(samples[7].real(), 7);
+
+    BOOST_REQUIRE(test.next(samples, count, startOfBurst, endOfBurst));
+    BOOST_CHECK(not startOfBurst);
+    BOOST_CHECK_EQUAL(samples[0].real(), 8);
+    BOOST_CHECK(test.sending());
+    BOOST_CHECK_EQUAL(test.status(), "sending, 16 samples sent");
+}
+
+BOOST_AUTO_TEST_CASE(completes_once_every_sample_is_back)
+{
+    SampleBufferPool pool;
+    LoopbackSelfTest test(pool);
+
+    test.start(0.05, 0, 64);
+
+    std::vector<std::complex<short> > sent = sendAll(test);
+
+    BOOST_REQUIRE(not sent.empty());
+    BOOST_CHECK(not test.sending());
+    BOOST_CHECK(test.checking());
+
+    check(test, sent);
+
+    BOOST_CHECK(not test.checking());
+    BOOST_CHECK_EQUAL(test.status().compare(0, 9, "complete:"), 0);
+
+    selfTestResults_struct report = results(test);
+
+    BOOST_CHECK_EQUAL(report.samplesSent, sent.size());
+    BOOST_CHECK_EQUAL(report.samplesReceived, sent.size());
+    BOOST_CHECK_EQUAL(report.droppedSamples, 0u);
+    BOOST_CHECK_EQUAL(report.reorderedSamples, 0u);
+    BOOST_CHECK_GT(report.roundTripP50, 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(skips_what_arrives_ahead_of_the_pattern)
+{
+    SampleBufferPool pool;
+    LoopbackSelfTest test(pool);
+
+    test.start(NEVER_DONE, 0, 8);
+    send(test, 4);
+
+    // Whatever the block held from before was never sent by this test
+    check(test, numbered(1000, 1010));
+    check(test, numbered(0, 31));
+
+    selfTestResults_struct report = results(test);
+
+    BOOST_CHECK_EQUAL(report.samplesReceived, 32u);
+    BOOST_CHECK_EQUAL(report.droppedSamples, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(counts_a_gap_as_dropped)
+{
+    SampleBufferPool pool;
+    LoopbackSelfTest test(pool);
+
+    test.start(NEVER_DONE, 0, 8);
+    send(test, 4);
+
+    check(test, numbered(0, 9));
+    check(test, numbered(20, 31));
+
+    selfTestResults_struct report = results(test);
+
+    BOOST_CHECK_EQUAL(report.samplesReceived, 22u);
+    BOOST_CHECK_EQUAL(report.droppedSamples, 10u);
+    BOOST_CHECK_EQUAL(report.reorderedSamples, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(a_late_sample_is_reordered_rather_than_dropped)
+{
+    SampleBufferPool pool;
+    LoopbackSelfTest test(pool);
+
+    test.start(NEVER_DONE, 0, 8);
+    send(test, 2);
+
+    check(test, numbered(0, 9));
+    check(test, numbered(12, 15));
+
+    BOOST_CHECK_EQUAL(results(test).droppedSamples, 2u);
+
+    check(test, numbered(10, 11));
+
+    selfTestResults_struct report = results(test);
+
+    BOOST_CHECK_EQUAL(report.droppedSamples, 0u);
+    BOOST_CHECK_EQUAL(report.reorderedSamples, 2u);
+    BOOST_CHECK_EQUAL(report.samplesReceived, 16u);
+}
+
+BOOST_AUTO_TEST_CASE(duplicates_never_wrap_the_dropped_count)
+{
+    SampleBufferPool pool;
+    LoopbackSelfTest test(pool);
+
+    test.start(NEVER_DONE, 0, 8);
+    send(test, 2);
+
+    // Duplicates with nothing skipped over
+    check(test, numbered(0, 9));
+    check(test, numbered(5, 5));
+    check(test, numbered(5, 5));
+
+    selfTestResults_struct report = results(test);
+
+    BOOST_CHECK_EQUAL(report.droppedSamples, 0u);
+    BOOST_CHECK_EQUAL(report.reorderedSamples, 2u);
+
+    // A late sample, then a duplicate of it, only take back the one skipped
+    check(test, numbered(11, 12));
+    check(test, numbered(10, 10));
+    check(test, numbered(10, 10));
+
+    report = results(test);
+
+    BOOST_CHECK_EQUAL(report.droppedSamples, 0u);
+    BOOST_CHECK_EQUAL(report.reorderedSamples, 4u);
+
+    check(test, numbered(15, 15));
+
+    BOOST_CHECK_EQUAL(results(test).droppedSamples, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(counts_a_missing_tail_once_drained)
+{
+    SampleBufferPool pool;
+    LoopbackSelfTest test(pool);
+
+    test.start(0.05, 0, 64);
+
+    std::vector<std::complex<short> > sent = sendAll(test);
+
+    BOOST_REQUIRE_GT(sent.size(), 16u);
+
+    check(test, std::vector<std::complex<short> >(sent.begin(), sent.begin() + 16));
+
+    BOOST_CHECK(test.checking());
+    BOOST_CHECK_EQUAL(test.status(), "draining");
+
+    // Nothing more arrives within the drain timeout
+    boost::this_thread::sleep(boost::posix_time::milliseconds(600));
+
+    BOOST_CHECK(not test.checking());
+    BOOST_CHECK_EQUAL(results(test).droppedSamples, sent.size() - 16);
+}
+
+BOOST_AUTO_TEST_CASE(abort_stops_sending_and_checking)
+{
+    SampleBufferPool pool;
+    LoopbackSelfTest test(pool);
+    const std::complex<short> *samples = NULL;
+    size_t count = 0;
+    bool startOfBurst = false;
+    bool endOfBurst = false;
+
+    test.start(NEVER_DONE, 0, 8);
+    send(test, 2);
+    test.abort();
+
+    BOOST_CHECK(not test.next(samples, count, startOfBurst, endOfBurst));
+    BOOST_CHECK(not test.checking());
+
+    check(test, numbered(0, 15));
+
+    BOOST_CHECK_EQUAL(results(test).samplesReceived, 0u);
+    BOOST_CHECK_EQUAL(test.status(), "aborted");
+
+    // A new test starts from scratch
+    test.start(NEVER_DONE, 0, 8);
+    send(test, 1);
+    check(test, numbered(0, 7));
+
+    BOOST_CHECK_EQUAL(results(test).samplesSent, 8u);
+    BOOST_CHECK_EQUAL(results(test).samplesReceived, 8u);
+}
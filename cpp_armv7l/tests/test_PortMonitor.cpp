@@ -0,0 +1,176 @@
+/*
+ * Unit tests for PortMonitor: the budget a buffer's pushes to every block
+ * port have to fit in together, which pushes are counted as stalled and the
+ * share of them, and restarting the counts as connections change.
+ */
+
+#define BOOST_TEST_MODULE PortMonitor
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+#include "PortMonitor.h"
+
+// Boost Include(s)
+#include <boost/thread.hpp>
+
+// Standard Include(s)
+#include <string>
+
+/*
+ * An output port whose pushes take a set time, pushed once for each block
+ * port of a buffer and timed as the RX push thread does
+ */
+struct MockOutputPort
+{
+    MockOutputPort(unsigned int pushMilliseconds) :
+        pushMilliseconds(pushMilliseconds)
+    {
+    }
+
+    // Push one buffer to every block port, charging the pushes to the port
+    void pushBuffer(PortMonitor &monitor, size_t port, size_t channels, size_t samples, double sampleRate)
+    {
+        uint64_t nanoseconds = 0;
+
+        for (size_t channel = 0; channel < channels; ++channel)
+        {
+            uint64_t start = monotonicNanoseconds();
+
+            boost::this_thread::sleep(boost::posix_time::milliseconds(this->pushMilliseconds));
+
+            nanoseconds += monotonicNanoseconds() - start;
+        }
+
+        uint64_t budget = PortMonitor::pushBudget(samples, sampleRate);
+
+        monitor.record(port, nanoseconds, nanoseconds > budget);
+    }
+
+    unsigned int pushMilliseconds;
+};
+
+static bool contains(const std::string &text, const std::string &pattern)
+{
+    return (text.find(pattern) != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(the_budget_is_one_buffers_duration)
+{
+    BOOST_CHECK_EQUAL(PortMonitor::pushBudget(1000, 1e6), 1000000u);
+    BOOST_CHECK_EQUAL(PortMonitor::pushBudget(512, 0), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(pushes_slower_than_real_time_across_block_ports_stall)
+{
+    PortMonitor monitor;
+    size_t port = monitor.addPort("dataShort_out");
+
+    monitor.connect(port, "consumer");
+
+    // Each of the four block ports' pushes fits in the 10 ms the buffer
+    // lasts, but together they take 12 ms, which can't keep up
+    MockOutputPort slow(3);
+
+    slow.pushBuffer(monitor, port, 4, 10000, 1e6);
+
+    BOOST_CHECK(contains(monitor.status(), "1 pushes averaging"));
+    BOOST_CHECK(contains(monitor.status(), "1 stalled (100%)"));
+}
+
+BOOST_AUTO_TEST_CASE(pushes_within_real_time_across_block_ports_dont_stall)
+{
+    PortMonitor monitor;
+    size_t port = monitor.addPort("dataShort_out");
+
+    monitor.connect(port, "consumer");
+
+    MockOutputPort fast(1);
+
+    fast.pushBuffer(monitor, port, 4, 50000, 1e6);
+
+    BOOST_CHECK(contains(monitor.status(), "0 stalled (0%)"));
+}
+
+BOOST_AUTO_TEST_CASE(reports_the_share_of_stalled_pushes)
+{
+    PortMonitor monitor;
+    size_t port = monitor.addPort("dataShort_out");
+
+    monitor.connect(port, "consumer");
+
+    monitor.record(port, 1000, true);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        monitor.record(port, 1000, false);
+    }
+
+    BOOST_CHECK(contains(monitor.status(), "4 pushes averaging 1 us, 1 stalled (25%)"));
+}
+
+BOOST_AUTO_TEST_CASE(lists_only_connected_ports)
+{
+    PortMonitor monitor;
+    size_t unconnected = monitor.addPort("dataFloat_out");
+    size_t connected = monitor.addPort("dataShort_out");
+
+    BOOST_CHECK_EQUAL(monitor.status(), "");
+
+    monitor.connect(connected, "first");
+    monitor.connect(connected, "second");
+    monitor.record(unconnected, 1000, true);
+
+    std::string status = monitor.status();
+
+    BOOST_CHECK_EQUAL(status.compare(0, 30, "dataShort_out (first, second):"), 0);
+    BOOST_CHECK(not contains(status, "dataFloat_out"));
+    BOOST_CHECK(not contains(status, "\n"));
+}
+
+BOOST_AUTO_TEST_CASE(a_duplicate_connection_id_isnt_added_twice)
+{
+    PortMonitor monitor;
+    size_t port = monitor.addPort("dataShort_out");
+
+    monitor.connect(port, "consumer");
+    monitor.connect(port, "consumer");
+
+    BOOST_CHECK(contains(monitor.status(), "dataShort_out (consumer):"));
+
+    // One disconnect removes it
+    monitor.disconnect(port, "consumer");
+
+    BOOST_CHECK_EQUAL(monitor.status(), "");
+}
+
+BOOST_AUTO_TEST_CASE(counts_restart_when_connections_change)
+{
+    PortMonitor monitor;
+    size_t port = monitor.addPort("dataShort_out");
+
+    monitor.connect(port, "first");
+    monitor.record(port, 1000, true);
+    monitor.record(port, 1000, true);
+
+    BOOST_CHECK(contains(monitor.status(), "2 pushes averaging 1 us, 2 stalled (100%)"));
+
+    monitor.connect(port, "second");
+
+    BOOST_CHECK(contains(monitor.status(), "0 pushes averaging 0 us, 0 stalled (0%)"));
+
+    monitor.record(port, 3000, true);
+
+    BOOST_CHECK(contains(monitor.status(), "1 pushes averaging 3 us, 1 stalled (100%)"));
+
+    monitor.disconnect(port, "first");
+
+    BOOST_CHECK(contains(monitor.status(), "dataShort_out (second): "));
+    BOOST_CHECK(contains(monitor.status(), "0 pushes averaging 0 us, 0 stalled (0%)"));
+
+    // Disconnecting an unknown connection changes nothing, so the counts stand
+    monitor.record(port, 1000, false);
+    monitor.disconnect(port, "unknown");
+
+    BOOST_CHECK(contains(monitor.status(), "1 pushes averaging 1 us, 0 stalled (0%)"));
+}
@@ -0,0 +1,323 @@
+/*
+ * Unit tests for RxBufferRing: the order buffers come back out in, wrapping
+ * around the ring, the overflow policies, including the block policy's timeout,
+ * and the congestion watermarks.
+ */
+
+#define BOOST_TEST_MODULE RxBufferRing
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+#include "RxBufferRing.h"
+#include "SampleBufferPool.h"
+#include "TestHelpers.h"
+
+// Boost Include(s)
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+// Take the next queued buffer, returning its number and freeing it
+static short drainNumbered(RxBufferRing &ring)
+{
+    RxBuffer *buffer = ring.acquireFull(0);
+
+    BOOST_REQUIRE(buffer);
+
+    short number = buffer->data[0].real();
+
+    ring.release(buffer);
+
+    return number;
+}
+
+static void releaseAfter(RxBufferRing *ring, RxBuffer *buffer, unsigned int milliseconds)
+{
+    boost::this_thread::sleep(boost::posix_time::milliseconds(milliseconds));
+
+    ring->release(buffer);
+}
+
+BOOST_AUTO_TEST_CASE(keeps_at_least_three_buffers)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 1, 64);
+
+    BOOST_CHECK_EQUAL(ring.capacity(), 3u);
+    BOOST_CHECK_EQUAL(ring.bufferSize(), 64u);
+    BOOST_CHECK_EQUAL(ring.channels(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(lays_channels_out_a_buffer_size_apart)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 4, 100, 3);
+
+    RxBuffer *buffer = ring.acquireFree();
+
+    BOOST_CHECK_EQUAL(ring.channels(), 3u);
+    BOOST_CHECK(ring.channelData(buffer, 0) == buffer->data);
+    BOOST_CHECK(ring.channelData(buffer, 2) == buffer->data + 200);
+
+    ring.release(buffer);
+}
+
+BOOST_AUTO_TEST_CASE(wraps_around_in_order)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 4, 16);
+
+    // Two buffers in flight at a time walk every buffer around the ring
+    // several times over
+    short next = 0;
+    short expected = 0;
+
+    BOOST_CHECK(commitNumbered(ring, next++));
+
+    for (size_t i = 0; i < 5 * ring.capacity(); ++i)
+    {
+        BOOST_CHECK(commitNumbered(ring, next++));
+        BOOST_CHECK_EQUAL(drainNumbered(ring), expected++);
+    }
+
+    BOOST_CHECK_EQUAL(drainNumbered(ring), expected++);
+    BOOST_CHECK_EQUAL(ring.depth(), 0u);
+    BOOST_CHECK_EQUAL(ring.dropped(), 0u);
+    BOOST_CHECK(ring.acquireFull(0) == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(drop_oldest_reclaims_the_oldest_queued_buffer)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 3, 16);
+
+    BOOST_CHECK(ring.configure("dropOldest"));
+    BOOST_CHECK_EQUAL(ring.overflowPolicy(), RxBufferRing::DROP_OLDEST);
+
+    for (short number = 0; number < 5; ++number)
+    {
+        BOOST_CHECK(commitNumbered(ring, number));
+    }
+
+    BOOST_CHECK_EQUAL(ring.dropped(), 2u);
+    BOOST_CHECK_EQUAL(ring.depth(), 3u);
+    BOOST_CHECK_EQUAL(drainNumbered(ring), 2);
+    BOOST_CHECK_EQUAL(drainNumbered(ring), 3);
+    BOOST_CHECK_EQUAL(drainNumbered(ring), 4);
+}
+
+BOOST_AUTO_TEST_CASE(rejects_unknown_policies)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 3, 16);
+
+    BOOST_CHECK(ring.configure("pause"));
+    BOOST_CHECK(not ring.configure("dropNewest"));
+    BOOST_CHECK_EQUAL(ring.overflowPolicy(), RxBufferRing::PAUSE);
+}
+
+BOOST_AUTO_TEST_CASE(watermarks_bound_congestion)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 8, 16);
+
+    // Congested from six queued buffers until back down to two
+    ring.setWatermarks(0.25, 0.75);
+
+    for (short number = 0; number < 5; ++number)
+    {
+        commitNumbered(ring, number);
+    }
+
+    BOOST_CHECK(not ring.congested());
+
+    commitNumbered(ring, 5);
+
+    BOOST_CHECK(ring.congested());
+
+    drainNumbered(ring);
+    drainNumbered(ring);
+    drainNumbered(ring);
+
+    BOOST_CHECK_EQUAL(ring.depth(), 3u);
+    BOOST_CHECK(ring.congested());
+
+    drainNumbered(ring);
+
+    BOOST_CHECK(not ring.congested());
+}
+
+BOOST_AUTO_TEST_CASE(watermarks_are_clamped)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 4, 16);
+
+    // A high watermark of zero still takes a queued buffer to reach, and the
+    // low one always sits below it
+    ring.setWatermarks(0.9, 0);
+
+    BOOST_CHECK(not ring.congested());
+
+    commitNumbered(ring, 0);
+
+    BOOST_CHECK(ring.congested());
+
+    drainNumbered(ring);
+
+    BOOST_CHECK(not ring.congested());
+}
+
+BOOST_AUTO_TEST_CASE(decimate_frees_every_other_buffer_while_congested)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 8, 16);
+
+    ring.configure("decimate");
+    ring.setWatermarks(0.25, 0.5);
+
+    for (short number = 0; number < 4; ++number)
+    {
+        BOOST_CHECK(commitNumbered(ring, number));
+    }
+
+    BOOST_CHECK(ring.congested());
+
+    BOOST_CHECK(not commitNumbered(ring, 4));
+    BOOST_CHECK(commitNumbered(ring, 5));
+    BOOST_CHECK(not commitNumbered(ring, 6));
+    BOOST_CHECK(commitNumbered(ring, 7));
+
+    BOOST_CHECK_EQUAL(ring.decimated(), 2u);
+    BOOST_CHECK_EQUAL(ring.dropped(), 0u);
+    BOOST_CHECK_EQUAL(ring.depth(), 6u);
+
+    // Draining to the low watermark ends the congestion and the decimation
+    for (short number = 0; number < 4; ++number)
+    {
+        BOOST_CHECK_EQUAL(drainNumbered(ring), number);
+    }
+
+    BOOST_CHECK(not ring.congested());
+    BOOST_CHECK(commitNumbered(ring, 8));
+    BOOST_CHECK_EQUAL(ring.decimated(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(block_waits_for_a_free_buffer)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 3, 16);
+
+    ring.configure("block");
+
+    for (short number = 0; number < 2; ++number)
+    {
+        commitNumbered(ring, number);
+    }
+
+    RxBuffer *held = ring.acquireFree();
+    boost::thread releaser(boost::bind(&releaseAfter, &ring, held, 50));
+
+    RxBuffer *buffer = ring.acquireFree();
+
+    releaser.join();
+
+    BOOST_CHECK(buffer == held);
+    BOOST_CHECK_EQUAL(ring.dropped(), 0u);
+    BOOST_CHECK_EQUAL(ring.blockTimeouts(), 0u);
+    BOOST_CHECK_EQUAL(ring.depth(), 2u);
+    BOOST_CHECK_GT(ring.blockedTime(), 0.0);
+
+    ring.release(buffer);
+}
+
+BOOST_AUTO_TEST_CASE(block_times_out_to_reclaiming_the_oldest_buffer)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 3, 16);
+
+    ring.configure("block");
+
+    for (short number = 0; number < 3; ++number)
+    {
+        commitNumbered(ring, number);
+    }
+
+    // Nothing frees a buffer, so after a second the oldest is reclaimed
+    RxBuffer *buffer = ring.acquireFree();
+
+    BOOST_CHECK(buffer);
+    BOOST_CHECK_EQUAL(ring.dropped(), 1u);
+    BOOST_CHECK_EQUAL(ring.blockTimeouts(), 1u);
+    BOOST_CHECK_GE(ring.blockedTime(), 0.9);
+
+    ring.release(buffer);
+
+    BOOST_CHECK_EQUAL(drainNumbered(ring), 1);
+}
+
+BOOST_AUTO_TEST_CASE(cancel_ends_a_blocked_wait)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 3, 16);
+
+    ring.configure("block");
+
+    for (short number = 0; number < 3; ++number)
+    {
+        commitNumbered(ring, number);
+    }
+
+    // Well within the block timeout, the wait gives up and reclaims the
+    // oldest queued buffer
+    boost::thread canceller(boost::bind(&cancelAfter<RxBufferRing>, &ring, 50));
+
+    uint64_t start = monotonicNanoseconds();
+    RxBuffer *buffer = ring.acquireFree();
+    uint64_t waited = monotonicNanoseconds() - start;
+
+    canceller.join();
+
+    BOOST_CHECK(buffer);
+    BOOST_CHECK_LT(waited, 500000000u);
+    BOOST_CHECK_EQUAL(ring.dropped(), 1u);
+    BOOST_CHECK_EQUAL(ring.blockTimeouts(), 0u);
+
+    ring.release(buffer);
+
+    // Nor does the push side wait while cancelled
+    ring.clear();
+    ring.cancel();
+
+    start = monotonicNanoseconds();
+
+    BOOST_CHECK(ring.acquireFull(5.0) == NULL);
+    BOOST_CHECK_LT(monotonicNanoseconds() - start, 500000000u);
+}
+
+BOOST_AUTO_TEST_CASE(clear_frees_every_queued_buffer)
+{
+    SampleBufferPool pool;
+    RxBufferRing ring(pool, 4, 16);
+
+    ring.setWatermarks(0, 0.5);
+
+    for (short number = 0; number < 3; ++number)
+    {
+        commitNumbered(ring, number);
+    }
+
+    BOOST_CHECK(ring.congested());
+
+    ring.clear();
+
+    BOOST_CHECK_EQUAL(ring.depth(), 0u);
+    BOOST_CHECK(not ring.congested());
+
+    // Every buffer is free again, so none are reclaimed
+    for (short number = 0; number < 4; ++number)
+    {
+        commitNumbered(ring, number);
+    }
+
+    BOOST_CHECK_EQUAL(ring.dropped(), 0u);
+}
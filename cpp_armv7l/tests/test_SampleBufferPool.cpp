@@ -0,0 +1,180 @@
+/*
+ * Unit tests for SampleBufferPool: rounding requests to whole pages, sharing
+ * slabs between small buffers, reusing released buffers, and falling back to
+ * the heap once the limit is reached.
+ */
+
+#define BOOST_TEST_MODULE SampleBufferPool
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "SampleBufferPool.h"
+
+// Standard Include(s)
+#include <stdint.h>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(rounds_requests_to_whole_pages)
+{
+    SampleBufferPool pool;
+
+    void *empty = pool.acquire(0);
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 4096u);
+
+    void *small = pool.acquire(1);
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 8192u);
+
+    void *page = pool.acquire(4096);
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 12288u);
+
+    void *overPage = pool.acquire(4097);
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 20480u);
+
+    BOOST_CHECK_EQUAL(uintptr_t(empty) % 64, 0u);
+    BOOST_CHECK_EQUAL(uintptr_t(overPage) % 64, 0u);
+
+    pool.release(empty);
+    pool.release(small);
+    pool.release(page);
+    pool.release(overPage);
+
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(small_buffers_share_a_slab)
+{
+    SampleBufferPool pool;
+    std::vector<void *> buffers;
+
+    // Sixteen single pages fit in the 64 KiB minimum slab
+    for (size_t i = 0; i < 16; ++i)
+    {
+        buffers.push_back(pool.acquire(100));
+    }
+
+    BOOST_CHECK_EQUAL(pool.bytesReserved(), 65536u);
+    BOOST_CHECK_EQUAL(pool.status(), "1 slab(s), normal pages, unlocked");
+
+    buffers.push_back(pool.acquire(100));
+
+    BOOST_CHECK_EQUAL(pool.bytesReserved(), 131072u);
+
+    // Larger buffers get a slab of their own size
+    buffers.push_back(pool.acquire(100000));
+
+    BOOST_CHECK_EQUAL(pool.bytesReserved(), 131072u + 102400u);
+
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+        pool.release(buffers[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(huge_pages_round_slabs_to_a_huge_page)
+{
+    SampleBufferPool pool;
+
+    pool.configure(true, false, 0);
+
+    // Without huge pages available the slab falls back to normal pages, but
+    // keeps its size
+    void *buffer = pool.acquire(1);
+
+    BOOST_CHECK_EQUAL(pool.bytesReserved(), 2u * 1024 * 1024);
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 4096u);
+
+    pool.release(buffer);
+}
+
+BOOST_AUTO_TEST_CASE(reuses_a_released_buffer_of_the_same_size)
+{
+    SampleBufferPool pool;
+
+    void *first = pool.acquire(5000);
+    void *other = pool.acquire(100);
+
+    pool.release(first);
+
+    BOOST_CHECK(pool.acquire(8192) == first);
+    BOOST_CHECK(pool.acquire(100) != first);
+    BOOST_CHECK_EQUAL(pool.bytesReserved(), 131072u);
+
+    pool.release(other);
+}
+
+BOOST_AUTO_TEST_CASE(falls_back_to_the_heap_at_the_limit)
+{
+    SampleBufferPool pool;
+
+    pool.configure(false, false, 65536);
+
+    void *pooled = pool.acquire(100);
+
+    BOOST_CHECK_EQUAL(pool.exhaustions(), 0u);
+
+    // Another slab would go past the limit
+    void *heap = pool.acquire(100000);
+
+    BOOST_REQUIRE(heap);
+    BOOST_CHECK_EQUAL(uintptr_t(heap) % 64, 0u);
+    BOOST_CHECK_EQUAL(pool.exhaustions(), 1u);
+    BOOST_CHECK_EQUAL(pool.bytesReserved(), 65536u);
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 4096u + 102400u);
+
+    // The heap buffer is freed rather than kept
+    pool.release(heap);
+
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 4096u);
+
+    void *again = pool.acquire(100000);
+
+    BOOST_CHECK_EQUAL(pool.exhaustions(), 2u);
+
+    pool.release(again);
+    pool.release(pooled);
+
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(tracks_the_bytes_in_use_and_the_high_water_mark)
+{
+    SampleBufferPool pool;
+
+    void *first = pool.acquire(4096);
+    void *second = pool.acquire(8192);
+
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 12288u);
+    BOOST_CHECK_EQUAL(pool.highWaterMark(), 12288u);
+
+    pool.release(first);
+
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 8192u);
+    BOOST_CHECK_EQUAL(pool.highWaterMark(), 12288u);
+
+    first = pool.acquire(4096);
+
+    BOOST_CHECK_EQUAL(pool.highWaterMark(), 12288u);
+
+    pool.release(first);
+    pool.release(second);
+
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 0u);
+    BOOST_CHECK_EQUAL(pool.highWaterMark(), 12288u);
+}
+
+BOOST_AUTO_TEST_CASE(releasing_nothing_or_an_unknown_buffer_is_safe)
+{
+    SampleBufferPool pool;
+    int notPooled = 0;
+
+    void *buffer = pool.acquire(100);
+
+    pool.release(NULL);
+    pool.release(&notPooled);
+
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 4096u);
+
+    pool.release(buffer);
+
+    BOOST_CHECK_EQUAL(pool.bytesInUse(), 0u);
+}
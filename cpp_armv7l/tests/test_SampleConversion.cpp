@@ -0,0 +1,134 @@
+/*
+ * Unit tests for the sample conversions: scaling, rounding halves away from
+ * zero and saturating at the limits of a short. Buffers of every length up to
+ * a few vectors make sure the vectorized kernels and the scalar remainder
+ * agree.
+ */
+
+#define BOOST_TEST_MODULE SampleConversion
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "SampleConversion.h"
+
+// Standard Include(s)
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// The expected conversion of a single scaled float
+static short expectedShort(double value)
+{
+    value = (value < 0) ? std::ceil(value - 0.5) : std::floor(value + 0.5);
+
+    return short(std::min(std::max(value, -32768.0), 32767.0));
+}
+
+// Convert a value at every position of buffers of every length, so each
+// kernel and the remainder see it
+static void checkFloatToShort(float value, float scale)
+{
+    short wanted = expectedShort(double(value) / scale);
+
+    for (size_t count = 1; count <= 33; ++count)
+    {
+        std::vector<float> input(count, value);
+        std::vector<short> output(count, 0);
+
+        convertFloatToShort(&input[0], &output[0], count, scale);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            BOOST_CHECK_MESSAGE(output[i] == wanted, value << " became " << output[i] << " rather than " << wanted << " at " << i << " of " << count);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(names_the_kernel)
+{
+    std::string name = conversionKernelName();
+
+    BOOST_CHECK(name == "NEON" or name == "SSE2" or name == "scalar");
+}
+
+BOOST_AUTO_TEST_CASE(short_to_float_scales)
+{
+    std::vector<short> input;
+
+    for (int value = -32768; value <= 32767; value += 257)
+    {
+        input.push_back(short(value));
+    }
+
+    std::vector<float> output(input.size());
+
+    convertShortToFloat(&input[0], &output[0], input.size(), 1.0f / 32768);
+
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(output[i], input[i] / 32768.0f);
+    }
+
+    BOOST_CHECK_EQUAL(output.front(), -1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(halves_round_away_from_zero)
+{
+    float values[] = {0.5f, -0.5f, 1.5f, -1.5f, 2.5f, -2.5f, 1.49f, -1.49f, 0.0f, -0.0f};
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+        checkFloatToShort(values[i], 1.0f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(saturates_at_the_limits_of_a_short)
+{
+    float values[] = {32766.6f, 32767.0f, 32767.4f, 32767.5f, 40000.0f, 1e10f, -32767.6f, -32768.0f, -32768.4f, -32768.5f, -40000.0f, -1e10f};
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+        checkFloatToShort(values[i], 1.0f);
+    }
+
+    // Full scale and beyond on the float ports
+    checkFloatToShort(1.0f, 1.0f / 32768);
+    checkFloatToShort(-1.0f, 1.0f / 32768);
+    checkFloatToShort(2.0f, 1.0f / 32768);
+}
+
+BOOST_AUTO_TEST_CASE(divides_by_the_scale)
+{
+    checkFloatToShort(0.25f, 1.0f / 32768);
+    checkFloatToShort(-0.125f, 1.0f / 32768);
+    checkFloatToShort(1000.0f, 4.0f);
+}
+
+BOOST_AUTO_TEST_CASE(a_zero_scale_gives_zeros)
+{
+    std::vector<float> input(19, 1.0f);
+    std::vector<short> output(input.size(), 1);
+
+    convertFloatToShort(&input[0], &output[0], input.size(), 0.0f);
+
+    BOOST_CHECK_EQUAL(std::count(output.begin(), output.end(), 0), long(output.size()));
+}
+
+BOOST_AUTO_TEST_CASE(round_trips_every_short)
+{
+    std::vector<short> input;
+
+    for (int value = -32768; value <= 32767; ++value)
+    {
+        input.push_back(short(value));
+    }
+
+    std::vector<float> floats(input.size());
+    std::vector<short> output(input.size());
+
+    convertShortToFloat(&input[0], &floats[0], input.size(), 1.0f / 32768);
+    convertFloatToShort(&floats[0], &output[0], floats.size(), 1.0f / 32768);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(output.begin(), output.end(), input.begin(), input.end());
+}
@@ -0,0 +1,242 @@
+/*
+ * Unit tests for SriPublisher: the SRI published for each block port, and
+ * when replaced snapshots are reclaimed. Reclaiming is observed through the
+ * global operator delete, which is replaced here to remember what it freed.
+ */
+
+#define BOOST_TEST_MODULE SriPublisher
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "SriPublisher.h"
+
+// REDHAWK Include(s)
+#include <ossie/PropertyMap.h>
+
+// Standard Include(s)
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace
+{
+    // The most recently freed pointers. The tests are single threaded.
+    const size_t FREED_COUNT = 64;
+
+    const void *freed[FREED_COUNT];
+    size_t freedHead = 0;
+
+    bool wasFreed(const void *pointer)
+    {
+        return (std::find(freed, freed + FREED_COUNT, pointer) != freed + FREED_COUNT);
+    }
+
+    void forgetFreed()
+    {
+        std::fill(freed, freed + FREED_COUNT, (const void *) NULL);
+    }
+}
+
+void *operator new(size_t size)
+{
+    void *pointer = malloc(std::max(size, size_t(1)));
+
+    if (not pointer)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+void operator delete(void *pointer) throw()
+{
+    if (pointer)
+    {
+        freed[freedHead++ % FREED_COUNT] = pointer;
+    }
+
+    free(pointer);
+}
+
+// Compilers which size their deletes call this one instead
+void operator delete(void *pointer, size_t) throw()
+{
+    operator delete(pointer);
+}
+
+static BULKIO::StreamSRI inputSRI(const std::string &streamID)
+{
+    return bulkio::sri::create(streamID, 1e6);
+}
+
+BOOST_AUTO_TEST_CASE(publishes_nothing_until_there_is_an_sri)
+{
+    SriPublisher publisher;
+
+    publisher.setPorts(2);
+    publisher.setSampleRate(5e6);
+
+    BOOST_CHECK(not publisher.published());
+    BOOST_CHECK(publisher.acquire() == NULL);
+
+    publisher.setSRI(inputSRI("stream"));
+
+    BOOST_CHECK(publisher.published());
+    BOOST_REQUIRE(publisher.acquire());
+    BOOST_CHECK_EQUAL(publisher.acquire()->generation, 1u);
+    BOOST_CHECK_EQUAL(publisher.acquire()->portSRIs.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(each_change_is_a_new_generation)
+{
+    SriPublisher publisher;
+
+    publisher.setSRI(inputSRI("stream"));
+
+    const SriSnapshot *first = publisher.acquire();
+
+    BOOST_CHECK(publisher.acquire() == first);
+
+    // Setting the same rate again changes nothing
+    publisher.setSampleRate(2e6);
+    publisher.setSampleRate(2e6);
+    publisher.setPorts(1);
+
+    const SriSnapshot *latest = publisher.acquire();
+
+    BOOST_CHECK_EQUAL(latest->generation, 3u);
+    BOOST_CHECK_CLOSE(latest->portSRIs[0].xdelta, 0.5e-6, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(one_port_keeps_the_input_stream)
+{
+    SriPublisher publisher;
+
+    publisher.setSRI(inputSRI("stream"));
+
+    const SriSnapshot *snapshot = publisher.acquire();
+
+    BOOST_REQUIRE_EQUAL(snapshot->portSRIs.size(), 1u);
+    BOOST_CHECK_EQUAL(snapshot->streamIDs[0], "stream");
+    BOOST_CHECK_EQUAL(std::string(snapshot->portSRIs[0].streamID.in()), "stream");
+    BOOST_CHECK_EQUAL(snapshot->portSRIs[0].mode, 1);
+    BOOST_CHECK_CLOSE(snapshot->portSRIs[0].xdelta, 1e-6, 1e-9);
+    BOOST_CHECK(not redhawk::PropertyMap::cast(snapshot->portSRIs[0].keywords).contains("BLOCK_PORT"));
+}
+
+BOOST_AUTO_TEST_CASE(labels_the_stream_of_each_port)
+{
+    SriPublisher publisher;
+
+    publisher.setPorts(3);
+    publisher.setSRI(inputSRI("stream"));
+
+    const SriSnapshot *snapshot = publisher.acquire();
+    const char *streamIDs[] = {"stream", "stream_port1", "stream_port2"};
+
+    BOOST_REQUIRE_EQUAL(snapshot->portSRIs.size(), 3u);
+
+    for (size_t port = 0; port < 3; ++port)
+    {
+        const BULKIO::StreamSRI &sri = snapshot->portSRIs[port];
+
+        BOOST_CHECK_EQUAL(snapshot->streamIDs[port], streamIDs[port]);
+        BOOST_CHECK_EQUAL(std::string(sri.streamID.in()), streamIDs[port]);
+        BOOST_CHECK_EQUAL(redhawk::PropertyMap::cast(sri.keywords).get("BLOCK_PORT").toULong(), port);
+    }
+
+    // Back to one port, and the label goes
+    publisher.setPorts(0);
+
+    snapshot = publisher.acquire();
+
+    BOOST_CHECK_EQUAL(snapshot->portSRIs.size(), 1u);
+    BOOST_CHECK(not redhawk::PropertyMap::cast(snapshot->portSRIs[0].keywords).contains("BLOCK_PORT"));
+}
+
+BOOST_AUTO_TEST_CASE(xdelta_follows_the_block_rate_once_known)
+{
+    SriPublisher publisher;
+
+    publisher.setSampleRate(4e6);
+    publisher.setSRI(inputSRI("stream"));
+
+    BOOST_CHECK_CLOSE(publisher.acquire()->portSRIs[0].xdelta, 0.25e-6, 1e-9);
+
+    // A new input SRI doesn't override the block's rate
+    publisher.setSRI(bulkio::sri::create("stream", 8e6));
+
+    BOOST_CHECK_CLOSE(publisher.acquire()->portSRIs[0].xdelta, 0.25e-6, 1e-9);
+
+    // Without a rate, the input's xdelta is passed on
+    publisher.setSampleRate(0);
+
+    BOOST_CHECK_CLOSE(publisher.acquire()->portSRIs[0].xdelta, 0.125e-6, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(keeps_a_snapshot_until_the_pusher_moves_past_it)
+{
+    SriPublisher publisher;
+
+    publisher.setSRI(inputSRI("stream"));
+    publisher.attach();
+
+    const SriSnapshot *held = publisher.acquire();
+
+    forgetFreed();
+
+    publisher.setSRI(inputSRI("a"));
+    publisher.setSRI(inputSRI("b"));
+    publisher.setSRI(inputSRI("c"));
+
+    // The held snapshot, and those published since, may still be taken
+    BOOST_CHECK(not wasFreed(held));
+    BOOST_CHECK_EQUAL(held->streamIDs[0], "stream");
+
+    const SriSnapshot *latest = publisher.acquire();
+
+    BOOST_CHECK_EQUAL(latest->streamIDs[0], "c");
+
+    // Once the pusher has taken a later one, the next publish reclaims the
+    // rest
+    publisher.setSRI(inputSRI("d"));
+
+    BOOST_CHECK(wasFreed(held));
+    BOOST_CHECK(not wasFreed(latest));
+    BOOST_CHECK_EQUAL(latest->streamIDs[0], "c");
+
+    publisher.detach();
+}
+
+BOOST_AUTO_TEST_CASE(keeps_only_the_current_snapshot_while_detached)
+{
+    SriPublisher publisher;
+
+    publisher.setSRI(inputSRI("stream"));
+
+    const SriSnapshot *first = publisher.acquire();
+
+    forgetFreed();
+    publisher.setSRI(inputSRI("a"));
+
+    // Nothing is pushing, so the replaced snapshot goes straight away
+    BOOST_CHECK(wasFreed(first));
+
+    publisher.attach();
+
+    const SriSnapshot *held = publisher.acquire();
+
+    forgetFreed();
+    publisher.setSRI(inputSRI("b"));
+
+    BOOST_CHECK(not wasFreed(held));
+
+    // Detaching reclaims what the pusher last held, and the current snapshot
+    // stays for when it's attached again
+    publisher.detach();
+
+    BOOST_CHECK(wasFreed(held));
+    BOOST_CHECK_EQUAL(publisher.acquire()->streamIDs[0], "b");
+}
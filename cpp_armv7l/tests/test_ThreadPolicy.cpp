@@ -0,0 +1,191 @@
+/*
+ * Unit tests for the thread policy helpers: parsing CPU lists, clamping
+ * priorities outside of a real-time policy's range, rejecting unknown policy
+ * names, and a ThreadPolicy only applying itself once it's pending. Each
+ * policy is applied on a thread of its own, and read back from it.
+ */
+
+#define BOOST_TEST_MODULE ThreadPolicy
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "ThreadPolicy.h"
+
+// Boost Include(s)
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+// Standard Include(s)
+#include <pthread.h>
+#include <sched.h>
+#include <string>
+
+/*
+ * The outcome of applying a policy to a thread, and the scheduling the thread
+ * was left with
+ */
+struct Applied
+{
+    std::string failures;
+    cpu_set_t affinity;
+    int policy;
+    int priority;
+};
+
+static void applyAndReadBack(const std::string &cpus, const std::string &policy, int priority, Applied *applied)
+{
+    struct sched_param parameters;
+
+    applied->failures = applyThreadPolicy(cpus, policy, priority);
+
+    pthread_getaffinity_np(pthread_self(), sizeof(applied->affinity), &applied->affinity);
+    pthread_getschedparam(pthread_self(), &applied->policy, &parameters);
+
+    applied->priority = parameters.sched_priority;
+}
+
+// Apply a policy to a new thread, so the test's own thread is left alone
+static Applied applyOnNewThread(const std::string &cpus, const std::string &policy, int priority)
+{
+    Applied applied;
+
+    boost::thread thread(boost::bind(&applyAndReadBack, cpus, policy, priority, &applied));
+
+    thread.join();
+
+    return applied;
+}
+
+static bool contains(const std::string &text, const std::string &pattern)
+{
+    return (text.find(pattern) != std::string::npos);
+}
+
+static void applyPending(ThreadPolicy *policy, bool *applied)
+{
+    *applied = policy->applyIfPending();
+}
+
+BOOST_AUTO_TEST_CASE(pins_to_a_list_of_cpus_and_ranges)
+{
+    Applied applied = applyOnNewThread("0,2-3", "other", 0);
+
+    BOOST_CHECK(not contains(applied.failures, "invalid CPU list"));
+
+    // The CPUs this host doesn't have are left out of the affinity
+    if (applied.failures.empty())
+    {
+        BOOST_CHECK(CPU_ISSET(0, &applied.affinity));
+        BOOST_CHECK(not CPU_ISSET(1, &applied.affinity));
+    }
+
+    // Spaces around an entry are ignored
+    applied = applyOnNewThread(" 0 ", "other", 0);
+
+    BOOST_CHECK_EQUAL(applied.failures, "");
+    BOOST_CHECK_EQUAL(CPU_COUNT(&applied.affinity), 1);
+    BOOST_CHECK(CPU_ISSET(0, &applied.affinity));
+
+    applied = applyOnNewThread(" 1 ", "other", 0);
+
+    BOOST_CHECK(not contains(applied.failures, "invalid CPU list"));
+}
+
+BOOST_AUTO_TEST_CASE(rejects_invalid_cpu_lists)
+{
+    const char *lists[] = { "3-1", "x", "-1", "0,", "1-x" };
+
+    for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); ++i)
+    {
+        BOOST_CHECK_EQUAL(applyOnNewThread(lists[i], "other", 0).failures, "invalid CPU list \"" + std::string(lists[i]) + "\"");
+    }
+
+    // An empty list leaves the affinity alone
+    BOOST_CHECK_EQUAL(applyOnNewThread("", "other", 0).failures, "");
+}
+
+BOOST_AUTO_TEST_CASE(clamps_priorities_outside_of_the_policys_range)
+{
+    int minimum = sched_get_priority_min(SCHED_FIFO);
+    int maximum = sched_get_priority_max(SCHED_FIFO);
+
+    Applied applied = applyOnNewThread("", "fifo", maximum + 10);
+
+    BOOST_CHECK(contains(applied.failures, "is outside of"));
+    BOOST_CHECK(contains(applied.failures, ", clamping"));
+
+    // Real-time scheduling may not be allowed here, but if it is, the
+    // priority was clamped rather than rejected
+    if (not contains(applied.failures, "pthread_setschedparam failed"))
+    {
+        BOOST_CHECK_EQUAL(applied.policy, SCHED_FIFO);
+        BOOST_CHECK_EQUAL(applied.priority, maximum);
+    }
+
+    applied = applyOnNewThread("", "rr", minimum - 1);
+
+    BOOST_CHECK(contains(applied.failures, ", clamping"));
+
+    if (not contains(applied.failures, "pthread_setschedparam failed"))
+    {
+        BOOST_CHECK_EQUAL(applied.policy, SCHED_RR);
+        BOOST_CHECK_EQUAL(applied.priority, minimum);
+    }
+
+    // The priority is ignored by the default policy
+    applied = applyOnNewThread("", "other", maximum + 10);
+
+    BOOST_CHECK_EQUAL(applied.failures, "");
+    BOOST_CHECK_EQUAL(applied.policy, SCHED_OTHER);
+}
+
+BOOST_AUTO_TEST_CASE(rejects_unknown_policies)
+{
+    Applied applied = applyOnNewThread("", "deadline", 10);
+
+    BOOST_CHECK_EQUAL(applied.failures, "unknown policy \"deadline\"");
+    BOOST_CHECK_EQUAL(applied.policy, SCHED_OTHER);
+
+    // Every failure is reported, separated
+    applied = applyOnNewThread("x", "FIFO", 10);
+
+    BOOST_CHECK_EQUAL(applied.failures, "invalid CPU list \"x\"; unknown policy \"FIFO\"");
+}
+
+BOOST_AUTO_TEST_CASE(applies_only_once_pending)
+{
+    ThreadPolicy policy;
+    bool applied = true;
+
+    BOOST_CHECK_EQUAL(policy.status(), "not applied");
+
+    boost::thread(boost::bind(&applyPending, &policy, &applied)).join();
+
+    BOOST_CHECK(not applied);
+
+    // A configured policy is applied once, whether or not it succeeds
+    policy.configure("x", "other", 0);
+
+    boost::thread(boost::bind(&applyPending, &policy, &applied)).join();
+
+    BOOST_CHECK(applied);
+    BOOST_CHECK_EQUAL(policy.status(), "invalid CPU list \"x\"");
+
+    boost::thread(boost::bind(&applyPending, &policy, &applied)).join();
+
+    BOOST_CHECK(not applied);
+
+    // Reapplying, such as for a recreated thread, applies it again
+    policy.reapply();
+
+    boost::thread(boost::bind(&applyPending, &policy, &applied)).join();
+
+    BOOST_CHECK(applied);
+
+    policy.configure("", "other", 0);
+
+    boost::thread(boost::bind(&applyPending, &policy, &applied)).join();
+
+    BOOST_CHECK(applied);
+    BOOST_CHECK_EQUAL(policy.status(), "applied");
+}
@@ -0,0 +1,201 @@
+/*
+ * Unit tests for TxBufferRing: the order buffers come back out in, wrapping
+ * around the ring, the overflow policies and keeping the buffer being sent
+ * from being refilled.
+ */
+
+#define BOOST_TEST_MODULE TxBufferRing
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+#include "SampleBufferPool.h"
+#include "TestHelpers.h"
+#include "TxBufferRing.h"
+
+// Boost Include(s)
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+// Take the next queued buffer, returning its number
+static short takeNumbered(TxBufferRing &ring)
+{
+    TxBuffer *buffer = ring.acquireFull();
+
+    BOOST_REQUIRE(buffer);
+
+    return buffer->data[0].real();
+}
+
+static void takeAfter(TxBufferRing *ring, unsigned int milliseconds)
+{
+    boost::this_thread::sleep(boost::posix_time::milliseconds(milliseconds));
+
+    ring->acquireFull();
+}
+
+BOOST_AUTO_TEST_CASE(holds_at_least_one_buffer)
+{
+    SampleBufferPool pool;
+    TxBufferRing ring(pool, 0, 64);
+
+    BOOST_CHECK_EQUAL(ring.capacity(), 1u);
+    BOOST_CHECK_EQUAL(ring.bufferSize(), 64u);
+    BOOST_CHECK(ring.acquireFull() == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(wraps_around_in_order)
+{
+    SampleBufferPool pool;
+    TxBufferRing ring(pool, 3, 16);
+
+    short next = 0;
+    short expected = 0;
+
+    // Only the commit to an empty ring asks for the sender to be woken
+    TxBuffer *buffer = ring.acquireFree();
+
+    buffer->data[0] = std::complex<short>(next++, 0);
+    BOOST_CHECK(ring.commit());
+
+    buffer = ring.acquireFree();
+    buffer->data[0] = std::complex<short>(next++, 0);
+    BOOST_CHECK(not ring.commit());
+
+    for (size_t i = 0; i < 20; ++i)
+    {
+        BOOST_CHECK_EQUAL(takeNumbered(ring), expected++);
+        BOOST_CHECK(commitNumbered(ring, next++));
+        BOOST_CHECK_EQUAL(ring.depth(), 2u);
+    }
+
+    BOOST_CHECK_EQUAL(takeNumbered(ring), expected++);
+    BOOST_CHECK_EQUAL(takeNumbered(ring), expected++);
+    BOOST_CHECK(ring.acquireFull() == NULL);
+    BOOST_CHECK_EQUAL(ring.droppedNewest(), 0u);
+    BOOST_CHECK_EQUAL(ring.droppedOldest(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(rejects_unknown_policies)
+{
+    SampleBufferPool pool;
+    TxBufferRing ring(pool, 2, 16);
+
+    BOOST_CHECK(ring.configure("dropNewest"));
+    BOOST_CHECK(ring.configure("dropOldest"));
+    BOOST_CHECK(ring.configure("block"));
+    BOOST_CHECK(not ring.configure("decimate"));
+}
+
+BOOST_AUTO_TEST_CASE(drop_newest_drops_the_new_buffer)
+{
+    SampleBufferPool pool;
+    TxBufferRing ring(pool, 2, 16);
+
+    ring.configure("dropNewest");
+
+    BOOST_CHECK(commitNumbered(ring, 0));
+    BOOST_CHECK(commitNumbered(ring, 1));
+    BOOST_CHECK(not commitNumbered(ring, 2));
+
+    BOOST_CHECK_EQUAL(ring.droppedNewest(), 1u);
+    BOOST_CHECK_EQUAL(takeNumbered(ring), 0);
+    BOOST_CHECK_EQUAL(takeNumbered(ring), 1);
+}
+
+BOOST_AUTO_TEST_CASE(drop_oldest_reclaims_the_oldest_queued_buffer)
+{
+    SampleBufferPool pool;
+    TxBufferRing ring(pool, 3, 16);
+
+    ring.configure("dropOldest");
+
+    for (short number = 0; number < 5; ++number)
+    {
+        BOOST_CHECK(commitNumbered(ring, number));
+    }
+
+    BOOST_CHECK_EQUAL(ring.droppedOldest(), 2u);
+    BOOST_CHECK_EQUAL(ring.depth(), 3u);
+    BOOST_CHECK_EQUAL(takeNumbered(ring), 2);
+    BOOST_CHECK_EQUAL(takeNumbered(ring), 3);
+    BOOST_CHECK_EQUAL(takeNumbered(ring), 4);
+}
+
+BOOST_AUTO_TEST_CASE(never_refills_the_buffer_being_sent)
+{
+    SampleBufferPool pool;
+    TxBufferRing ring(pool, 1, 16);
+
+    ring.configure("dropOldest");
+
+    BOOST_CHECK(commitNumbered(ring, 0));
+
+    TxBuffer *sending = ring.acquireFull();
+
+    // The queued buffer can be reclaimed, but the one being sent can't, so
+    // the new buffer is dropped instead
+    BOOST_CHECK(commitNumbered(ring, 1));
+    BOOST_CHECK(ring.acquireFree() == NULL);
+
+    BOOST_CHECK_EQUAL(ring.droppedOldest(), 1u);
+    BOOST_CHECK_EQUAL(ring.droppedNewest(), 1u);
+    BOOST_CHECK_EQUAL(sending->data[0].real(), 0);
+
+    // Asking for the next buffer hands the sent one back
+    BOOST_CHECK(ring.acquireFull() == NULL);
+
+    TxBuffer *buffer = ring.acquireFree();
+
+    BOOST_CHECK(buffer == sending);
+}
+
+BOOST_AUTO_TEST_CASE(block_waits_for_room)
+{
+    SampleBufferPool pool;
+    TxBufferRing ring(pool, 2, 16);
+
+    ring.configure("block");
+
+    commitNumbered(ring, 0);
+    commitNumbered(ring, 1);
+
+    boost::thread taker(boost::bind(&takeAfter, &ring, 50));
+
+    BOOST_CHECK(commitNumbered(ring, 2));
+
+    taker.join();
+
+    BOOST_CHECK_GT(ring.blockedTime(), 0.0);
+    BOOST_CHECK_EQUAL(ring.droppedNewest(), 0u);
+    BOOST_CHECK_EQUAL(takeNumbered(ring), 1);
+    BOOST_CHECK_EQUAL(takeNumbered(ring), 2);
+}
+
+BOOST_AUTO_TEST_CASE(cancel_ends_a_blocked_wait_until_cleared)
+{
+    SampleBufferPool pool;
+    TxBufferRing ring(pool, 1, 16);
+
+    ring.configure("block");
+
+    commitNumbered(ring, 0);
+
+    boost::thread canceller(boost::bind(&cancelAfter<TxBufferRing>, &ring, 50));
+
+    uint64_t start = monotonicNanoseconds();
+
+    BOOST_CHECK(ring.acquireFree() == NULL);
+    BOOST_CHECK_LT(monotonicNanoseconds() - start, 500000000u);
+
+    canceller.join();
+
+    BOOST_CHECK(ring.acquireFree() == NULL);
+
+    // Clearing discards the queue and lifts the cancel
+    ring.clear();
+
+    BOOST_CHECK_EQUAL(ring.depth(), 0u);
+    BOOST_CHECK(commitNumbered(ring, 1));
+    BOOST_CHECK_EQUAL(takeNumbered(ring), 1);
+}
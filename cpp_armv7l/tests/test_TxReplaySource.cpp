@@ -0,0 +1,213 @@
+/*
+ * Unit tests for TxReplaySource: splitting the file into runs, looping, the
+ * burst flags and time stamps of each mode, and the runs and sample rate
+ * taken from a sidecar.
+ */
+
+#define BOOST_TEST_MODULE TxReplaySource
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "TestHelpers.h"
+#include "TxReplaySource.h"
+
+// Standard Include(s)
+#include <fstream>
+#include <string>
+
+// Write a file of samples numbered from zero
+static std::string writeData(const ScratchDirectory &scratch, const std::string &name, size_t count)
+{
+    std::string dataPath = scratch.file(name);
+    std::ofstream file(dataPath.c_str(), std::ios::binary);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::complex<short> sample(i, -short(i));
+
+        file.write((const char *) &sample, sizeof(sample));
+    }
+
+    return dataPath;
+}
+
+static void writeMetadata(const ScratchDirectory &scratch, const std::string &json)
+{
+    std::ofstream file(scratch.file("replay.sigmf-meta").c_str());
+
+    file << json;
+}
+
+// A sidecar for a file captured in two runs, half a second apart
+static const char *TWO_RUNS =
+    "{\n"
+    "  \"global\": {\n"
+    "    \"core:datatype\": \"ci16_le\",\n"
+    "    \"core:sample_rate\": 1000\n"
+    "  },\n"
+    "  \"captures\": [\n"
+    "    {\"core:sample_start\": 0, \"rfnoc:full_secs\": 100, \"rfnoc:frac_secs\": 0},\n"
+    "    {\"core:sample_start\": 6, \"rfnoc:full_secs\": 100, \"rfnoc:frac_secs\": 0.5}\n"
+    "  ],\n"
+    "  \"annotations\": []\n"
+    "}\n";
+
+BOOST_AUTO_TEST_CASE(replays_the_file_once_in_runs)
+{
+    ScratchDirectory scratch;
+    TxReplaySource source;
+    TxReplayRun run;
+
+    BOOST_CHECK(source.finished());
+    BOOST_REQUIRE(source.open(writeData(scratch, "replay.dat", 10), 0, false, "none"));
+    BOOST_CHECK(not source.finished());
+
+    BOOST_REQUIRE(source.next(4, uhd::time_spec_t(0.0), run));
+    BOOST_CHECK_EQUAL(run.size, 4u);
+    BOOST_CHECK_EQUAL(run.data[0].real(), 0);
+    BOOST_CHECK(run.startOfBurst);
+    BOOST_CHECK(not run.hasTime);
+    BOOST_CHECK(not run.endOfBurst);
+
+    BOOST_REQUIRE(source.next(4, uhd::time_spec_t(0.0), run));
+    BOOST_CHECK_EQUAL(run.data[0].real(), 4);
+    BOOST_CHECK(not run.startOfBurst);
+    BOOST_CHECK(not run.endOfBurst);
+
+    // The last run is cut short at the end of the file, and ends the burst
+    BOOST_REQUIRE(source.next(4, uhd::time_spec_t(0.0), run));
+    BOOST_CHECK_EQUAL(run.size, 2u);
+    BOOST_CHECK_EQUAL(run.data[1].real(), 9);
+    BOOST_CHECK(run.endOfBurst);
+
+    BOOST_CHECK(not source.next(4, uhd::time_spec_t(0.0), run));
+    BOOST_CHECK(source.finished());
+    BOOST_CHECK_EQUAL(source.samplesSent(), 10u);
+    BOOST_CHECK_EQUAL(source.status(), "complete, 10 samples sent, 0 loop(s), 0 late run(s)");
+}
+
+BOOST_AUTO_TEST_CASE(loops_as_one_burst)
+{
+    ScratchDirectory scratch;
+    TxReplaySource source;
+    TxReplayRun run;
+
+    BOOST_REQUIRE(source.open(writeData(scratch, "replay.dat", 6), 0, true, "none"));
+
+    size_t sizes[] = {4, 2, 4, 2, 4};
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        BOOST_REQUIRE(source.next(4, uhd::time_spec_t(0.0), run));
+        BOOST_CHECK_EQUAL(run.size, sizes[i]);
+        BOOST_CHECK_EQUAL(run.data[0].real(), short((i % 2) * 4));
+        BOOST_CHECK_EQUAL(run.startOfBurst, (i == 0));
+        BOOST_CHECK(not run.endOfBurst);
+    }
+
+    BOOST_CHECK_EQUAL(source.loops(), 2u);
+    BOOST_CHECK_EQUAL(source.samplesSent(), 16u);
+    BOOST_CHECK(not source.finished());
+}
+
+BOOST_AUTO_TEST_CASE(regenerate_stamps_the_start_of_the_burst)
+{
+    ScratchDirectory scratch;
+    TxReplaySource source;
+    TxReplayRun run;
+
+    BOOST_REQUIRE(source.open(writeData(scratch, "replay.dat", 8), 0, false, "regenerate"));
+
+    BOOST_REQUIRE(source.next(4, uhd::time_spec_t(2.5), run));
+    BOOST_CHECK(run.hasTime);
+    BOOST_CHECK_CLOSE(run.time.get_real_secs(), 2.5, 1e-9);
+
+    BOOST_REQUIRE(source.next(4, uhd::time_spec_t(3.0), run));
+    BOOST_CHECK(not run.hasTime);
+    BOOST_CHECK(run.endOfBurst);
+}
+
+BOOST_AUTO_TEST_CASE(preserve_sends_each_captured_run_as_a_burst)
+{
+    ScratchDirectory scratch;
+    TxReplaySource source;
+    TxReplayRun run;
+
+    writeMetadata(scratch, TWO_RUNS);
+
+    BOOST_REQUIRE(source.open(writeData(scratch, "replay.sigmf-data", 10), 0, true, "preserve"));
+
+    // The first run is shifted on to the earliest time allowed, and never
+    // crosses into the second
+    BOOST_REQUIRE(source.next(100, uhd::time_spec_t(5.0), run));
+    BOOST_CHECK_EQUAL(run.size, 6u);
+    BOOST_CHECK(run.startOfBurst and run.hasTime and run.endOfBurst);
+    BOOST_CHECK_CLOSE(run.time.get_real_secs(), 5.0, 1e-9);
+
+    // The second keeps its spacing from the first
+    BOOST_REQUIRE(source.next(100, uhd::time_spec_t(5.01), run));
+    BOOST_CHECK_EQUAL(run.size, 4u);
+    BOOST_CHECK_EQUAL(run.data[0].real(), 6);
+    BOOST_CHECK(run.startOfBurst and run.hasTime and run.endOfBurst);
+    BOOST_CHECK_CLOSE(run.time.get_real_secs(), 5.5, 1e-9);
+
+    // The next pass follows on from the end of the last run
+    BOOST_REQUIRE(source.next(100, uhd::time_spec_t(5.01), run));
+    BOOST_CHECK_EQUAL(run.size, 6u);
+    BOOST_CHECK_CLOSE(run.time.get_real_secs(), 5.504, 1e-9);
+    BOOST_CHECK_EQUAL(source.loops(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(preserve_shifts_a_late_run_on)
+{
+    ScratchDirectory scratch;
+    TxReplaySource source;
+    TxReplayRun run;
+
+    writeMetadata(scratch, TWO_RUNS);
+
+    BOOST_REQUIRE(source.open(writeData(scratch, "replay.sigmf-data", 10), 0, false, "preserve"));
+
+    BOOST_REQUIRE(source.next(100, uhd::time_spec_t(5.0), run));
+    BOOST_REQUIRE(source.next(100, uhd::time_spec_t(7.0), run));
+    BOOST_CHECK_CLOSE(run.time.get_real_secs(), 7.0, 1e-9);
+    BOOST_CHECK(source.finished());
+}
+
+BOOST_AUTO_TEST_CASE(paces_to_the_replay_rate)
+{
+    ScratchDirectory scratch;
+    TxReplaySource source;
+    TxReplayRun run;
+
+    BOOST_REQUIRE(source.open(writeData(scratch, "replay.dat", 1000), 1000, false, "none"));
+
+    BOOST_CHECK_EQUAL(source.delay(), 0.0);
+    BOOST_REQUIRE(source.next(100, uhd::time_spec_t(0.0), run));
+
+    // A tenth of a second's worth of samples has been taken
+    BOOST_CHECK_GT(source.delay(), 0.05);
+    BOOST_CHECK_LE(source.delay(), 0.1);
+    BOOST_CHECK_EQUAL(source.lateRuns(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(rejects_what_it_cant_replay)
+{
+    ScratchDirectory scratch;
+    TxReplaySource source;
+
+    BOOST_CHECK(not source.open(writeData(scratch, "replay.dat", 4), 0, false, "sometimes"));
+    BOOST_CHECK_EQUAL(source.status(), "error: unknown time stamp mode sometimes");
+
+    BOOST_CHECK(not source.open(scratch.file("missing.dat"), 0, false, "none"));
+    BOOST_CHECK_EQUAL(source.status().compare(0, 23, "error: unable to open /"), 0);
+
+    BOOST_CHECK(not source.open(writeData(scratch, "replay.dat", 0), 0, false, "none"));
+    BOOST_CHECK_EQUAL(source.status(), "error: " + scratch.file("replay.dat") + " holds no samples");
+
+    writeMetadata(scratch, "{\"global\": {\"core:datatype\": \"cf32_le\"}}");
+
+    BOOST_CHECK(not source.open(writeData(scratch, "replay.sigmf-data", 4), 0, false, "none"));
+    BOOST_CHECK_EQUAL(source.status(), "error: " + scratch.file("replay.sigmf-meta") + " describes cf32_le samples, not ci16_le");
+    BOOST_CHECK(source.finished());
+}
@@ -0,0 +1,243 @@
+/*
+ * Unit tests for TxStreamScheduler: adopting streams, including those added
+ * from another thread, the round-robin order and where the turn goes once a
+ * stream is removed.
+ */
+
+#define BOOST_TEST_MODULE TxStreamScheduler
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "TxStreamScheduler.h"
+
+// Boost Include(s)
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+// BULKIO Include(s)
+#include <bulkio/bulkio.h>
+
+// Standard Include(s)
+#include <string>
+#include <vector>
+
+/*
+ * Input ports with a stream for each of the given IDs, created by pushing an
+ * SRI for each
+ */
+struct InputStreams
+{
+    InputStreams() :
+        floatPort("dataFloat_in"),
+        shortPort("dataShort_in")
+    {
+    }
+
+    bulkio::InFloatStream floatStream(const std::string &streamID)
+    {
+        this->floatPort.pushSRI(bulkio::sri::create(streamID, 1e6));
+
+        return this->floatPort.getStream(streamID);
+    }
+
+    bulkio::InShortStream shortStream(const std::string &streamID)
+    {
+        this->shortPort.pushSRI(bulkio::sri::create(streamID, 1e6));
+
+        return this->shortPort.getStream(streamID);
+    }
+
+    bulkio::InFloatPort floatPort;
+    bulkio::InShortPort shortPort;
+};
+
+// The IDs of the next count streams scheduled
+static std::vector<std::string> turns(TxStreamScheduler &scheduler, size_t count)
+{
+    std::vector<std::string> streamIDs;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        TxStreamState *state = scheduler.next();
+
+        streamIDs.push_back((state) ? state->streamID() : "");
+    }
+
+    return streamIDs;
+}
+
+static std::vector<std::string> expected(const char *first, const char *second, const char *third, const char *fourth)
+{
+    std::vector<std::string> streamIDs;
+
+    streamIDs.push_back(first);
+    streamIDs.push_back(second);
+    streamIDs.push_back(third);
+    streamIDs.push_back(fourth);
+
+    return streamIDs;
+}
+
+BOOST_AUTO_TEST_CASE(starts_empty)
+{
+    TxStreamScheduler scheduler;
+
+    BOOST_CHECK(scheduler.next() == NULL);
+    BOOST_CHECK_EQUAL(scheduler.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(takes_turns_in_the_order_added)
+{
+    InputStreams inputs;
+    TxStreamScheduler scheduler;
+
+    scheduler.add(inputs.shortStream("a"));
+    scheduler.add(inputs.shortStream("b"));
+    scheduler.add(inputs.shortStream("c"));
+
+    std::vector<std::string> order = turns(scheduler, 4);
+    std::vector<std::string> wanted = expected("a", "b", "c", "a");
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), wanted.begin(), wanted.end());
+    BOOST_CHECK_EQUAL(scheduler.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(adopts_a_stream_once)
+{
+    InputStreams inputs;
+    TxStreamScheduler scheduler;
+    bulkio::InShortStream stream = inputs.shortStream("a");
+
+    scheduler.add(stream);
+    scheduler.add(stream);
+    scheduler.next();
+    scheduler.add(stream);
+    scheduler.next();
+
+    BOOST_CHECK_EQUAL(scheduler.size(), 1u);
+}
+
+static void addAll(TxStreamScheduler *scheduler, const std::vector<bulkio::InShortStream> *streams)
+{
+    for (size_t i = 0; i < streams->size(); ++i)
+    {
+        scheduler->add((*streams)[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(adopts_streams_added_while_running)
+{
+    InputStreams inputs;
+    TxStreamScheduler scheduler;
+
+    scheduler.add(inputs.shortStream("a"));
+    scheduler.add(inputs.shortStream("b"));
+
+    BOOST_CHECK_EQUAL(scheduler.next()->streamID(), "a");
+
+    scheduler.add(inputs.shortStream("c"));
+
+    std::vector<std::string> order = turns(scheduler, 4);
+    std::vector<std::string> wanted = expected("b", "c", "a", "b");
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), wanted.begin(), wanted.end());
+}
+
+BOOST_AUTO_TEST_CASE(adopts_every_stream_added_from_another_thread)
+{
+    InputStreams inputs;
+    TxStreamScheduler scheduler;
+    std::vector<bulkio::InShortStream> streams;
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        streams.push_back(inputs.shortStream(boost::lexical_cast<std::string>(i)));
+    }
+
+    boost::thread adder(boost::bind(&addAll, &scheduler, &streams));
+
+    // A stream still being added when the TX thread looks is adopted on a
+    // later turn
+    for (size_t turn = 0; turn < 1000000 and scheduler.size() < streams.size(); ++turn)
+    {
+        scheduler.next();
+    }
+
+    adder.join();
+    scheduler.next();
+
+    BOOST_CHECK_EQUAL(scheduler.size(), streams.size());
+}
+
+BOOST_AUTO_TEST_CASE(removing_the_current_stream_passes_the_turn_on)
+{
+    InputStreams inputs;
+    TxStreamScheduler scheduler;
+
+    scheduler.add(inputs.shortStream("a"));
+    scheduler.add(inputs.shortStream("b"));
+    scheduler.add(inputs.shortStream("c"));
+
+    scheduler.next();
+    scheduler.remove(scheduler.next());
+
+    std::vector<std::string> order = turns(scheduler, 4);
+    std::vector<std::string> wanted = expected("c", "a", "c", "a");
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), wanted.begin(), wanted.end());
+    BOOST_CHECK_EQUAL(scheduler.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(removing_the_first_stream_passes_the_turn_on)
+{
+    InputStreams inputs;
+    TxStreamScheduler scheduler;
+
+    scheduler.add(inputs.shortStream("a"));
+    scheduler.add(inputs.shortStream("b"));
+    scheduler.add(inputs.shortStream("c"));
+
+    scheduler.remove(scheduler.next());
+
+    std::vector<std::string> order = turns(scheduler, 4);
+    std::vector<std::string> wanted = expected("b", "c", "b", "c");
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), wanted.begin(), wanted.end());
+}
+
+BOOST_AUTO_TEST_CASE(removing_the_last_stream_empties_the_schedule)
+{
+    InputStreams inputs;
+    TxStreamScheduler scheduler;
+
+    scheduler.add(inputs.shortStream("a"));
+    scheduler.remove(scheduler.next());
+
+    BOOST_CHECK(scheduler.next() == NULL);
+    BOOST_CHECK_EQUAL(scheduler.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(keeps_each_streams_own_state)
+{
+    InputStreams inputs;
+    TxStreamScheduler scheduler;
+
+    scheduler.add(inputs.shortStream("a"));
+    scheduler.add(inputs.floatStream("b"));
+
+    TxStreamState *first = scheduler.next();
+    TxStreamState *second = scheduler.next();
+
+    BOOST_CHECK(not first->floatInput);
+    BOOST_CHECK(second->floatInput);
+    BOOST_CHECK_EQUAL(std::string(second->sri.streamID.in()), "b");
+    BOOST_CHECK_EQUAL(scheduler.floatStreams(), 1u);
+
+    first->samplesSent = 100;
+    first->nextTimeValid = true;
+
+    BOOST_CHECK_EQUAL(second->samplesSent, 0u);
+    BOOST_CHECK(not second->nextTimeValid);
+    BOOST_CHECK(scheduler.next() == first);
+}
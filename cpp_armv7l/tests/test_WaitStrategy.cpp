@@ -0,0 +1,156 @@
+/*
+ * Unit tests for WaitStrategy: configuring it by name, the backoff doubling
+ * up to its cap and starting over on resume, and an event driven wait which
+ * doesn't block for a notification sent before it, timing how long the
+ * thread took to notice.
+ */
+
+#define BOOST_TEST_MODULE WaitStrategy
+#include <boost/test/included/unit_test.hpp>
+
+// Local Include(s)
+#include "PerformanceCounters.h"
+#include "WaitStrategy.h"
+
+// Boost Include(s)
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+// Standard Include(s)
+#include <numeric>
+#include <vector>
+
+// The milliseconds the given number of idle calls took
+static double idleMilliseconds(WaitStrategy &wait, size_t calls, double timeout)
+{
+    uint64_t start = monotonicNanoseconds();
+
+    for (size_t i = 0; i < calls; ++i)
+    {
+        wait.idle(timeout);
+    }
+
+    return (monotonicNanoseconds() - start) / 1e6;
+}
+
+// The number of latencies recorded
+static uint32_t recorded(const LatencyHistogram &histogram)
+{
+    std::vector<uint32_t> counts;
+
+    histogram.snapshot(counts);
+
+    return std::accumulate(counts.begin(), counts.end(), uint32_t(0));
+}
+
+static void notifyAfter(WaitStrategy *wait, unsigned int milliseconds)
+{
+    boost::this_thread::sleep(boost::posix_time::milliseconds(milliseconds));
+
+    wait->notify();
+}
+
+BOOST_AUTO_TEST_CASE(configures_the_mode_by_name)
+{
+    WaitStrategy wait;
+
+    BOOST_CHECK_EQUAL(wait.mode(), WaitStrategy::EVENT);
+
+    BOOST_CHECK(wait.configure("busy"));
+    BOOST_CHECK_EQUAL(wait.mode(), WaitStrategy::BUSY);
+
+    BOOST_CHECK(wait.configure("spin"));
+    BOOST_CHECK_EQUAL(wait.mode(), WaitStrategy::SPIN);
+
+    BOOST_CHECK(wait.configure("backoff"));
+    BOOST_CHECK_EQUAL(wait.mode(), WaitStrategy::BACKOFF);
+
+    BOOST_CHECK(wait.configure("event"));
+    BOOST_CHECK_EQUAL(wait.mode(), WaitStrategy::EVENT);
+
+    // An unknown name leaves the mode as it was
+    BOOST_CHECK(not wait.configure("Busy"));
+    BOOST_CHECK(not wait.configure(""));
+    BOOST_CHECK_EQUAL(wait.mode(), WaitStrategy::EVENT);
+}
+
+BOOST_AUTO_TEST_CASE(busy_and_spin_waits_dont_block)
+{
+    WaitStrategy wait;
+
+    wait.configure("busy");
+
+    BOOST_CHECK_LT(idleMilliseconds(wait, 1000, 1.0), 100.0);
+
+    // Spinning yields once past its limit
+    wait.configure("spin");
+
+    BOOST_CHECK_LT(idleMilliseconds(wait, 2000, 1.0), 100.0);
+}
+
+BOOST_AUTO_TEST_CASE(backoff_doubles_up_to_its_cap)
+{
+    WaitStrategy wait;
+    LatencyHistogram wakeLatency;
+
+    wait.configure("backoff");
+
+    // Doubling from 1 us, the first 14 waits take about 16 ms altogether
+    double doubling = idleMilliseconds(wait, 14, 1.0);
+
+    BOOST_CHECK_GE(doubling, 16.0);
+
+    // From then on each wait is capped at 10 ms, where carrying on doubling
+    // would take half a second for the next five
+    double capped = idleMilliseconds(wait, 5, 1.0);
+
+    BOOST_CHECK_GE(capped, 50.0);
+    BOOST_CHECK_LT(capped, 200.0);
+
+    // Resuming starts over from 1 us, and the timeout plays no part
+    wait.resume(wakeLatency);
+
+    BOOST_CHECK_LT(idleMilliseconds(wait, 5, 0.001), 5.0);
+}
+
+BOOST_AUTO_TEST_CASE(a_notification_before_an_event_wait_isnt_missed)
+{
+    WaitStrategy wait;
+    LatencyHistogram wakeLatency;
+
+    wait.notify();
+
+    BOOST_CHECK_LT(idleMilliseconds(wait, 1, 5.0), 1000.0);
+
+    wait.resume(wakeLatency);
+
+    BOOST_CHECK_EQUAL(recorded(wakeLatency), 1u);
+
+    // The notification was used up, so the next wait runs to its timeout
+    BOOST_CHECK_GE(idleMilliseconds(wait, 1, 0.05), 45.0);
+
+    // Resuming without a notification records nothing
+    wait.resume(wakeLatency);
+
+    BOOST_CHECK_EQUAL(recorded(wakeLatency), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(a_notification_during_an_event_wait_wakes_it)
+{
+    WaitStrategy wait;
+    LatencyHistogram wakeLatency;
+
+    boost::thread notifier(boost::bind(&notifyAfter, &wait, 20));
+
+    double waited = idleMilliseconds(wait, 1, 5.0);
+
+    notifier.join();
+
+    BOOST_CHECK_LT(waited, 1000.0);
+
+    // Only the first of several notifications is timed
+    wait.notify();
+    wait.resume(wakeLatency);
+
+    BOOST_CHECK_EQUAL(recorded(wakeLatency), 1u);
+}